@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 #include "collectionsizereport.h"
+#include "collectionstatistics.h"
 #include "../document.h"
 #include "../tellico_debug.h"
 
@@ -56,15 +57,11 @@ QWidget* CollectionSizeReport::createWidget() {
     return nullptr;
   }
 
-  int emptyCount = 0;
+  const FieldStatistics stats = CollectionStatistics::self()->statistics(coll, cdate);
+  const int emptyCount = stats.emptyCount;
   QMap<QString, int> entryDateCounts;
-  foreach(Data::EntryPtr entry, coll->entries()) {
-    auto date = entry->field(cdate);
-    if(date.isEmpty()) {
-      emptyCount++;
-    } else {
-      entryDateCounts[date]++;
-    }
+  for(auto it = stats.valueCounts.constBegin(); it != stats.valueCounts.constEnd(); ++it) {
+    entryDateCounts.insert(it.key(), it.value());
   }
 
   auto series = new QLineSeries;
@@ -0,0 +1,273 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "collectionstatistics.h"
+#include "../collection.h"
+#include "../entry.h"
+#include "../field.h"
+#include "../fieldformat.h"
+#include "../tellico_debug.h"
+
+#include <QVector>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+  // the fewest entries worth handing to a separate thread
+  static const int STATISTICS_MIN_CHUNK_SIZE = 1000;
+
+  // count the values for a range of entries, the stats has one element for each field
+  void countValues(const Tellico::Data::EntryList& entries_, int begin_, int end_,
+                   const Tellico::Data::FieldList& fields_, Tellico::FieldStatistics* stats_) {
+    using Tellico::FieldFormat;
+    using Tellico::Data::Field;
+    for(int i = begin_; i < end_; ++i) {
+      const Tellico::Data::EntryPtr& entry = entries_.at(i);
+      for(int f = 0; f < fields_.count(); ++f) {
+        const Tellico::Data::FieldPtr& field = fields_.at(f);
+        Tellico::FieldStatistics& stats = stats_[f];
+        const QString value = entry->field(field);
+        if(value.isEmpty()) {
+          ++stats.emptyCount;
+          continue;
+        }
+        QStringList values;
+        // check table before multiple since tables are always multiple
+        if(field->type() == Field::Table) {
+          // only the first column is used for grouping
+          foreach(const QString& row, FieldFormat::splitTable(value)) {
+            const QStringList columns = FieldFormat::splitRow(row);
+            if(!columns.isEmpty()) {
+              values += FieldFormat::splitValue(columns.at(0));
+            }
+          }
+          values.removeDuplicates();
+        } else if(field->hasFlag(Field::AllowMultiple)) {
+          values = FieldFormat::splitValue(value);
+          values.removeDuplicates();
+        } else {
+          values += value;
+        }
+        const bool isNumeric = field->type() == Field::Number || field->type() == Field::Rating;
+        for(const auto& v : std::as_const(values)) {
+          ++stats.valueCounts[v];
+          if(isNumeric) {
+            bool ok;
+            const double number = v.toDouble(&ok);
+            if(ok) {
+              stats.addNumber(number);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+using Tellico::FieldStatistics;
+using Tellico::CollectionStatistics;
+
+FieldStatistics::FieldStatistics() : emptyCount(0), numericCount(0)
+    , minimum(std::numeric_limits<double>::max())
+    , maximum(std::numeric_limits<double>::lowest())
+    , sum(0.0) {
+}
+
+QList<QPair<QString, int> > FieldStatistics::topGroups(int count_) const {
+  QList<QPair<QString, int> > groups;
+  groups.reserve(groupCounts.size());
+  for(auto it = groupCounts.constBegin(); it != groupCounts.constEnd(); ++it) {
+    if(!it.key().isEmpty()) {
+      groups += qMakePair(it.key(), it.value());
+    }
+  }
+  // only the first few need to be in order
+  const int n = qMin(count_, groups.count());
+  std::partial_sort(groups.begin(), groups.begin() + n, groups.end(),
+                    [](const QPair<QString, int>& a, const QPair<QString, int>& b) {
+                      return a.second > b.second || (a.second == b.second && a.first < b.first);
+                    });
+  return groups.mid(0, n);
+}
+
+void FieldStatistics::addNumber(double number_) {
+  ++numericCount;
+  sum += number_;
+  minimum = qMin(minimum, number_);
+  maximum = qMax(maximum, number_);
+}
+
+void FieldStatistics::merge(const FieldStatistics& other_) {
+  emptyCount += other_.emptyCount;
+  if(valueCounts.isEmpty()) {
+    valueCounts = other_.valueCounts;
+  } else {
+    for(auto it = other_.valueCounts.constBegin(); it != other_.valueCounts.constEnd(); ++it) {
+      valueCounts[it.key()] += it.value();
+    }
+  }
+  if(other_.numericCount > 0) {
+    numericCount += other_.numericCount;
+    sum += other_.sum;
+    minimum = qMin(minimum, other_.minimum);
+    maximum = qMax(maximum, other_.maximum);
+  }
+}
+
+CollectionStatistics* CollectionStatistics::self() {
+  static CollectionStatistics statistics;
+  return &statistics;
+}
+
+CollectionStatistics::CollectionStatistics() : m_collId(-1), m_entriesRevision(0), m_fieldsRevision(0) {
+}
+
+CollectionStatistics::~CollectionStatistics() {
+  m_pool.clear();
+  m_pool.waitForDone();
+}
+
+void CollectionStatistics::clear() {
+  m_cache.clear();
+  m_collId = -1;
+}
+
+QHash<QString, FieldStatistics> CollectionStatistics::statistics(Tellico::Data::CollPtr coll_, const QStringList& fieldNames_) {
+  QHash<QString, FieldStatistics> stats;
+  if(!coll_) {
+    return stats;
+  }
+  if(coll_->id() != m_collId ||
+     coll_->entriesRevision() != m_entriesRevision ||
+     coll_->fieldsRevision() != m_fieldsRevision) {
+    m_cache.clear();
+    m_collId = coll_->id();
+    m_entriesRevision = coll_->entriesRevision();
+    m_fieldsRevision = coll_->fieldsRevision();
+  }
+
+  Data::FieldList missingFields;
+  for(const auto& fieldName : fieldNames_) {
+    if(!m_cache.contains(fieldName)) {
+      Data::FieldPtr field = coll_->fieldByName(fieldName);
+      if(field) {
+        missingFields += field;
+      }
+    }
+  }
+  if(!missingFields.isEmpty()) {
+    compute(coll_, missingFields);
+  }
+
+  for(const auto& fieldName : fieldNames_) {
+    auto it = m_cache.constFind(fieldName);
+    if(it != m_cache.constEnd()) {
+      stats.insert(fieldName, it.value());
+    }
+  }
+  return stats;
+}
+
+FieldStatistics CollectionStatistics::statistics(Tellico::Data::CollPtr coll_, const QString& fieldName_) {
+  return statistics(coll_, QStringList(fieldName_)).value(fieldName_);
+}
+
+void CollectionStatistics::compute(Tellico::Data::CollPtr coll_, const Tellico::Data::FieldList& fields_) {
+  const Data::EntryList entries = coll_->entries();
+
+  // derived values and formatting are not safe to use from several threads, so the values
+  // are counted in parallel and only the distinct values get formatted afterwards
+  Data::FieldList fields, derivedFields;
+  for(const auto& field : fields_) {
+    if(field->hasFlag(Data::Field::Derived)) {
+      derivedFields += field;
+    } else {
+      fields += field;
+    }
+  }
+
+  const int entryCount = entries.count();
+  const int fieldCount = fields.count();
+  if(fieldCount > 0) {
+    const int threadCount = qMax(1, m_pool.maxThreadCount());
+    const int chunkSize = qMax(STATISTICS_MIN_CHUNK_SIZE, (entryCount + threadCount - 1) / threadCount);
+    const int chunkCount = qMax(1, (entryCount + chunkSize - 1) / chunkSize);
+    // each chunk has its own statistics for every field, merged when all the chunks are done
+    QVector<FieldStatistics> partial(chunkCount * fieldCount);
+    FieldStatistics* partialData = partial.data();
+    if(chunkCount == 1) {
+      countValues(entries, 0, entryCount, fields, partialData);
+    } else {
+      for(int c = 0; c < chunkCount; ++c) {
+        const int begin = c * chunkSize;
+        const int end = qMin(begin + chunkSize, entryCount);
+        FieldStatistics* stats = partialData + c * fieldCount;
+        m_pool.start([&entries, &fields, begin, end, stats]() {
+          countValues(entries, begin, end, fields, stats);
+        });
+      }
+      m_pool.waitForDone();
+    }
+
+    for(int f = 0; f < fieldCount; ++f) {
+      const Data::FieldPtr field = fields.at(f);
+      FieldStatistics stats = partial.at(f);
+      for(int c = 1; c < chunkCount; ++c) {
+        stats.merge(partial.at(c * fieldCount + f));
+      }
+      const FieldFormat::Type formatType = field->formatType();
+      for(auto it = stats.valueCounts.constBegin(); it != stats.valueCounts.constEnd(); ++it) {
+        const QString group = formatType == FieldFormat::FormatNone && field->type() != Data::Field::Table
+                            ? coll_->prepareText(it.key())
+                            : FieldFormat::format(it.key(), formatType, FieldFormat::DefaultFormat);
+        stats.groupCounts[group] += it.value();
+      }
+      if(stats.emptyCount > 0) {
+        stats.groupCounts.insert(QString(), stats.emptyCount);
+      }
+      m_cache.insert(field->name(), stats);
+    }
+  }
+
+  for(const auto& field : std::as_const(derivedFields)) {
+    FieldStatistics stats;
+    for(const auto& entry : entries) {
+      const QStringList groups = entry->groupNamesByFieldName(field->name());
+      if(groups.count() == 1 && groups.at(0).isEmpty()) {
+        ++stats.emptyCount;
+        continue;
+      }
+      for(const auto& group : groups) {
+        ++stats.valueCounts[group];
+        ++stats.groupCounts[group];
+      }
+    }
+    if(stats.emptyCount > 0) {
+      stats.groupCounts.insert(QString(), stats.emptyCount);
+    }
+    m_cache.insert(field->name(), stats);
+  }
+  myLog() << "Computed statistics for" << fields_.count() << "fields over" << entryCount << "entries";
+}
@@ -0,0 +1,103 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TELLICO_COLLECTIONSTATISTICS_H
+#define TELLICO_COLLECTIONSTATISTICS_H
+
+#include "../datavectors.h"
+
+#include <QHash>
+#include <QPair>
+#include <QThreadPool>
+
+namespace Tellico {
+
+/**
+ * The value counts and the numeric statistics for a single field.
+ */
+class FieldStatistics {
+public:
+  FieldStatistics();
+
+  /**
+   * The number of times each value occurs, counting each entry once. Multiple values
+   * are split and only the first column of a table is used.
+   */
+  QHash<QString, int> valueCounts;
+  /**
+   * The number of entries in each group, using the same formatted group names as the group view
+   */
+  QHash<QString, int> groupCounts;
+  int emptyCount;
+  // only numbers and ratings have numeric statistics
+  int numericCount;
+  double minimum;
+  double maximum;
+  double sum;
+
+  double mean() const { return numericCount > 0 ? sum / numericCount : 0.0; }
+  /**
+   * Returns the groups with the most entries, the most common first. The empty group is never included.
+   */
+  QList<QPair<QString, int> > topGroups(int count) const;
+
+  void addNumber(double number);
+  void merge(const FieldStatistics& other);
+};
+
+/**
+ * Computes the statistics for the reports with a single pass over the entries, split between
+ * several threads. The statistics are kept until the entries or the fields in the
+ * collection change.
+ *
+ * @author Robby Stephenson
+ */
+class CollectionStatistics {
+public:
+  static CollectionStatistics* self();
+
+  /**
+   * Returns the statistics for several fields, computing all the ones which are not cached
+   * together.
+   */
+  QHash<QString, FieldStatistics> statistics(Data::CollPtr coll, const QStringList& fieldNames);
+  FieldStatistics statistics(Data::CollPtr coll, const QString& fieldName);
+  void clear();
+
+private:
+  CollectionStatistics();
+  ~CollectionStatistics();
+  Q_DISABLE_COPY(CollectionStatistics)
+
+  void compute(Data::CollPtr coll, const Data::FieldList& fields);
+
+  QThreadPool m_pool;
+  Data::ID m_collId;
+  int m_entriesRevision;
+  int m_fieldsRevision;
+  QHash<QString, FieldStatistics> m_cache;
+};
+
+} // end namespace
+#endif
@@ -24,11 +24,10 @@
 
 #include "groupsummaryreport.h"
 #include "barchart.h"
+#include "collectionstatistics.h"
 #include "../document.h"
-#include "../entrygroup.h"
-#include "../models/models.h"
-#include "../models/entrygroupmodel.h"
-#include "../models/groupsortmodel.h"
+#include "../collection.h"
+#include "../field.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -71,43 +70,19 @@ GroupSummaryWidget::GroupSummaryWidget(const QString& title_, int count_, QWidge
   m_layout->addItem(new QSpacerItem(1, 10), 2, 0, 1, -1);
 }
 
-void GroupSummaryWidget::addChart(Tellico::Data::FieldPtr field_) {
-  // first populate a model with the entry groups for this field
-  Data::CollPtr coll = Data::Document::self()->collection();
-  Data::EntryGroupDict* dict = coll->entryGroupDictByName(field_->name());
-  // dict will be null for a field with no values
-  if(!dict) {
-    return;
-  }
-
-  EntryGroupModel* groupModel = new EntryGroupModel(this);
-  groupModel->addGroups(dict->values(), QString()); // TODO: make second value optional
-
-  GroupSortModel* model = new GroupSortModel(this);
-  model->setSourceModel(groupModel);
-  model->setSortRole(RowCountRole);
-  model->sort(0, Qt::DescendingOrder);
-
-  // grab the top few values in the group
+void GroupSummaryWidget::addChart(Tellico::Data::FieldPtr field_, const Tellico::FieldStatistics& stats_) {
+  // grab the top few values in the group, the empty group is already left out
   QStringList groupNames;
   QList<qreal> groupCounts;
-  int numGroups = qMin(MAX_GROUP_VALUES, model->rowCount());
-  for(int i = 0; i < numGroups; ++i) {
-    Data::EntryGroup* group = model->data(model->index(i, 0), GroupPtrRole).value<Data::EntryGroup*>();
-    if(!group || group->isEmpty()) {
-      continue;
-    }
-    if(group->hasEmptyGroupName()) {
-      ++numGroups; // bump the limit to account for the "Empty" group showing up
-      continue;
-    }
-    if(group->fieldName() == QStringLiteral("rating")) {
-      const int rating = qBound(0, group->groupName().toInt(), 10);
+  const auto topGroups = stats_.topGroups(MAX_GROUP_VALUES);
+  for(const auto& group : topGroups) {
+    if(field_->name() == QStringLiteral("rating")) {
+      const int rating = qBound(0, group.first.toInt(), 10);
       groupNames << QString::fromUtf8("⭐").repeated(rating);
     } else {
-      groupNames << group->groupName();
+      groupNames << group.first;
     }
-    groupCounts << group->count();
+    groupCounts << group.second;
   }
  // if less than minimum, we don't care, skip this field
  if(groupCounts.count() < MIN_GROUP_VALUES) {
@@ -197,9 +172,20 @@ QWidget* GroupSummaryReport::createWidget() {
   Q_ASSERT(coll);
   auto widget = new GroupSummaryWidget(coll->title(), coll->entryCount());
 
+  Data::FieldList fields;
+  QStringList fieldNames;
   foreach(Data::FieldPtr field, coll->fields()) {
     if(field && field->hasFlag(Data::Field::AllowGrouped)) {
-      widget->addChart(field);
+      fields += field;
+      fieldNames += field->name();
+    }
+  }
+  // the groups for every field are counted together
+  const auto stats = CollectionStatistics::self()->statistics(coll, fieldNames);
+  for(const auto& field : std::as_const(fields)) {
+    auto it = stats.constFind(field->name());
+    if(it != stats.constEnd()) {
+      widget->addChart(field, it.value());
     }
   }
   widget->setVisible(true);
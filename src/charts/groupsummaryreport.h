@@ -35,6 +35,7 @@ class QGridLayout;
 namespace Tellico {
 
 class BarChart;
+class FieldStatistics;
 
 class GroupSummaryWidget : public QScrollArea {
 Q_OBJECT
@@ -42,7 +43,7 @@ Q_OBJECT
 public:
   GroupSummaryWidget(const QString& title, int count, QWidget* parent = nullptr);
 
-  void addChart(Data::FieldPtr field);
+  void addChart(Data::FieldPtr field, const FieldStatistics& stats);
 
 public Q_SLOTS:
   void updateGeometry();
@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 #include "yeardistributionreport.h"
+#include "collectionstatistics.h"
 #include "../document.h"
 #include "../tellico_debug.h"
 
@@ -81,34 +82,31 @@ QWidget* YearDistributionReport::createWidget() {
     myDebug() << "No year field in collection";
     return nullptr;
   }
-  const bool multiple = coll->fieldByName(yearField)->hasFlag(Data::Field::AllowMultiple);
-
-  QMap<QString, int> entryYearCount;
-  foreach(Data::EntryPtr entry, coll->entries()) {
-    const QString year = entry->field(yearField);
-    if(year.isEmpty()) {
-      continue;
-    }
-    QStringList years;
-    if(multiple) {
-      years = FieldFormat::splitValue(year);
-    } else {
-      years << year;
-    }
-    foreach(const QString& y, years) {
-      entryYearCount[y]++;
-    }
-  }
 
+  // the year values are counted along with the numeric range
+  const FieldStatistics stats = CollectionStatistics::self()->statistics(coll, yearField);
+  const QHash<QString, int>& entryYearCount = stats.valueCounts;
   if(entryYearCount.isEmpty()) {
     return nullptr;
   }
 
-  bool ok;
-  const uint minYear = entryYearCount.firstKey().toUInt(&ok);
-  if(!ok) return nullptr;
-  const uint maxYear = entryYearCount.lastKey().toUInt(&ok);
-  if(!ok) return nullptr;
+  uint minYear, maxYear;
+  if(stats.numericCount > 0) {
+    if(stats.minimum < 0) {
+      return nullptr;
+    }
+    minYear = static_cast<uint>(stats.minimum);
+    maxYear = static_cast<uint>(stats.maximum);
+  } else {
+    // only number fields have the numeric range, so use the sorted values for any other year field
+    QStringList years = entryYearCount.keys();
+    years.sort();
+    bool ok;
+    minYear = years.first().toUInt(&ok);
+    if(!ok) return nullptr;
+    maxYear = years.last().toUInt(&ok);
+    if(!ok) return nullptr;
+  }
 
   // pad beginning of bar set with zeros in order to use the year as an index number
   QList<qreal> zeroes;
@@ -36,6 +36,7 @@
 #include <KLocalizedString>
 
 #include <QDate>
+#include <QSet>
 
 using namespace Tellico;
 using Tellico::Data::Collection;
@@ -43,12 +44,12 @@ using Tellico::Data::Collection;
 const QString Collection::s_peopleGroupName = QStringLiteral("_people");
 
 Collection::Collection(const QString& title_)
-    : QObject(), QSharedData(), m_nextEntryId(1), m_title(title_), m_trackGroups(false) {
+    : QObject(), QSharedData(), m_nextEntryId(1), m_fieldsRevision(0), m_entriesRevision(0), m_title(title_), m_trackGroups(false) {
   m_id = getID();
 }
 
 Collection::Collection(bool addDefaultFields_, const QString& title_)
-    : QObject(), QSharedData(), m_nextEntryId(1), m_title(title_), m_trackGroups(false) {
+    : QObject(), QSharedData(), m_nextEntryId(1), m_fieldsRevision(0), m_entriesRevision(0), m_title(title_), m_trackGroups(false) {
   if(m_title.isEmpty()) {
     m_title = i18n("My Collection");
   }
@@ -92,6 +93,7 @@ bool Collection::addField(Tellico::Data::FieldPtr field_) {
 
   m_fields.append(field_);
   m_fieldByName.insert(field_->name(), field_.data());
+  ++m_fieldsRevision;
   m_fieldByTitle.insert(field_->title(), field_.data());
 
   // always default to using field with title name as title
@@ -259,6 +261,7 @@ bool Collection::modifyField(Tellico::Data::FieldPtr newField_) {
 
   // update name dict
   m_fieldByName.insert(fieldName, newField_.data());
+  ++m_fieldsRevision;
 
   // update titles
   const QString oldTitle = oldField->title();
@@ -409,6 +412,7 @@ bool Collection::removeField(Tellico::Data::FieldPtr field_, bool force_/*=false
   }
   m_fieldByName.remove(field_->name());
   m_fieldByTitle.remove(field_->title());
+  ++m_fieldsRevision;
 
   if(fieldsByCategory(field_->category()).count() == 1) {
     m_fieldCategories.removeAll(field_->category());
@@ -455,6 +459,13 @@ void Collection::addEntries(const Tellico::Data::EntryList& entries_) {
     return;
   }
 
+  ++m_entriesRevision;
+  // the whole list is known up front, so grow the storage once
+  m_entries.reserve(m_entries.count() + entries_.count());
+  m_entryById.reserve(m_entryById.count() + entries_.count());
+  const bool hasCDate = hasField(QStringLiteral("cdate"));
+  const bool hasMDate = hasField(QStringLiteral("mdate"));
+
   foreach(EntryPtr entry, entries_) {
     if(!entry) {
       Q_ASSERT(entry);
@@ -483,7 +494,7 @@ void Collection::addEntries(const Tellico::Data::EntryList& entries_) {
     }
     m_entryById.insert(entry->id(), entry.data());
 
-    if(hasField(QStringLiteral("cdate")) && entry->field(QStringLiteral("cdate")).isEmpty()) {
+    if(hasCDate && entry->field(QStringLiteral("cdate")).isEmpty()) {
       // use mdate if it exists
       QString cdate = entry->field(QStringLiteral("mdate"));
       if(cdate.isEmpty()) {
@@ -491,7 +502,7 @@ void Collection::addEntries(const Tellico::Data::EntryList& entries_) {
       }
       entry->setField(QStringLiteral("cdate"), cdate, false);
     }
-    if(hasField(QStringLiteral("mdate")) && entry->field(QStringLiteral("mdate")).isEmpty()) {
+    if(hasMDate && entry->field(QStringLiteral("mdate")).isEmpty()) {
       entry->setField(QStringLiteral("mdate"), QDate::currentDate().toString(Qt::ISODate), false);
     }
   }
@@ -501,24 +512,37 @@ void Collection::addEntries(const Tellico::Data::EntryList& entries_) {
 }
 
 void Collection::removeEntriesFromDicts(const Tellico::Data::EntryList& entries_, const QStringList& fields_) {
-  QSet<EntryGroup*> modifiedGroups;
+  const QSet<QString> fieldSet(fields_.begin(), fields_.end());
+  // collect the entries to remove from each group and then remove them all at once
+  // since removing them one at a time from a large group is quadratic
+  QHash<EntryGroup*, QSet<const Entry*> > removals;
   foreach(EntryPtr entry, entries_) {
     // need a copy of the vector since it gets changed
     QList<EntryGroup*> groups = entry->groups();
     foreach(EntryGroup* group, groups) {
       // only clear groups for the modified fields, skip the others
       // also clear for all derived values, just in case
-      if(!fields_.contains(group->fieldName()) && hasField(group->fieldName()) && !fieldByName(group->fieldName())->hasFlag(Field::Derived))  {
+      if(!fieldSet.contains(group->fieldName()) && hasField(group->fieldName()) && !fieldByName(group->fieldName())->hasFlag(Field::Derived))  {
         continue;
       }
-      if(entry->removeFromGroup(group)) {
-        modifiedGroups.insert(group);
-      }
-      if(group->isEmpty() && !m_groupsToDelete.contains(group)) {
-        m_groupsToDelete.push_back(group);
+      if(entry->leaveGroup(group)) {
+        removals[group].insert(entry.data());
       }
     }
   }
+  QSet<EntryGroup*> modifiedGroups;
+  for(auto it = removals.constBegin(); it != removals.constEnd(); ++it) {
+    EntryGroup* group = it.key();
+    const QSet<const Entry*>& removed = it.value();
+    if(group->removeIf([&removed](const EntryPtr& e) { return removed.contains(e.data()); }) > 0) {
+      modifiedGroups.insert(group);
+    } else {
+      myDebug() << "failed!";
+    }
+    if(group->isEmpty() && !m_groupsToDelete.contains(group)) {
+      m_groupsToDelete.push_back(group);
+    }
+  }
   if(!modifiedGroups.isEmpty()) {
     Q_EMIT signalGroupsModified(CollPtr(this), modifiedGroups.values());
   }
@@ -528,7 +552,12 @@ void Collection::removeEntriesFromDicts(const Tellico::Data::EntryList& entries_
 // groupDicts current. It first removes the entry from every group to which it belongs,
 // then it repopulates the dicts with the entry's fields
 void Collection::updateDicts(const Tellico::Data::EntryList& entries_, const QStringList& fields_) {
-  if(entries_.isEmpty() || !m_trackGroups) {
+  if(entries_.isEmpty()) {
+    return;
+  }
+  // the dicts are updated whenever entries are modified
+  ++m_entriesRevision;
+  if(!m_trackGroups) {
     return;
   }
   QStringList modifiedFields = fields_;
@@ -546,12 +575,17 @@ bool Collection::removeEntries(const Tellico::Data::EntryList& vec_) {
     return false;
   }
 
+  ++m_entriesRevision;
   removeEntriesFromDicts(vec_, fieldNames());
   bool success = true;
+  // remove all the entries in a single pass through the list
+  QSet<const Entry*> removed;
+  removed.reserve(vec_.count());
   foreach(EntryPtr entry, vec_) {
     m_entryById.remove(entry->id());
-    m_entries.removeAll(entry);
+    removed.insert(entry.data());
   }
+  m_entries.removeIf([&removed](const EntryPtr& e) { return removed.contains(e.data()); });
   cleanGroups();
   return success;
 }
@@ -635,16 +669,25 @@ bool Collection::isAllowed(const QString& field_, const QString& value_) const {
 
   FieldPtr field = fieldByName(field_);
   if(!field) return false;
+  return isAllowed(field, value_);
+}
+
+bool Collection::isAllowed(Tellico::Data::FieldPtr field_, const QString& value_) const {
+  // empty string is always allowed
+  if(value_.isEmpty()) {
+    return true;
+  }
+
   // non-choice or single-value choice fields with allowed values
-  if(field->type() != Field::Choice ||
-     (!field->hasFlag(Field::AllowMultiple) && field->allowed().contains(value_))) {
+  if(field_->type() != Field::Choice ||
+     (!field_->hasFlag(Field::AllowMultiple) && field_->allowed().contains(value_))) {
     return true;
   }
 
   // now have to split the text into separate values and check each one
   const auto values = FieldFormat::splitValue(value_, FieldFormat::StringSplit);
   for(const auto& value : values) {
-    if(!field->allowed().contains(value)) return false;
+    if(!field_->allowed().contains(value)) return false;
   }
 
   return true;
@@ -839,9 +882,11 @@ void Collection::clear() {
   m_fieldByName.clear();
   m_fieldByTitle.clear();
   m_defaultGroupField.clear();
+  ++m_fieldsRevision;
 
   m_entries.clear();
   m_entryById.clear();
+  ++m_entriesRevision;
   foreach(EntryGroupDict* dict, m_entryGroupDicts) {
     qDeleteAll(*dict);
   }
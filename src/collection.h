@@ -231,6 +231,7 @@ public:
    * @return A boolean indicating if the value is an allowed value for that field
    */
   bool isAllowed(const QString& field, const QString& value) const;
+  bool isAllowed(FieldPtr field, const QString& value) const;
   /**
    * Returns a list of all the field names.
    *
@@ -294,6 +295,20 @@ public:
    * Returns @p true if the collection contains a field named @ref name;
    */
   bool hasField(const QString& name) const;
+  /**
+   * Returns a counter which is incremented whenever a field is added, modified, or removed.
+   * Used to check whether anything cached from the field list is stale.
+   *
+   * @return The revision number
+   */
+  int fieldsRevision() const { return m_fieldsRevision; }
+  /**
+   * Returns a counter which is incremented whenever entries are added, modified, or removed.
+   * Used to check whether anything computed from the entry values is stale.
+   *
+   * @return The revision number
+   */
+  int entriesRevision() const { return m_entriesRevision; }
   /**
    * Returns a list of all the possible entry groups. This value is cached rather
    * than generated with each call, so the method should be fairly fast.
@@ -370,6 +385,8 @@ private:
 
   ID m_id;
   ID m_nextEntryId;
+  int m_fieldsRevision;
+  int m_entriesRevision;
   QString m_title;
   QString m_defaultGroupField;
   QString m_lastGroupField;
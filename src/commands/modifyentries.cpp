@@ -113,13 +113,10 @@ void ModifyEntries::undo() {
 void ModifyEntries::swapValues() {
   // since things like the detailedlistview and the entryiconview hold pointers to the entries
   // can't just call Controller::modifiedEntry() on the old pointers
-  for(int i = 0; i < m_entries.count(); ++i) {
+  // the values are implicitly shared, so swapping them avoids copying every entry twice
+  const int count = qMin(m_entries.count(), m_oldEntries.count());
+  for(int i = 0; i < count; ++i) {
     // need to swap entry values, not just pointers
-    // the id gets reset when copying, so need to keep it
-    const Data::ID id = m_entries[i]->id();
-    Data::Entry tmp(*m_entries[i]); // tmp id becomes -1
-    *m_entries[i] = *m_oldEntries[i]; // id becomes -1
-    m_entries[i]->setId(id); // id becomes what was originally
-    *m_oldEntries[i] = tmp; // id becomes -1
+    m_entries[i]->swapValues(*m_oldEntries[i]);
   }
 }
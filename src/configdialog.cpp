@@ -821,6 +821,7 @@ void ConfigDialog::saveGeneralConfig() {
   Config::setArticlesString(m_leArticles->text().replace(semicolon, comma));
   Config::setNameSuffixesString(m_leSuffixes->text().replace(semicolon, comma));
   Config::setSurnamePrefixesString(m_lePrefixes->text().replace(semicolon, comma));
+  FieldFormat::resetCache();
 }
 
 void ConfigDialog::savePrintingConfig() {
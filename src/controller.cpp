@@ -44,6 +44,7 @@
 #include "utils/cursorsaver.h"
 #include "gui/lineedit.h"
 #include "gui/tabwidget.h"
+#include "core/tracer.h"
 #include "tellico_debug.h"
 
 #include <KLocalizedString>
@@ -51,6 +52,7 @@
 #include <KActionMenu>
 
 #include <QMenu>
+#include <QSet>
 
 using Tellico::Controller;
 
@@ -253,8 +255,13 @@ void Controller::removedEntries(Tellico::Data::EntryList entries_) {
   foreach(Observer* obs, m_observers) {
     obs->removeEntries(entries_);
   }
-  foreach(Data::EntryPtr entry, entries_) {
-    m_selectedEntries.removeAll(entry);
+  if(!m_selectedEntries.isEmpty()) {
+    QSet<const Data::Entry*> removed;
+    removed.reserve(entries_.count());
+    foreach(Data::EntryPtr entry, entries_) {
+      removed.insert(entry.data());
+    }
+    m_selectedEntries.removeIf([&removed](const Data::EntryPtr& e) { return removed.contains(e.data()); });
   }
   m_mainWindow->slotEntryCount();
   m_mainWindow->slotQueueFilter();
@@ -454,6 +461,7 @@ void Controller::blockAllSignals(bool block_) const {
 }
 
 void Controller::slotUpdateFilter(Tellico::FilterPtr filter_) {
+  TRACE_ZONE("view", "Controller::slotUpdateFilter");
   blockAllSignals(true);
 
   // the view takes over ownership of the filter
@@ -24,17 +24,70 @@
 
 #include "logger.h"
 
+#include <QThread>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QJsonDocument>
+
 namespace {
-  const int MAX_LINES_BEFORE_FLUSH = 1000;
+  // the ring buffer size must be a power of 2
+  static const size_t LOG_BUFFER_SIZE = 4096;
+  static const size_t LOG_BUFFER_MASK = LOG_BUFFER_SIZE - 1;
+  // the writer thread is woken up early whenever this many messages are waiting
+  static const size_t LOG_WAKE_INTERVAL = LOG_BUFFER_SIZE / 4;
+  // milliseconds between writing batches of messages
+  static const int LOG_WRITE_INTERVAL = 50;
+  // milliseconds between updated() signals
+  static const int LOG_UPDATE_INTERVAL = 250;
+
+  QString messageLevel(QtMsgType type_) {
+    switch(type_) {
+      case QtDebugMsg:    return QStringLiteral("debug");
+      case QtInfoMsg:     return QStringLiteral("info");
+      case QtWarningMsg:  return QStringLiteral("warning");
+      case QtCriticalMsg: return QStringLiteral("critical");
+      case QtFatalMsg:    return QStringLiteral("fatal");
+    }
+    return QString();
+  }
 }
 using Tellico::Logger;
 
+struct Logger::Record {
+  QString message;
+  qint64 time = 0;
+  quintptr thread = 0;
+  QtMsgType type = QtInfoMsg;
+  int line = 0;
+  // a record is written in the format it was created for, even if the format changed since
+  Format format = Text;
+  // the context is only kept for the JSON output
+  QByteArray category;
+  QByteArray file;
+  QByteArray function;
+};
+
+struct Logger::Cell {
+  std::atomic<size_t> sequence;
+  Record record;
+};
+
 Logger* Logger::self() {
   static Logger logger;
   return &logger;
 }
 
-Logger::Logger(QObject* parent_) : QObject(parent_) {
+Logger::Logger(QObject* parent_) : QObject(parent_)
+    , m_format(Text)
+    , m_buffer(nullptr)
+    , m_enabled(false)
+    , m_stopping(false)
+    , m_enqueuePos(0)
+    , m_writtenPos(0)
+    , m_dequeuePos(0)
+    , m_writer(nullptr)
+    , m_writerId(nullptr) {
   m_oldHandler = qInstallMessageHandler([](QtMsgType type, const QMessageLogContext& ctx, const QString& msg) {
                                           Logger::self()->log(type, ctx, msg);
                                         });
@@ -43,29 +96,29 @@ Logger::Logger(QObject* parent_) : QObject(parent_) {
 }
 
 Logger::~Logger() {
+  stopWriter();
   if(m_logStream) {
     m_logStream->flush();
   }
   qInstallMessageHandler(m_oldHandler);
+  delete[] m_buffer;
 }
 
 void Logger::log(const QString& msg_) {
-  static int lineCounter = 0;
-  if(!m_logStream) return;
+  if(!m_enabled.load(std::memory_order_relaxed)) return;
 
-  QMutexLocker lock(&m_mutex);
-  ++lineCounter;
-  if(lineCounter > MAX_LINES_BEFORE_FLUSH) {
-    lineCounter = 1;
-    m_logStream->flush();
+  Record record;
+  record.message = msg_;
+  record.format = m_format;
+  if(record.format == JsonLines) {
+    record.time = QDateTime::currentMSecsSinceEpoch();
+    record.thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
   }
-
-  (*m_logStream) << msg_ << "\n";
-  Q_EMIT updated();
+  enqueue(std::move(record));
 }
 
 void Logger::log(QtMsgType type_, const QMessageLogContext& ctx_, const QString& msg_) {
-  if(!m_logStream) {
+  if(!m_enabled.load(std::memory_order_relaxed)) {
     // if there's no logging output defined, revert to previous behavior
     // but swallow info messages if they're in Tellico's category
     if(type_ != QtInfoMsg || strcmp(ctx_.category, "tellico") != 0) {
@@ -74,16 +127,166 @@ void Logger::log(QtMsgType type_, const QMessageLogContext& ctx_, const QString&
     return;
   }
 
-  const auto& logMsg = qFormatLogMessage(type_, ctx_, msg_);
-  log(logMsg);
+  Record record;
+  record.format = m_format;
+  if(record.format == JsonLines) {
+    record.message = msg_;
+    record.time = QDateTime::currentMSecsSinceEpoch();
+    record.thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+    record.type = type_;
+    record.line = ctx_.line;
+    record.category = QByteArray(ctx_.category);
+    record.file = QByteArray(ctx_.file);
+    record.function = QByteArray(ctx_.function);
+  } else {
+    record.message = qFormatLogMessage(type_, ctx_, msg_);
+  }
+  enqueue(std::move(record));
   // also include default handling of warning and critical messages
   if(type_ != QtInfoMsg && type_ != QtDebugMsg) {
     m_oldHandler(type_, ctx_, msg_);
   }
 }
 
+// a bounded multi-producer queue, each cell has a sequence number which tells whether
+// the cell is free for the producer at that position or filled for the writer
+void Logger::enqueue(Record&& record_) {
+  Cell* cell;
+  size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+  while(true) {
+    cell = &m_buffer[pos & LOG_BUFFER_MASK];
+    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+    const qptrdiff diff = static_cast<qptrdiff>(seq) - static_cast<qptrdiff>(pos);
+    if(diff == 0) {
+      if(m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if(diff < 0) {
+      // the buffer is full, so wait for the writer to catch up, unless the writer is the one logging
+      if(!m_enabled.load(std::memory_order_relaxed) || QThread::currentThreadId() == m_writerId.load()) {
+        return;
+      }
+      m_writerWait.wakeOne();
+      QThread::yieldCurrentThread();
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+    } else {
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+  cell->record = std::move(record_);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  if((pos + 1) % LOG_WAKE_INTERVAL == 0) {
+    m_writerWait.wakeOne();
+  }
+}
+
+void Logger::startWriter() {
+  if(!m_buffer) {
+    m_buffer = new Cell[LOG_BUFFER_SIZE];
+    for(size_t i = 0; i < LOG_BUFFER_SIZE; ++i) {
+      m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  m_stopping = false;
+  m_writer = QThread::create([this]() { runWriter(); });
+  m_writer->setObjectName(QStringLiteral("Tellico logger"));
+  m_enabled = true;
+  m_writer->start(QThread::LowPriority);
+}
+
+void Logger::stopWriter() {
+  m_enabled = false;
+  if(!m_writer) {
+    return;
+  }
+  {
+    QMutexLocker lock(&m_writerMutex);
+    m_stopping = true;
+    m_writerWait.wakeOne();
+  }
+  m_writer->wait();
+  m_writerId = nullptr;
+  QMutexLocker lock(&m_writerMutex);
+  delete m_writer;
+  m_writer = nullptr;
+}
+
+void Logger::runWriter() {
+  m_writerId = QThread::currentThreadId();
+  QElapsedTimer updateTimer;
+  updateTimer.start();
+  bool pendingUpdate = false;
+  while(true) {
+    int count = 0;
+    while(true) {
+      Cell* cell = &m_buffer[m_dequeuePos & LOG_BUFFER_MASK];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      if(static_cast<qptrdiff>(seq) - static_cast<qptrdiff>(m_dequeuePos + 1) < 0) {
+        break; // empty
+      }
+      writeRecord(cell->record);
+      cell->record = Record();
+      cell->sequence.store(m_dequeuePos + LOG_BUFFER_SIZE, std::memory_order_release);
+      ++m_dequeuePos;
+      ++count;
+    }
+
+    if(count > 0) {
+      m_logStream->flush();
+      pendingUpdate = true;
+    }
+    // the signal is emitted from this thread, so the receivers get it through the event loop
+    if(pendingUpdate && updateTimer.elapsed() >= LOG_UPDATE_INTERVAL) {
+      pendingUpdate = false;
+      updateTimer.restart();
+      Q_EMIT updated();
+    }
+
+    QMutexLocker lock(&m_writerMutex);
+    if(count > 0) {
+      m_writtenPos.store(m_dequeuePos, std::memory_order_release);
+      m_flushWait.wakeAll();
+    }
+    if(m_stopping) {
+      if(count == 0) {
+        break;
+      }
+    } else {
+      m_writerWait.wait(&m_writerMutex, LOG_WRITE_INTERVAL);
+    }
+  }
+  if(pendingUpdate) {
+    Q_EMIT updated();
+  }
+}
+
+void Logger::writeRecord(const Record& record_) {
+  if(record_.format == Text) {
+    (*m_logStream) << record_.message << '\n';
+    return;
+  }
+
+  QJsonObject obj;
+  obj.insert(QLatin1String("time"), QDateTime::fromMSecsSinceEpoch(record_.time).toString(Qt::ISODateWithMs));
+  obj.insert(QLatin1String("thread"), QString::number(record_.thread, 16));
+  obj.insert(QLatin1String("level"), messageLevel(record_.type));
+  if(!record_.category.isEmpty()) {
+    obj.insert(QLatin1String("category"), QString::fromLatin1(record_.category));
+  }
+  if(!record_.file.isEmpty()) {
+    obj.insert(QLatin1String("file"), QString::fromLocal8Bit(record_.file));
+    obj.insert(QLatin1String("line"), record_.line);
+  }
+  if(!record_.function.isEmpty()) {
+    obj.insert(QLatin1String("function"), QString::fromLatin1(record_.function));
+  }
+  obj.insert(QLatin1String("message"), record_.message);
+  (*m_logStream) << QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact)) << '\n';
+}
+
 void Logger::setLogFile(const QString& logFile_) {
   QMutexLocker lock(&m_mutex);
+  stopWriter();
   if(m_logStream) {
     m_logStream.reset(nullptr);
     m_logFile.close();
@@ -103,12 +306,37 @@ void Logger::setLogFile(const QString& logFile_) {
   }
 
   m_logStream.reset(new QTextStream(&m_logFile));
+  startWriter();
 }
 
 QString Logger::logFile() const {
   return m_logFile.fileName();
 }
 
+void Logger::setFormat(Format format_) {
+  QMutexLocker lock(&m_mutex);
+  if(m_format == format_) {
+    return;
+  }
+  // write everything logged in the old format before the writer is replaced
+  const bool restart = m_writer != nullptr;
+  flush();
+  stopWriter();
+  m_format = format_;
+  if(restart) {
+    startWriter();
+  }
+}
+
 void Logger::flush() {
-  if(m_logStream) m_logStream->flush();
+  if(!m_enabled.load(std::memory_order_relaxed) || QThread::currentThreadId() == m_writerId.load()) {
+    return;
+  }
+  const size_t target = m_enqueuePos.load(std::memory_order_acquire);
+  QMutexLocker lock(&m_writerMutex);
+  while(m_writer && m_writtenPos.load(std::memory_order_acquire) < target) {
+    m_writerWait.wakeOne();
+    // a message which is still being added by another thread shows up on the next pass
+    m_flushWait.wait(&m_writerMutex, LOG_WRITE_INTERVAL);
+  }
 }
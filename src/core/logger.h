@@ -29,19 +29,44 @@
 #include <QFile>
 #include <QTextStream>
 #include <QMutex>
+#include <QWaitCondition>
+
+#include <atomic>
+
+class QThread;
 
 namespace Tellico {
 
+/**
+ * The Logger writes the log messages to a file.
+ *
+ * Any thread can log a message without taking a lock, the messages are put in a ring buffer
+ * and a background thread writes them to the file in batches. The updated() signal is only
+ * emitted a few times a second, no matter how many messages are logged.
+ */
 class Logger : public QObject {
 Q_OBJECT
 
 public:
+  enum Format {
+    Text,
+    /**
+     * One JSON object per line, with the time, thread id, message type, and source location
+     */
+    JsonLines
+  };
+
   static Logger* self();
 
   void log(const QString& msg);
   void log(QtMsgType type, const QMessageLogContext& ctx, const QString& msg);
   void setLogFile(const QString& logFile);
   QString logFile() const;
+  void setFormat(Format format);
+  Format format() const { return m_format; }
+  /**
+   * Blocks until every message logged so far has been written to the file
+   */
   void flush();
 
 Q_SIGNALS:
@@ -51,10 +76,34 @@ private:
   explicit Logger(QObject* parent = nullptr);
   virtual ~Logger();
 
+  struct Record;
+  struct Cell;
+
+  void enqueue(Record&& record);
+  void startWriter();
+  void stopWriter();
+  void runWriter();
+  void writeRecord(const Record& record);
+
   QtMessageHandler m_oldHandler;
   QFile m_logFile;
   QScopedPointer<QTextStream> m_logStream;
+  std::atomic<Format> m_format;
+  // only used for changing the log file, logging a message never takes the lock
   mutable QMutex m_mutex;
+
+  Cell* m_buffer;
+  std::atomic<bool> m_enabled;
+  std::atomic<bool> m_stopping;
+  std::atomic<size_t> m_enqueuePos;
+  std::atomic<size_t> m_writtenPos;
+  size_t m_dequeuePos;
+  QThread* m_writer;
+  // producers compare against the thread id, the QThread itself is only touched under m_mutex
+  std::atomic<Qt::HANDLE> m_writerId;
+  QMutex m_writerMutex;
+  QWaitCondition m_writerWait;
+  QWaitCondition m_flushWait;
 };
 
 } // end namespace
@@ -24,6 +24,7 @@
 
 #include "netaccess.h"
 #include "tellico_strings.h"
+#include "networkreplay.h"
 #include "../utils/guiproxy.h"
 #include "../tellico_debug.h"
 
@@ -73,7 +74,7 @@ bool NetAccess::download(const QUrl& url_, QString& target_, QWidget* window_, b
   }
 
   // KIO::storedGet seems to handle Content-Encoding: gzip ok
-  KIO::StoredTransferJob* getJob = KIO::storedGet(url_, KIO::NoReload, flags);
+  KIO::StoredTransferJob* getJob = NetworkReplay::storedGet(url_, KIO::NoReload, flags);
   KJobWidgets::setWindow(getJob, window_);
   if(getJob->exec()) {
     QFile f(target_);
@@ -125,8 +126,35 @@ QPixmap NetAccess::filePreview(const KFileItem& item, int size) {
   return netaccess.m_preview;
 }
 
-void NetAccess::slotPreview(const KFileItem&, const QPixmap& pix_) {
+QHash<QUrl, QPixmap> NetAccess::filePreviews(const KFileItemList& items_, int size_) {
+  NetAccess netaccess;
+  for(const auto& item : items_) {
+    netaccess.m_previews.insert(item.url(), QPixmap());
+  }
+  if(items_.isEmpty()) {
+    return netaccess.m_previews;
+  }
+
+  const QStringList plugins = KIO::PreviewJob::defaultPlugins();
+  KIO::PreviewJob* previewJob = KIO::filePreview(items_, QSize(size_, size_), &plugins);
+  connect(previewJob, &KIO::PreviewJob::gotPreview,
+          &netaccess, &Tellico::NetAccess::slotPreview);
+
+  if(GUI::Proxy::widget()) {
+    KJobWidgets::setWindow(previewJob, GUI::Proxy::widget());
+  }
+  if(!previewJob->exec()) {
+    myDebug() << "Preview job did not succeed";
+  }
+  if(previewJob->error() != 0) {
+    myDebug() << previewJob->errorString();
+  }
+  return netaccess.m_previews;
+}
+
+void NetAccess::slotPreview(const KFileItem& item_, const QPixmap& pix_) {
   m_preview = pix_;
+  m_previews.insert(item_.url(), pix_);
 }
 
 void NetAccess::removeTempFile(const QString& name) {
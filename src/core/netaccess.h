@@ -27,10 +27,11 @@
 
 #include <QObject>
 #include <QPixmap>
-
-class QUrl;
+#include <QHash>
+#include <QUrl>
 
 class KFileItem;
+class KFileItemList;
 
 namespace Tellico {
 
@@ -41,6 +42,11 @@ public:
   static bool download(const QUrl& u, QString& target, QWidget* window, bool quiet=false);
   static QPixmap filePreview(const QUrl& fileName, int size=196);
   static QPixmap filePreview(const KFileItem& item, int size=196);
+  /**
+   * Generates previews for several files with a single job. Every item is included in the
+   * returned hash, with a null pixmap if no preview could be made.
+   */
+  static QHash<QUrl, QPixmap> filePreviews(const KFileItemList& items, int size=196);
   static void removeTempFile(const QString& name);
   static bool exists(const QUrl& url, bool sourceSide, QWidget* window);
 
@@ -51,6 +57,7 @@ private Q_SLOTS:
 
 private:
   QPixmap m_preview;
+  QHash<QUrl, QPixmap> m_previews;
   static QString s_lastErrorMessage;
 };
 
@@ -0,0 +1,196 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "networkreplay.h"
+#include "../tellico_debug.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrlQuery>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+  // query items with these names are left out when matching a request
+  static const char* const REPLAY_PRIVATE_ITEMS[] = {
+    "key", "apikey", "api_key", "api-key", "token", "access_token", "client_id", "client_secret", "secret"
+  };
+
+  struct ReplayConfig {
+    ReplayConfig();
+    Tellico::NetworkReplay::Mode mode;
+    QString directory;
+    int latency;
+    int bandwidth;
+  };
+
+  ReplayConfig::ReplayConfig() : mode(Tellico::NetworkReplay::Off), latency(0), bandwidth(0) {
+    const QString mode = qEnvironmentVariable("TELLICO_NETWORK_REPLAY").toLower();
+    if(mode == QLatin1String("record")) {
+      this->mode = Tellico::NetworkReplay::Record;
+    } else if(mode == QLatin1String("replay")) {
+      this->mode = Tellico::NetworkReplay::Replay;
+    }
+    directory = qEnvironmentVariable("TELLICO_NETWORK_REPLAY_DIR");
+    if(directory.isEmpty()) {
+      directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/network-replay");
+    }
+    latency = qMax(0, qEnvironmentVariableIntValue("TELLICO_NETWORK_REPLAY_LATENCY"));
+    bandwidth = qMax(0, qEnvironmentVariableIntValue("TELLICO_NETWORK_REPLAY_BANDWIDTH"));
+  }
+
+  ReplayConfig& replayConfig() {
+    static ReplayConfig config;
+    return config;
+  }
+
+  QUrl publicUrl(const QUrl& url_) {
+    QUrlQuery query(url_);
+    for(const char* item : REPLAY_PRIVATE_ITEMS) {
+      query.removeAllQueryItems(QLatin1String(item));
+    }
+    QUrl url(url_);
+    url.setQuery(query);
+    url.setUserInfo(QString());
+    return url;
+  }
+}
+
+using Tellico::NetworkReplay;
+
+NetworkReplay::Mode NetworkReplay::mode() {
+  return replayConfig().mode;
+}
+
+QString NetworkReplay::directory() {
+  return replayConfig().directory;
+}
+
+void NetworkReplay::setMode(Mode mode_, const QString& directory_) {
+  replayConfig().mode = mode_;
+  if(!directory_.isEmpty()) {
+    replayConfig().directory = directory_;
+  }
+}
+
+void NetworkReplay::setLatency(int msecs_) {
+  replayConfig().latency = qMax(0, msecs_);
+}
+
+void NetworkReplay::setBandwidth(int kbytesPerSecond_) {
+  replayConfig().bandwidth = qMax(0, kbytesPerSecond_);
+}
+
+KIO::StoredTransferJob* NetworkReplay::storedGet(const QUrl& url_, KIO::LoadType reload_, KIO::JobFlags flags_) {
+  // local files are never recorded, some data sources read them directly in the tests
+  if(mode() == Off || url_.isLocalFile()) {
+    return KIO::storedGet(url_, reload_, flags_);
+  }
+  const QString fileName = responseFile("GET", url_);
+  if(mode() == Replay) {
+    return replay(fileName, url_, flags_);
+  }
+  KIO::StoredTransferJob* job = KIO::storedGet(url_, reload_, flags_);
+  record(job, fileName, "GET", url_);
+  return job;
+}
+
+KIO::StoredTransferJob* NetworkReplay::storedHttpPost(const QByteArray& data_, const QUrl& url_, KIO::JobFlags flags_) {
+  if(mode() == Off) {
+    return KIO::storedHttpPost(data_, url_, flags_);
+  }
+  const QString fileName = responseFile("POST", url_, data_);
+  if(mode() == Replay) {
+    return replay(fileName, url_, flags_);
+  }
+  KIO::StoredTransferJob* job = KIO::storedHttpPost(data_, url_, flags_);
+  record(job, fileName, "POST", url_);
+  return job;
+}
+
+QString NetworkReplay::responseFile(const QByteArray& method_, const QUrl& url_, const QByteArray& data_) {
+  const QUrl url = publicUrl(url_);
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(method_);
+  hash.addData(url.toEncoded());
+  hash.addData(data_);
+  const QString host = url.host().isEmpty() ? QStringLiteral("localhost") : url.host();
+  return directory() + QLatin1Char('/') + host + QLatin1Char('/') +
+         QString::fromLatin1(hash.result().toHex().left(16)) + QLatin1String(".data");
+}
+
+KIO::StoredTransferJob* NetworkReplay::replay(const QString& fileName_, const QUrl& url_, KIO::JobFlags flags_) {
+  const QFileInfo info(fileName_);
+  if(!info.exists()) {
+    // the job fails the same way as for a missing file, which the data sources already handle
+    myWarning() << "No recorded response for" << publicUrl(url_).toDisplayString();
+  }
+  KIO::StoredTransferJob* job = KIO::storedGet(QUrl::fromLocalFile(fileName_), KIO::NoReload,
+                                               flags_ | KIO::HideProgressInfo);
+  const ReplayConfig& config = replayConfig();
+  qint64 delay = config.latency;
+  if(config.bandwidth > 0) {
+    delay += info.size() * 1000 / (qint64(config.bandwidth) * 1024);
+  }
+  if(delay > 0) {
+    job->suspend();
+    QTimer::singleShot(delay, job, [job]() { job->resume(); });
+  }
+  return job;
+}
+
+void NetworkReplay::record(KIO::StoredTransferJob* job_, const QString& fileName_, const QByteArray& method_, const QUrl& url_) {
+  // the connection is made before the data source connects to the job, so the response
+  // is written before the data source reads it
+  QObject::connect(job_, &KJob::result, job_, [job_, fileName_, method_, url_]() {
+    if(job_->error()) {
+      return;
+    }
+    if(!QDir().mkpath(QFileInfo(fileName_).absolutePath())) {
+      myWarning() << "Unable to create directory for" << fileName_;
+      return;
+    }
+    QSaveFile file(fileName_);
+    if(!file.open(QIODevice::WriteOnly) || file.write(job_->data()) < 0 || !file.commit()) {
+      myWarning() << "Unable to write recorded response:" << fileName_;
+      return;
+    }
+    // a description of the request, only for finding the right file
+    QSaveFile info(fileName_.left(fileName_.size() - 4) + QLatin1String("json"));
+    if(info.open(QIODevice::WriteOnly)) {
+      QJsonObject obj;
+      obj.insert(QStringLiteral("method"), QString::fromLatin1(method_));
+      obj.insert(QStringLiteral("url"), publicUrl(url_).toString());
+      obj.insert(QStringLiteral("size"), job_->data().size());
+      obj.insert(QStringLiteral("content-type"), job_->queryMetaData(QStringLiteral("content-type")));
+      info.write(QJsonDocument(obj).toJson());
+      info.commit();
+    }
+    myLog() << "Recorded response for" << publicUrl(url_).toDisplayString();
+  });
+}
@@ -0,0 +1,81 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TELLICO_NETWORKREPLAY_H
+#define TELLICO_NETWORKREPLAY_H
+
+#include <KIO/StoredTransferJob>
+
+#include <QString>
+#include <QUrl>
+
+namespace Tellico {
+
+/**
+ * NetworkReplay records the responses to the requests made by the data sources, and plays
+ * them back later from local files without any network access. The data sources create
+ * their transfer jobs here instead of calling KIO directly.
+ *
+ * The mode is set with the TELLICO_NETWORK_REPLAY environment variable, either "record" or
+ * "replay", and the recorded files are kept in TELLICO_NETWORK_REPLAY_DIR. A replayed
+ * response can be delayed to simulate a slow server, with a fixed latency in
+ * TELLICO_NETWORK_REPLAY_LATENCY, in milliseconds, and a bandwidth in
+ * TELLICO_NETWORK_REPLAY_BANDWIDTH, in kilobytes per second.
+ *
+ * Query items which look like API keys are not used for matching a request to its recorded
+ * response, so the recorded files can be shared and replayed without the keys.
+ */
+class NetworkReplay {
+public:
+  enum Mode { Off, Record, Replay };
+
+  static Mode mode();
+  static QString directory();
+  static void setMode(Mode mode, const QString& directory = QString());
+  /**
+   * Sets the delay added to every replayed response, in milliseconds
+   */
+  static void setLatency(int msecs);
+  /**
+   * Sets the simulated bandwidth for replayed responses, in kilobytes per second,
+   * or 0 for no limit
+   */
+  static void setBandwidth(int kbytesPerSecond);
+
+  static KIO::StoredTransferJob* storedGet(const QUrl& url, KIO::LoadType reload = KIO::NoReload,
+                                           KIO::JobFlags flags = KIO::HideProgressInfo);
+  static KIO::StoredTransferJob* storedHttpPost(const QByteArray& data, const QUrl& url,
+                                                KIO::JobFlags flags = KIO::HideProgressInfo);
+  /**
+   * Returns the local file with the recorded response for a request
+   */
+  static QString responseFile(const QByteArray& method, const QUrl& url, const QByteArray& data = QByteArray());
+
+private:
+  static KIO::StoredTransferJob* replay(const QString& fileName, const QUrl& url, KIO::JobFlags flags);
+  static void record(KIO::StoredTransferJob* job, const QString& fileName, const QByteArray& method, const QUrl& url);
+};
+
+} // end namespace
+#endif
@@ -0,0 +1,224 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "tracer.h"
+#include "../tellico_debug.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+  // limits the memory used by a long trace to several tens of megabytes per thread
+  static const size_t TRACE_MAX_EVENTS_PER_THREAD = 1 << 20;
+}
+
+using Tellico::Tracer;
+
+struct Tracer::Event {
+  char phase;
+  const char* category;
+  const char* name;
+  qint64 time; // nanoseconds
+  qint64 duration;
+  quint64 id;
+  qint64 value;
+  QString arg;
+};
+
+struct Tracer::ThreadBuffer {
+  // only ever contended when the trace is started or written
+  QMutex mutex;
+  std::vector<Event> events;
+  int tid = 0;
+  QString threadName;
+  size_t dropped = 0;
+};
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+Tracer* Tracer::self() {
+  static Tracer tracer;
+  return &tracer;
+}
+
+Tracer::Tracer() {
+  m_clock.start();
+}
+
+void Tracer::start(const QString& fileName_) {
+  QMutexLocker lock(&m_mutex);
+  m_fileName = fileName_;
+  for(const auto& buffer : m_buffers) {
+    QMutexLocker bufferLock(&buffer->mutex);
+    buffer->events.clear();
+    buffer->dropped = 0;
+  }
+  s_enabled = true;
+  myLog() << "Writing trace to" << fileName_;
+}
+
+bool Tracer::stop() {
+  if(!s_enabled.exchange(false)) {
+    return false;
+  }
+  QString fileName;
+  {
+    QMutexLocker lock(&m_mutex);
+    fileName = m_fileName;
+  }
+  return writeTrace(fileName);
+}
+
+QString Tracer::fileName() const {
+  QMutexLocker lock(&m_mutex);
+  return m_fileName;
+}
+
+void Tracer::complete(const char* category_, const char* name_, qint64 start_, const QString& arg_) {
+  if(!isEnabled()) return;
+  const qint64 end = now();
+  record(Event{'X', category_, name_, start_, end - start_, 0, 0, arg_});
+}
+
+void Tracer::counter(const char* category_, const char* name_, qint64 value_) {
+  if(!isEnabled()) return;
+  record(Event{'C', category_, name_, now(), 0, 0, value_, QString()});
+}
+
+void Tracer::asyncBegin(const char* category_, const char* name_, quint64 id_, const QString& arg_) {
+  if(!isEnabled()) return;
+  record(Event{'b', category_, name_, now(), 0, id_, 0, arg_});
+}
+
+void Tracer::asyncEnd(const char* category_, const char* name_, quint64 id_) {
+  if(!isEnabled()) return;
+  record(Event{'e', category_, name_, now(), 0, id_, 0, QString()});
+}
+
+void Tracer::record(Event&& event_) {
+  ThreadBuffer* buffer = threadBuffer();
+  QMutexLocker lock(&buffer->mutex);
+  if(buffer->events.size() >= TRACE_MAX_EVENTS_PER_THREAD) {
+    ++buffer->dropped;
+    return;
+  }
+  buffer->events.push_back(std::move(event_));
+}
+
+Tracer::ThreadBuffer* Tracer::threadBuffer() {
+  thread_local ThreadBuffer* threadBuffer = nullptr;
+  if(!threadBuffer) {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    QThread* thread = QThread::currentThread();
+    buffer->threadName = thread->objectName();
+    QMutexLocker lock(&m_mutex);
+    buffer->tid = static_cast<int>(m_buffers.size()) + 1;
+    if(buffer->threadName.isEmpty()) {
+      const bool isMain = QCoreApplication::instance() && thread == QCoreApplication::instance()->thread();
+      buffer->threadName = isMain ? QStringLiteral("main") : QStringLiteral("thread %1").arg(buffer->tid);
+    }
+    threadBuffer = buffer.get();
+    m_buffers.push_back(std::move(buffer));
+  }
+  return threadBuffer;
+}
+
+bool Tracer::writeTrace(const QString& fileName_) {
+  if(fileName_.isEmpty()) {
+    return false;
+  }
+  QSaveFile file(fileName_);
+  if(!file.open(QIODevice::WriteOnly)) {
+    myWarning() << "Unable to write trace file:" << fileName_;
+    return false;
+  }
+
+  const qint64 pid = QCoreApplication::applicationPid();
+  bool first = true;
+  auto writeEvent = [&file, &first](const QJsonObject& obj) {
+    file.write(first ? "\n" : ",\n");
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    first = false;
+  };
+
+  file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  writeEvent(QJsonObject{{QStringLiteral("ph"), QStringLiteral("M")},
+                         {QStringLiteral("name"), QStringLiteral("process_name")},
+                         {QStringLiteral("pid"), pid},
+                         {QStringLiteral("args"), QJsonObject{{QStringLiteral("name"), QStringLiteral("Tellico")}}}});
+
+  size_t dropped = 0;
+  QMutexLocker lock(&m_mutex);
+  for(const auto& buffer : m_buffers) {
+    std::vector<Event> events;
+    {
+      QMutexLocker bufferLock(&buffer->mutex);
+      events.swap(buffer->events);
+      dropped += buffer->dropped;
+      buffer->dropped = 0;
+    }
+    if(events.empty()) {
+      continue;
+    }
+    writeEvent(QJsonObject{{QStringLiteral("ph"), QStringLiteral("M")},
+                           {QStringLiteral("name"), QStringLiteral("thread_name")},
+                           {QStringLiteral("pid"), pid},
+                           {QStringLiteral("tid"), buffer->tid},
+                           {QStringLiteral("args"), QJsonObject{{QStringLiteral("name"), buffer->threadName}}}});
+    for(const auto& event : events) {
+      QJsonObject obj;
+      obj.insert(QStringLiteral("ph"), QString(QLatin1Char(event.phase)));
+      obj.insert(QStringLiteral("cat"), QLatin1String(event.category));
+      obj.insert(QStringLiteral("name"), QLatin1String(event.name));
+      obj.insert(QStringLiteral("pid"), pid);
+      obj.insert(QStringLiteral("tid"), buffer->tid);
+      // the trace format uses microseconds
+      obj.insert(QStringLiteral("ts"), event.time / 1000.0);
+      switch(event.phase) {
+        case 'X':
+          obj.insert(QStringLiteral("dur"), event.duration / 1000.0);
+          break;
+        case 'C':
+          obj.insert(QStringLiteral("args"), QJsonObject{{QStringLiteral("value"), event.value}});
+          break;
+        case 'b':
+        case 'e':
+          obj.insert(QStringLiteral("id"), QStringLiteral("0x") + QString::number(event.id, 16));
+          break;
+      }
+      if(!event.arg.isEmpty()) {
+        obj.insert(QStringLiteral("args"), QJsonObject{{QStringLiteral("arg"), event.arg}});
+      }
+      writeEvent(obj);
+    }
+  }
+  file.write("\n]}\n");
+  if(dropped > 0) {
+    myDebug() << "Dropped" << dropped << "trace events";
+  }
+  return file.commit();
+}
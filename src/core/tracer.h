@@ -0,0 +1,136 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TELLICO_TRACER_H
+#define TELLICO_TRACER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#define TELLICO_TRACE_CONCAT2(a, b) a##b
+#define TELLICO_TRACE_CONCAT(a, b) TELLICO_TRACE_CONCAT2(a, b)
+/**
+ * Records the time spent in the rest of the current scope. The category and name must be
+ * string literals, since only the pointers are kept.
+ */
+#define TRACE_ZONE(category, name) \
+  Tellico::TraceZone TELLICO_TRACE_CONCAT(traceZone_, __LINE__)(category, name)
+#define TRACE_COUNTER(category, name, value) \
+  do { if(Tellico::Tracer::isEnabled()) Tellico::Tracer::self()->counter(category, name, value); } while(false)
+
+namespace Tellico {
+
+/**
+ * The Tracer records what Tellico is doing and how long it takes, and writes it out
+ * in the Chrome trace format, which can be opened with Perfetto or chrome://tracing.
+ *
+ * There are three kinds of events. A zone is the time spent in a scope on one thread. A counter
+ * is a value which changes over time. An async span begins and ends at different places,
+ * possibly on different threads, like a network request, and is matched by its id.
+ *
+ * Tracing is off by default. When it is off, recording an event only checks a flag.
+ * Each thread keeps its own event buffer so that the threads don't wait on each other.
+ */
+class Tracer {
+public:
+  static Tracer* self();
+
+  static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+  /**
+   * Starts recording events, any previous events are discarded.
+   *
+   * @param fileName The file for the trace, written when tracing is stopped
+   */
+  void start(const QString& fileName);
+  /**
+   * Stops recording events and writes the trace file.
+   *
+   * @return false if tracing was not started or the file could not be written
+   */
+  bool stop();
+  QString fileName() const;
+  /**
+   * Returns the number of nanoseconds since the tracer was created
+   */
+  qint64 now() const { return m_clock.nsecsElapsed(); }
+
+  void complete(const char* category, const char* name, qint64 start, const QString& arg = QString());
+  void counter(const char* category, const char* name, qint64 value);
+  void asyncBegin(const char* category, const char* name, quint64 id, const QString& arg = QString());
+  void asyncEnd(const char* category, const char* name, quint64 id);
+
+private:
+  Tracer();
+  Q_DISABLE_COPY(Tracer)
+
+  struct Event;
+  struct ThreadBuffer;
+
+  void record(Event&& event);
+  ThreadBuffer* threadBuffer();
+  bool writeTrace(const QString& fileName);
+
+  static std::atomic<bool> s_enabled;
+
+  QElapsedTimer m_clock;
+  mutable QMutex m_mutex;
+  QString m_fileName;
+  // buffers are never deleted, since a thread keeps a pointer to its own
+  std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+};
+
+/**
+ * Records a complete event for the lifetime of the object.
+ */
+class TraceZone {
+public:
+  TraceZone(const char* category, const char* name) : m_category(category), m_name(name)
+      , m_start(Tracer::isEnabled() ? Tracer::self()->now() : -1) {}
+  ~TraceZone() {
+    if(m_start >= 0 && Tracer::isEnabled()) {
+      Tracer::self()->complete(m_category, m_name, m_start, m_arg);
+    }
+  }
+  /**
+   * Adds a single argument to the event, such as a file name
+   */
+  void setArgument(const QString& arg) { if(m_start >= 0) m_arg = arg; }
+
+private:
+  Q_DISABLE_COPY(TraceZone)
+
+  const char* m_category;
+  const char* m_name;
+  qint64 m_start;
+  QString m_arg;
+};
+
+} // end namespace
+#endif
@@ -30,6 +30,7 @@
 #include "fieldformat.h"
 #include "utils/bibtexhandler.h"
 #include "mainwindow.h"
+#include "core/tracer.h"
 #include "tellico_debug.h"
 
 #include <QDBusConnection>
@@ -80,6 +81,22 @@ bool ApplicationInterface::showEntry(int id)  {
   return m_mainWindow->showEntry(id);
 }
 
+bool ApplicationInterface::startTrace(const QString& file) {
+  if(file.isEmpty()) {
+    return false;
+  }
+  const QUrl url = QUrl::fromUserInput(file, QDir::currentPath(), QUrl::AssumeLocalFile);
+  if(!url.isLocalFile()) {
+    return false;
+  }
+  Tracer::self()->start(url.toLocalFile());
+  return true;
+}
+
+bool ApplicationInterface::stopTrace() {
+  return Tracer::self()->stop();
+}
+
 bool ApplicationInterface::importFile(Tellico::Import::Format format, const QString& file, Tellico::Import::Action action) {
   const QUrl url = QUrl::fromUserInput(file, QDir::currentPath(), QUrl::AssumeLocalFile);
   myLog() << "Importing" << format << "-" << url.toDisplayString(QUrl::PreferLocalFile);
@@ -74,6 +74,12 @@ public Q_SLOTS:
   Q_SCRIPTABLE virtual void setFilter(const QString& text);
   Q_SCRIPTABLE virtual bool showEntry(int id);
 
+  /**
+   * Starts recording a trace in the Chrome trace format, written to a file when stopped
+   */
+  Q_SCRIPTABLE bool startTrace(const QString& file);
+  Q_SCRIPTABLE bool stopTrace();
+
 private:
   virtual bool importFile(Import::Format format, const QString& file, Import::Action action);
   virtual bool exportCollection(Export::Format format, const QString& file, bool filtered);
@@ -42,6 +42,7 @@
 #include "config/tellico_config.h"
 #include "entrycomparison.h"
 #include "utils/guiproxy.h"
+#include "core/tracer.h"
 #include "tellico_debug.h"
 
 #include <KMessageBox>
@@ -129,6 +130,8 @@ bool Document::openDocument(const QUrl& url_) {
   if(url_.isEmpty()) {
     return false;
   }
+  TraceZone zone("document", "openDocument");
+  zone.setArgument(url_.toDisplayString(QUrl::PreferLocalFile));
   // delayed image loading only works for local files
   m_loadAllImages = !url_.isLocalFile();
   m_loadImagesTimer.stop(); // avoid potential race condition
@@ -137,6 +140,7 @@ bool Document::openDocument(const QUrl& url_) {
     m_importer->deleteLater();
   }
   m_importer = new Import::TellicoImporter(url_, m_loadAllImages);
+  m_importer->setUseSnapshot(true);
 
   ProgressItem& item = ProgressManager::self()->newProgressItem(m_importer, m_importer->progressLabel(), true);
   connect(m_importer, &Import::Importer::signalTotalSteps,
@@ -146,7 +150,11 @@ bool Document::openDocument(const QUrl& url_) {
   connect(&item, &ProgressItem::signalCancelled, m_importer, &Import::Importer::slotCancel);
   ProgressItem::Done done(m_importer);
 
-  CollPtr coll = m_importer->collection();
+  CollPtr coll;
+  {
+    TRACE_ZONE("document", "readCollection");
+    coll = m_importer->collection();
+  }
   if(!m_importer) {
     myDebug() << "The importer was deleted out from under the document";
     return false;
@@ -172,7 +180,10 @@ bool Document::openDocument(const QUrl& url_) {
   setURL(url_);
   m_validFile = true;
 
-  Q_EMIT signalCollectionAdded(m_coll);
+  {
+    TRACE_ZONE("document", "collectionAdded");
+    Q_EMIT signalCollectionAdded(m_coll);
+  }
 
   // m_importer might have been deleted?
   setModified(m_importer && m_importer->modifiedOriginal());
@@ -205,6 +216,9 @@ bool Document::saveDocument(const QUrl& url_, bool force_) {
     }
   }
 
+  TraceZone zone("document", "saveDocument");
+  zone.setArgument(url_.toDisplayString(QUrl::PreferLocalFile));
+
   // in case we're still loading images, give that a chance to cancel
   m_cancelImageWriting = true;
   qApp->processEvents();
@@ -228,6 +242,7 @@ bool Document::saveDocument(const QUrl& url_, bool force_) {
     totalSteps = 100;
     item.setTotalSteps(totalSteps);
     m_cancelImageWriting = false;
+    TRACE_ZONE("document", "writeAllImages");
     writeAllImages(imageLocation == Config::ImagesInAppDir ? ImageFactory::DataDir : ImageFactory::LocalDir, url_);
   }
   QScopedPointer<Export::Exporter> exporter;
@@ -566,6 +581,14 @@ void Document::slotLoadAllImages() {
       if(id.isEmpty() || images.has(id)) {
         continue;
       }
+      // link only images from the network are queued so they download together
+      // instead of one at a time
+      const QUrl imageUrl(id);
+      if(!imageUrl.isRelative() && !imageUrl.isLocalFile() && !ImageFactory::hasLocalImage(id)) {
+        ImageFactory::requestImageById(id);
+        images.add(id);
+        continue;
+      }
       // this is the early loading, so just by calling imageById()
       // the image gets sucked from the zip file and written to disk
       // by ImageFactory::imageById()
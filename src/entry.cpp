@@ -33,6 +33,9 @@
 
 #include <KLocalizedString>
 
+#include <cmath>
+#include <limits>
+
 using namespace Tellico;
 using namespace Tellico::Data;
 using Tellico::Data::Entry;
@@ -75,6 +78,9 @@ Entry& Entry::operator=(const Entry& other_) {
   m_fieldValues.remove(QStringLiteral("cdate"));
   m_fieldValues.remove(QStringLiteral("mdate"));
   m_formattedFields = other_.m_formattedFields;
+  // the parsed values would include the creation and modified dates, just start over
+  m_numberValues.clear();
+  m_dateValues.clear();
   return *this;
 }
 
@@ -188,6 +194,51 @@ QString Entry::formattedField(Tellico::Data::FieldPtr field_, FieldFormat::Reque
   return m_formattedFields.value(field_->name());
 }
 
+double Entry::numberField(Tellico::Data::FieldPtr field_, bool* ok_) const {
+  if(!field_) {
+    if(ok_) *ok_ = false;
+    return 0;
+  }
+  // derived values depend on other fields, so they can't be kept
+  if(field_->hasFlag(Field::Derived)) {
+    return field(field_).toDouble(ok_);
+  }
+  double value;
+  auto it = m_numberValues.constFind(field_->name());
+  if(it != m_numberValues.constEnd()) {
+    value = it.value();
+  } else {
+    bool ok = false;
+    value = m_fieldValues.value(field_->name()).toDouble(&ok);
+    if(!ok) {
+      value = std::numeric_limits<double>::quiet_NaN();
+    }
+    m_numberValues.insert(field_->name(), value);
+  }
+  const bool isNumber = !std::isnan(value);
+  if(ok_) *ok_ = isNumber;
+  return isNumber ? value : 0;
+}
+
+QDate Entry::dateField(Tellico::Data::FieldPtr field_) const {
+  if(!field_) {
+    return QDate();
+  }
+  // Bug 361625: some older versions of Tellico serialized the date with single digit month and day
+  static const QString dateFormat(QStringLiteral("yyyy-M-d"));
+  // derived values depend on other fields, so they can't be kept
+  if(field_->hasFlag(Field::Derived)) {
+    return QDate::fromString(field(field_), dateFormat);
+  }
+  auto it = m_dateValues.constFind(field_->name());
+  if(it != m_dateValues.constEnd()) {
+    return it.value();
+  }
+  const QDate value = QDate::fromString(m_fieldValues.value(field_->name()), dateFormat);
+  m_dateValues.insert(field_->name(), value);
+  return value;
+}
+
 bool Entry::setField(Tellico::Data::FieldPtr field_, const QString& value_, bool updateMDate_) {
   return setField(field_->name(), value_, updateMDate_);
 }
@@ -222,38 +273,60 @@ bool Entry::setField(const QString& name_, const QString& value_, bool updateMDa
   return res;
 }
 
+bool Entry::loadField(Tellico::Data::FieldPtr field_, const QString& value_) {
+  Q_ASSERT(field_);
+  Q_ASSERT(m_coll->fieldByName(field_->name()) == field_);
+  return setFieldImpl(field_, value_);
+}
+
 bool Entry::setFieldImpl(const QString& name_, const QString& value_) {
   // an empty value means remove the field
   if(value_.isEmpty()) {
     if(m_fieldValues.remove(name_)) {
       invalidateFormattedFieldValue(name_);
+      invalidateTypedFieldValue(name_);
     }
     return true;
   }
 
-  if(m_coll && !m_coll->isAllowed(name_, value_)) {
+  Data::FieldPtr f = m_coll->fieldByName(name_);
+  if(!f) {
     myDebug() << "for" << name_ << ", value is not allowed -" << value_;
     return false;
   }
+  return setFieldImpl(f, value_);
+}
 
-  Data::FieldPtr f = m_coll->fieldByName(name_);
-  if(!f) {
+bool Entry::setFieldImpl(Tellico::Data::FieldPtr field_, const QString& value_) {
+  const QString& name = field_->name();
+  // an empty value means remove the field
+  if(value_.isEmpty()) {
+    if(m_fieldValues.remove(name)) {
+      invalidateFormattedFieldValue(name);
+      invalidateTypedFieldValue(name);
+    }
+    return true;
+  }
+
+  if(!m_coll->isAllowed(field_, value_)) {
+    myDebug() << "for" << name << ", value is not allowed -" << value_;
     return false;
   }
 
   // the string store is probably only useful for fields with auto-completion or choice/number/bool
-  bool shareType = f->type() == Field::Choice ||
-                   f->type() == Field::Bool ||
-                   f->type() == Field::Image ||
-                   f->type() == Field::Rating ||
-                   f->type() == Field::Number;
-  if(!f->hasFlag(Field::AllowMultiple) &&
-     (shareType || (f->type() == Field::Line && f->hasFlag(Field::AllowCompletion)))) {
-    m_fieldValues.insert(Tellico::shareString(name_), Tellico::shareString(value_));
+  bool shareType = field_->type() == Field::Choice ||
+                   field_->type() == Field::Bool ||
+                   field_->type() == Field::Image ||
+                   field_->type() == Field::Rating ||
+                   field_->type() == Field::Number;
+  if(!field_->hasFlag(Field::AllowMultiple) &&
+     (shareType || (field_->type() == Field::Line && field_->hasFlag(Field::AllowCompletion)))) {
+    m_fieldValues.insert(Tellico::shareString(name), Tellico::shareString(value_));
   } else {
-    m_fieldValues.insert(Tellico::shareString(name_), value_);
+    m_fieldValues.insert(Tellico::shareString(name), value_);
   }
-  invalidateFormattedFieldValue(name_);
+  invalidateFormattedFieldValue(name);
+  invalidateTypedFieldValue(name);
   return true;
 }
 
@@ -278,6 +351,10 @@ bool Entry::removeFromGroup(EntryGroup* group_) {
   return success;
 }
 
+bool Entry::leaveGroup(EntryGroup* group_) {
+  return m_groups.removeOne(group_);
+}
+
 void Entry::clearGroups() {
   m_groups.clear();
 }
@@ -328,3 +405,29 @@ void Entry::invalidateFormattedFieldValue(const QString& name_) {
     m_formattedFields.remove(name_);
   }
 }
+
+void Entry::swapValues(Entry& other_) {
+  if(this == &other_) return;
+
+  m_fieldValues.swap(other_.m_fieldValues);
+  // same special case for the creation and modified dates as in the assignment operator
+  m_fieldValues.remove(QStringLiteral("cdate"));
+  m_fieldValues.remove(QStringLiteral("mdate"));
+  other_.m_fieldValues.remove(QStringLiteral("cdate"));
+  other_.m_fieldValues.remove(QStringLiteral("mdate"));
+  m_formattedFields.swap(other_.m_formattedFields);
+  // the parsed values would include the creation and modified dates, just start over
+  m_numberValues.clear();
+  m_dateValues.clear();
+  other_.m_numberValues.clear();
+  other_.m_dateValues.clear();
+}
+
+void Entry::invalidateTypedFieldValue(const QString& name_) {
+  if(!m_numberValues.isEmpty()) {
+    m_numberValues.remove(name_);
+  }
+  if(!m_dateValues.isEmpty()) {
+    m_dateValues.remove(name_);
+  }
+}
@@ -30,6 +30,7 @@
 
 #include <QStringList>
 #include <QHash>
+#include <QDate>
 
 namespace Tellico {
 
@@ -105,6 +106,32 @@ public:
    */
   bool setField(const QString& fieldName, const QString& value, bool updateMDate=true);
   bool setField(Data::FieldPtr field, const QString& value, bool updateMDate=true);
+  /**
+   * Sets the value of a field when loading the entry. The field must belong to the entry's
+   * collection, so it is not looked up by name, and the modified date is never updated.
+   *
+   * @param field The field
+   * @param value The value of the field
+   * @return A boolean indicating whether or not the field was successfully set
+   */
+  bool loadField(Data::FieldPtr field, const QString& value);
+  /**
+   * Returns the value of the field as a number. The value is parsed once and kept
+   * until the field value changes.
+   *
+   * @param field The field
+   * @param ok Set to false if the value is empty or not a number
+   * @return The numeric value of the field
+   */
+  double numberField(Data::FieldPtr field, bool* ok = nullptr) const;
+  /**
+   * Returns the value of the field as a date, in the internal year-month-day format.
+   * The value is parsed once and kept until the field value changes.
+   *
+   * @param field The field
+   * @return The date value of the field, which is invalid if the value is not a date
+   */
+  QDate dateField(Data::FieldPtr field) const;
   /**
    * Returns a pointer to the parent collection of the entry.
    *
@@ -139,6 +166,14 @@ public:
    * @return a bool indicating if the group was successfully removed
    */
   bool removeFromGroup(EntryGroup* group);
+  /**
+   * Removes a group from the entry's list of groups, without updating the group itself.
+   * The collection uses this when removing many entries from a group at once.
+   *
+   * @param group The group
+   * @return a bool indicating if the entry belonged to the group
+   */
+  bool leaveGroup(EntryGroup* group);
   void clearGroups();
   /**
    * Returns a list of the groups to which the entry belongs
@@ -180,6 +215,14 @@ public:
    * @param name The name of the field that changed. an empty string means invalidate all fields.
    */
   void invalidateFormattedFieldValue(const QString& name=QString());
+  /**
+   * Swaps the field values with another entry. The id, collection and groups are not changed.
+   * The values are implicitly shared, so this is much cheaper than copying entries
+   * back and forth when undoing and redoing modifications.
+   *
+   * @param other The other entry
+   */
+  void swapValues(Entry& other);
 
 private:
   // not used
@@ -188,11 +231,16 @@ private:
   bool operator==(const Entry& other) const;
 
   bool setFieldImpl(const QString& fieldName, const QString& value);
+  bool setFieldImpl(Data::FieldPtr field, const QString& value);
+  void invalidateTypedFieldValue(const QString& name);
 
   CollPtr m_coll;
   ID m_id;
   QHash<QString, QString> m_fieldValues;
   mutable QHash<QString, QString> m_formattedFields;
+  // parsed values for comparing, a NaN number means the value is not a number
+  mutable QHash<QString, double> m_numberValues;
+  mutable QHash<QString, QDate> m_dateValues;
   QList<EntryGroup*> m_groups;
 };
 
@@ -37,6 +37,7 @@
 #include "gui/drophandler.h"
 #include "utils/cursorsaver.h"
 #include "document.h"
+#include "core/tracer.h"
 #include "tellico_debug.h"
 
 #include <KMessageBox>
@@ -169,6 +170,7 @@ void EntryView::showEntry(Tellico::Data::EntryPtr entry_) {
     clear();
     return;
   }
+  TRACE_ZONE("view", "EntryView::showEntry");
 
   m_textToShow.clear();
   if(!m_handler || !m_handler->isValid()) {
@@ -202,7 +204,11 @@ void EntryView::showEntry(Tellico::Data::EntryPtr entry_) {
     opt |= Export::ExportClean;
   }
   exporter.setOptions(opt);
-  QDomDocument dom = exporter.exportXML();
+  QDomDocument dom;
+  {
+    TRACE_ZONE("view", "exportXML");
+    dom = exporter.exportXML();
+  }
 
 //  myDebug() << dom.toString();
 #if 0
@@ -215,7 +221,11 @@ void EntryView::showEntry(Tellico::Data::EntryPtr entry_) {
   f1.close();
 #endif
 
-  const QString html = m_handler->applyStylesheet(dom.toString());
+  QString html;
+  {
+    TRACE_ZONE("view", "applyStylesheet");
+    html = m_handler->applyStylesheet(dom.toString());
+  }
   // write out image files
   Data::FieldList fields = entry_->collection()->imageFields();
   foreach(Data::FieldPtr field, fields) {
@@ -25,6 +25,7 @@
 #include "exportdialog.h"
 #include "collection.h"
 #include "controller.h"
+#include "core/tracer.h"
 #include "tellico_debug.h"
 
 #include "translators/exporter.h"
@@ -271,6 +272,8 @@ bool ExportDialog::exportURL(const QUrl& url_/*=QUrl()*/) const {
 
   m_exporter->setOptions(opt);
 
+  TraceZone zone("export", m_exporter->metaObject()->className());
+  zone.setArgument(url_.toDisplayString(QUrl::PreferLocalFile));
   return m_exporter->exec();
 }
 
@@ -302,5 +305,7 @@ bool ExportDialog::exportCollection(Data::CollPtr coll_, Data::EntryList entries
   }
   exp->setOptions(options | Export::ExportForce);
 
+  TraceZone zone("export", exp->metaObject()->className());
+  zone.setArgument(url_.toDisplayString(QUrl::PreferLocalFile));
   return exp->exec();
 }
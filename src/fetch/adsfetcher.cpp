@@ -27,6 +27,7 @@
 #include "../entry.h"
 #include "../utils/string_utils.h"
 #include "../utils/guiproxy.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -244,7 +245,7 @@ Tellico::Data::EntryPtr ADSFetcher::fetchEntryHook(uint uid_) {
   obj.insert(QLatin1String("bibcode"), codes);
   const QByteArray payload = QJsonDocument(obj).toJson();
 
-  QPointer<KIO::StoredTransferJob> job = KIO::storedHttpPost(payload, u, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedHttpPost(payload, u, KIO::HideProgressInfo);
   job->addMetaData(QStringLiteral("content-type"), QStringLiteral("Content-Type: application/json"));
   job->addMetaData(QStringLiteral("accept"), QStringLiteral("application/json"));
   job->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("Authorization: Bearer ") + m_apiKey);
@@ -296,7 +297,7 @@ Tellico::Fetch::FetchRequest ADSFetcher::updateRequest(Data::EntryPtr entry_) {
 }
 
 QPointer<KIO::StoredTransferJob> ADSFetcher::getJob(const QUrl& url_) {
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(url_, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(url_, KIO::NoReload, KIO::HideProgressInfo);
   job->addMetaData(QStringLiteral("accept"), QStringLiteral("application/json"));
   job->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("Authorization: Bearer ") + m_apiKey);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
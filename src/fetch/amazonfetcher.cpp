@@ -37,6 +37,7 @@
 #include "../utils/objvalue.h"
 #include "../utils/isbnvalidator.h"
 #include "../gui/combobox.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -292,7 +293,7 @@ void AmazonFetcher::doSearch() {
     u.setScheme(QLatin1String("https"));
     u.setHost(QString::fromUtf8(siteData(m_site).host));
     u.setPath(path);
-    m_job = KIO::storedHttpPost(payload, u, KIO::HideProgressInfo);
+    m_job = NetworkReplay::storedHttpPost(payload, u, KIO::HideProgressInfo);
     QStringList customHeaders;
     QMapIterator<QByteArray, QByteArray> i(request.headers(payload));
     while(i.hasNext()) {
@@ -302,7 +303,7 @@ void AmazonFetcher::doSearch() {
     m_job->addMetaData(QStringLiteral("customHTTPHeader"), customHeaders.join(QLatin1String("\r\n")));
   } else {
     myDebug() << "Reading" << m_testResultsFile;
-    m_job = KIO::storedGet(QUrl::fromLocalFile(m_testResultsFile), KIO::NoReload, KIO::HideProgressInfo);
+    m_job = NetworkReplay::storedGet(QUrl::fromLocalFile(m_testResultsFile), KIO::NoReload, KIO::HideProgressInfo);
   }
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
@@ -33,6 +33,7 @@
 #include "../entry.h"
 #include "../core/netaccess.h"
 #include "../images/imagefactory.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -107,7 +108,7 @@ void ArxivFetcher::doSearch() {
     return;
   }
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &ArxivFetcher::slotComplete);
@@ -30,6 +30,7 @@
 #include "../entry.h"
 #include "../core/netaccess.h"
 #include "../core/filehandler.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -98,7 +99,7 @@ void BibsonomyFetcher::search() {
   q.addQueryItem(QStringLiteral("items"), QString::number(BIBSONOMY_MAX_RESULTS));
   u.setQuery(q);
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &BibsonomyFetcher::slotComplete);
@@ -37,6 +37,7 @@
 #include "../entry.h"
 #include "../fieldformat.h"
 #include "../core/filehandler.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -207,7 +208,7 @@ void ColnectFetcher::search() {
   u.setPath(u.path() + query);
   myLog() << "Reading" << u.toDisplayString();
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   m_job->addMetaData(QLatin1String("SendUserAgent"), QLatin1String("true"));
   m_job->addMetaData(QStringLiteral("UserAgent"),
                      QStringLiteral("Tellico/%1 ( https://tellico-project.org )").arg(QStringLiteral(TELLICO_VERSION)));
@@ -244,7 +245,7 @@ Tellico::Data::EntryPtr ColnectFetcher::fetchEntryHook(uint uid_) {
     u.setPath(u.path() + query);
 //    myLog() << "Reading" << u.toDisplayString();
 
-    QPointer<KIO::StoredTransferJob> job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+    QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
     KJobWidgets::setWindow(job, GUI::Proxy::widget());
     if(!job->exec()) {
       myDebug() << "Colnect item data:" << job->errorString() << u;
@@ -31,6 +31,7 @@
 #include "../core/netaccess.h"
 #include "../images/imagefactory.h"
 #include "../utils/datafileregistry.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -98,7 +99,7 @@ void CrossRefFetcher::search() {
     return;
   }
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &CrossRefFetcher::slotComplete);
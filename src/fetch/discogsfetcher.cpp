@@ -31,6 +31,7 @@
 #include "../utils/objvalue.h"
 #include "../core/filehandler.h"
 #include "../gui/combobox.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -157,7 +158,7 @@ void DiscogsFetcher::continueSearch() {
 
 //  myDebug() << "url: " << u.url();
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   m_job->addMetaData(QLatin1String("SendUserAgent"), QLatin1String("true"));
   m_job->addMetaData(QStringLiteral("UserAgent"),
                      QStringLiteral("Tellico/%1").arg(QStringLiteral(TELLICO_VERSION)));
@@ -32,6 +32,7 @@
 #include "../utils/isbnvalidator.h"
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -149,7 +150,7 @@ void DoubanFetcher::doSearch(const QString& term_) {
   if(!m_testUrl1.isEmpty()) u = m_testUrl1;
 //  myDebug() << "url:" << u.url();
 
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   job->addMetaData(QStringLiteral("referrer"), QStringLiteral("https://douban.com"));
   job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("120"));
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
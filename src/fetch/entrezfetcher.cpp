@@ -31,6 +31,7 @@
 #include "../translators/xslthandler.h"
 #include "../translators/tellicoimporter.h"
 #include "../utils/datafileregistry.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -149,7 +150,7 @@ void EntrezFetcher::search() {
 
   m_step = Step::Search;
 //  myLog() << "search url: " << u.url();
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &EntrezFetcher::slotComplete);
@@ -275,7 +276,7 @@ void EntrezFetcher::doSummary() {
 
   m_step = Step::Summary;
 //  myLog() << "summary url:" << u.url();
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &EntrezFetcher::slotComplete);
@@ -29,6 +29,7 @@
 #include "messagehandler.h"
 #include "../collection.h"
 #include "../utils/tellico_utils.h"
+#include "../core/tracer.h"
 #include "../tellico_debug.h"
 
 #ifdef HAVE_YAZ
@@ -182,6 +183,8 @@ void Manager::startSearch(const QString& source_, Tellico::Fetch::FetchKey key_,
       connect(fetcher.data(), &Fetcher::signalDone,
               this, &Manager::slotFetcherDone);
       myLog() << "Starting search - source:" << source_ << "value:" << value_ << "key:" << key_;
+      // the search is traced until the fetcher is done, however many requests it takes
+      Tracer::self()->asyncBegin("fetch", "search", reinterpret_cast<quintptr>(fetcher.data()), source_);
       fetcher->startSearch(request);
       m_currentFetcherIndex = i;
       break;
@@ -204,6 +207,7 @@ void Manager::continueSearch() {
     connect(fetcher.data(), &Fetcher::signalDone,
             this, &Manager::slotFetcherDone);
     myLog() << "Continuing search - source:" << fetcher->source();
+    Tracer::self()->asyncBegin("fetch", "search", reinterpret_cast<quintptr>(fetcher.data()), fetcher->source());
     fetcher->continueSearch();
   } else {
     Q_EMIT signalDone();
@@ -240,6 +244,7 @@ void Manager::slotResultFound(Tellico::Fetch::FetchResult* result_) {
 void Manager::slotFetcherDone(Tellico::Fetch::Fetcher* fetcher_) {
   Q_ASSERT(fetcher_);
   myLog() << "Search done - source:" << fetcher_->source();
+  Tracer::self()->asyncEnd("fetch", "search", reinterpret_cast<quintptr>(fetcher_));
   fetcher_->disconnect(); // disconnect all signals
   fetcher_->saveConfig();
   --m_count;
@@ -31,6 +31,7 @@
 #include "../core/filehandler.h"
 #include "../images/imagefactory.h"
 #include "../gui/combobox.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -160,7 +161,7 @@ void FilmAffinityFetcher::search() {
   u.setQuery(q);
   myLog() << "Reading" << u.toDisplayString();
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &FilmAffinityFetcher::slotComplete);
 }
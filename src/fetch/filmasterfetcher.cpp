@@ -29,6 +29,7 @@
 #include "../utils/objvalue.h"
 #include "../entry.h"
 #include "../core/filehandler.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -107,7 +108,7 @@ void FilmasterFetcher::search() {
 
 //  myDebug() << "url:" << u;
 
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
   connect(job.data(), &KJob::result, this, &FilmasterFetcher::slotComplete);
 }
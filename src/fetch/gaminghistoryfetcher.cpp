@@ -29,6 +29,7 @@
 #include "../entry.h"
 #include "../core/filehandler.h"
 #include "../images/imagefactory.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -106,7 +107,7 @@ void GamingHistoryFetcher::search() {
   u.setQuery(q);
 //  myDebug() << "url:" << u;
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &GamingHistoryFetcher::slotComplete);
@@ -31,6 +31,7 @@
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
 #include "../core/filehandler.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -149,7 +150,7 @@ void GoogleBookFetcher::doSearch(const QString& term_) {
   u.setQuery(q);
 //  myDebug() << "url:" << u;
 
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
   connect(job.data(), &KJob::result, this, &GoogleBookFetcher::slotComplete);
   m_jobs << job;
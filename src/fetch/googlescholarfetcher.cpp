@@ -28,6 +28,7 @@
 #include "../collections/bibtexcollection.h"
 #include "../entry.h"
 #include "../utils/guiproxy.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -121,7 +122,7 @@ void GoogleScholarFetcher::doSearch() {
     setBibtexCookie();
   }
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &GoogleScholarFetcher::slotComplete);
@@ -29,6 +29,7 @@
 #include "../utils/lccnvalidator.h"
 #include "../utils/guiproxy.h"
 #include "../utils/datafileregistry.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -104,7 +105,7 @@ void HathiTrustFetcher::doSearch() {
 
 //  myDebug() << u;
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &HathiTrustFetcher::slotComplete);
 }
@@ -29,6 +29,7 @@
 #include "../utils/objvalue.h"
 #include "../utils/tellico_utils.h"
 #include "../core/tellico_strings.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -527,7 +528,7 @@ void IGDBFetcher::checkAccessToken() {
 
   QUrl u(QString::fromLatin1(IGDB_TOKEN_URL));
 //  myDebug() << "Downloading IGDN token from" << u.toString();
-  QPointer<KIO::StoredTransferJob> job = KIO::storedHttpPost(QByteArray(), u, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedHttpPost(QByteArray(), u, KIO::HideProgressInfo);
   job->addMetaData(QStringLiteral("accept"), QStringLiteral("application/json"));
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
   if(!job->exec()) {
@@ -590,7 +591,7 @@ QString IGDBFetcher::dataFileName(IgdbDataType dataType_) {
 
 QPointer<KIO::StoredTransferJob> IGDBFetcher::igdbJob(const QUrl& url_, const QString& query_) {
   checkAccessToken();
-  QPointer<KIO::StoredTransferJob> job = KIO::storedHttpPost(query_.toUtf8(), url_, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedHttpPost(query_.toUtf8(), url_, KIO::HideProgressInfo);
   QStringList customHeaders;
   customHeaders += (QStringLiteral("Client-ID: ") + QString::fromLatin1(IGDB_CLIENT_ID));
   customHeaders += (QStringLiteral("Authorization: ") + QLatin1String("Bearer ") + m_accessToken);
@@ -32,6 +32,7 @@
 #include "../utils/guiproxy.h"
 #include "../gui/combobox.h"
 #include "../gui/lineedit.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -137,7 +138,7 @@ void IMDBFetcher::search() {
   payload.insert(QLatin1String("query"), query);
   payload.insert(QLatin1String("variables"), vars);
 
-  m_job = KIO::storedHttpPost(QJsonDocument(payload).toJson(),
+  m_job = NetworkReplay::storedHttpPost(QJsonDocument(payload).toJson(),
                               QUrl(QLatin1String("https://api.graphql.imdb.com")),
                               KIO::HideProgressInfo);
   configureJob(m_job);
@@ -292,7 +293,7 @@ Tellico::Data::EntryPtr IMDBFetcher::readGraphQL(const QString& imdbId_, const Q
   payload.insert(QLatin1String("query"), query);
   payload.insert(QLatin1String("variables"), vars);
 
-  QPointer<KIO::StoredTransferJob> job = KIO::storedHttpPost(QJsonDocument(payload).toJson(),
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedHttpPost(QJsonDocument(payload).toJson(),
                                                              QUrl(QLatin1String("https://api.graphql.imdb.com")),
                                                              KIO::HideProgressInfo);
   configureJob(job);
@@ -27,6 +27,7 @@
 #include "../images/imagefactory.h"
 #include "../utils/guiproxy.h"
 #include "../utils/objvalue.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -179,9 +180,9 @@ void ISBNdbFetcher::doSearch(const QString& term_) {
                        .remove(QLatin1Char(' '));
     postData.prepend(QStringLiteral("isbns="));
 //    myDebug() << "posting" << postData;
-    job = KIO::storedHttpPost(postData.toUtf8(), u, KIO::HideProgressInfo);
+    job = NetworkReplay::storedHttpPost(postData.toUtf8(), u, KIO::HideProgressInfo);
   } else {
-    job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+    job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   }
 
   job->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("Authorization: ") + m_apiKey);
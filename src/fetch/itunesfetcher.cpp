@@ -32,6 +32,7 @@
 #include "../utils/isbnvalidator.h"
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -147,7 +148,7 @@ void ItunesFetcher::search() {
   u.setQuery(q);
 
 //  myDebug() << u;
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &ItunesFetcher::slotComplete);
 }
@@ -289,7 +290,7 @@ Tellico::Data::EntryPtr ItunesFetcher::fetchEntryHook(uint uid_) {
     q.addQueryItem(QStringLiteral("entity"), QLatin1String("song"));
     q.addQueryItem(QStringLiteral("id"), collectionId);
     u.setQuery(q);
-    auto job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+    auto job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
     if(job->exec()) {
 #if 0
       myWarning() << "Remove debug from itunesfetcher.cpp";
@@ -477,7 +478,7 @@ void ItunesFetcher::populateEpisodes(Data::EntryPtr entry_) {
   q.addQueryItem(QStringLiteral("id"), collectionId);
   u.setQuery(q);
 
-  auto job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  auto job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   if(!job->exec()) {
     myDebug() << "Failed download itunes episodes";
     return;
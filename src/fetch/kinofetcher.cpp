@@ -31,6 +31,7 @@
 #include "../images/imagefactory.h"
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -95,7 +96,7 @@ void KinoFetcher::search() {
   u.setQuery(q);
 //  myDebug() << "url:" << u;
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
           this, &KinoFetcher::slotComplete);
@@ -30,6 +30,7 @@
 #include "../images/imagefactory.h"
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -110,7 +111,7 @@ void KinoPoiskFetcher::search() {
   u.setQuery(q);
 //  myDebug() << "url: " << u.url();
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &KinoPoiskFetcher::slotComplete);
   connect(m_job.data(), &KIO::TransferJob::redirection,
@@ -210,7 +211,7 @@ Tellico::Data::EntryPtr KinoPoiskFetcher::fetchEntryHook(uint uid_) {
     return Data::EntryPtr();
   }
 
-  QPointer<KIO::StoredTransferJob> getJob = KIO::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> getJob = NetworkReplay::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
   getJob->addMetaData(QStringLiteral("referrer"), QString::fromLatin1(KINOPOISK_SEARCH_URL));
   KJobWidgets::setWindow(getJob, GUI::Proxy::widget());
   if(!getJob->exec()) {
@@ -284,7 +285,7 @@ Tellico::Data::EntryPtr KinoPoiskFetcher::fetchEntryHook(uint uid_) {
 Tellico::Data::EntryPtr KinoPoiskFetcher::requestEntry(const QString& filmId_) {
   QUrl url(QLatin1String(KINOPOISK_API_FILM_URL) + filmId_);
 
-  QPointer<KIO::StoredTransferJob> getJob = KIO::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> getJob = NetworkReplay::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
   getJob->addMetaData(QStringLiteral("content-type"), QStringLiteral("application/json"));
   getJob->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("X-API-KEY: ") + m_apiKey);
   KJobWidgets::setWindow(getJob, GUI::Proxy::widget());
@@ -347,7 +348,7 @@ Tellico::Data::EntryPtr KinoPoiskFetcher::requestEntry(const QString& filmId_) {
   q.addQueryItem(QStringLiteral("filmId"), filmId_);
   url.setQuery(q);
 
-  getJob = KIO::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
+  getJob = NetworkReplay::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
   getJob->addMetaData(QStringLiteral("content-type"), QStringLiteral("application/json"));
   getJob->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("X-API-KEY: ") + m_apiKey);
   KJobWidgets::setWindow(getJob, GUI::Proxy::widget());
@@ -31,6 +31,7 @@
 #include "../utils/objvalue.h"
 #include "../utils/tellico_utils.h"
 #include "../core/tellico_strings.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -172,7 +173,7 @@ void MobyGamesFetcher::continueSearch() {
 //  myDebug() << u;
 
   markTime();
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &MobyGamesFetcher::slotComplete);
 }
@@ -207,7 +208,7 @@ Tellico::Data::EntryPtr MobyGamesFetcher::fetchEntryHook(uint uid_) {
 //  myDebug() << u;
 
   markTime();
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
   if(!job->exec()) {
     myDebug() << job->errorString() << u;
@@ -287,7 +288,7 @@ Tellico::Data::EntryPtr MobyGamesFetcher::fetchEntryHook(uint uid_) {
 //  myDebug() << u;
 
   markTime();
-  job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
   if(!job->exec()) {
     myDebug() << job->errorString() << u;
@@ -358,7 +359,7 @@ Tellico::Data::EntryPtr MobyGamesFetcher::fetchEntryHook(uint uid_) {
                               entry->field(QStringLiteral("platform-id"))));
     u.setQuery(q);
     markTime();
-    job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+    job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
     KJobWidgets::setWindow(job, GUI::Proxy::widget());
     if(!job->exec()) {
       myDebug() << job->errorString() << u;
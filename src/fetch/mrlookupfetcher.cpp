@@ -27,6 +27,7 @@
 #include "../collections/bibtexcollection.h"
 #include "../utils/guiproxy.h"
 #include "../utils/string_utils.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -94,7 +95,7 @@ void MRLookupFetcher::search() {
   u.setQuery(q);
 
 //  myDebug() << u;
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &MRLookupFetcher::slotComplete);
 }
@@ -34,6 +34,7 @@
 #include "../entry.h"
 #include "../utils/datafileregistry.h"
 #include "../utils/xmlhandler.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -141,7 +142,7 @@ void MusicBrainzFetcher::doSearch() {
 //  myDebug() << "url: " << u.url();
 
   m_requestTimer.start();
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   // see https://musicbrainz.org/doc/XML_Web_Service/Rate_Limiting#Provide_meaningful_User-Agent_strings
   m_job->addMetaData(QLatin1String("SendUserAgent"), QLatin1String("true"));
   m_job->addMetaData(QStringLiteral("UserAgent"),
@@ -279,7 +280,7 @@ Tellico::Data::EntryPtr MusicBrainzFetcher::fetchEntryHook(uint uid_) {
   }
   m_requestTimer.start();
 
-  KIO::StoredTransferJob* dataJob = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  KIO::StoredTransferJob* dataJob = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   dataJob->addMetaData(QLatin1String("SendUserAgent"), QLatin1String("true"));
   dataJob->addMetaData(QStringLiteral("UserAgent"), QStringLiteral("Tellico/%1 ( http://tellico-project.org )")
                                                                 .arg(QStringLiteral(TELLICO_VERSION)));
@@ -30,6 +30,7 @@
 #include "../utils/guiproxy.h"
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -143,7 +144,7 @@ void NumistaFetcher::doSearch() {
   u.setQuery(q);
 //  myDebug() << "url: " << u.url();
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   m_job->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("Numista-API-Key: ") + m_apiKey);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result,
@@ -251,7 +252,7 @@ Tellico::Data::EntryPtr NumistaFetcher::fetchEntryHook(uint uid_) {
   QUrl url(QString::fromLatin1(NUMISTA_API_URL));
   url.setPath(url.path() + QLatin1String("/coins/") + QString::number(m_matches[uid_]));
 //  myDebug() << url.url();
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
   job->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("Numista-API-Key: ") + m_apiKey);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
   if(!job->exec()) {
@@ -28,6 +28,7 @@
 #include "../utils/guiproxy.h"
 #include "../core/filehandler.h"
 #include "../utils/objvalue.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -125,7 +126,7 @@ void OMDBFetcher::continueSearch() {
   u.setQuery(q);
 //  myDebug() << u;
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &OMDBFetcher::slotComplete);
 }
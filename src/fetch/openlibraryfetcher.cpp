@@ -31,6 +31,7 @@
 #include "../utils/objvalue.h"
 #include "../entry.h"
 #include "../core/filehandler.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -153,7 +154,7 @@ void OpenLibraryFetcher::doSearch(const QString& term_) {
   u.setQuery(q);
 //  myDebug() << u;
 
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
   connect(job.data(), &KJob::result, this, &OpenLibraryFetcher::slotComplete);
   m_jobs << job;
@@ -31,6 +31,7 @@
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
 #include "../utils/tellico_utils.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -139,7 +140,7 @@ void TheGamesDBFetcher::search() {
   }
 //  myDebug() << u;
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &TheGamesDBFetcher::slotComplete);
 }
@@ -29,6 +29,7 @@
 #include "../utils/string_utils.h"
 #include "../utils/objvalue.h"
 #include "../core/tellico_strings.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -471,7 +472,7 @@ void TheTVDBFetcher::requestToken() {
   const QByteArray loginPayload = QJsonDocument(obj).toJson();
 
   myLog() << "Requesting access token for API PIN:" << m_apiPin;
-  QPointer<KIO::StoredTransferJob> job = KIO::storedHttpPost(loginPayload, u, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedHttpPost(loginPayload, u, KIO::HideProgressInfo);
   job->addMetaData(QStringLiteral("content-type"), QStringLiteral("Content-Type: application/json"));
   job->addMetaData(QStringLiteral("accept"), QStringLiteral("application/json"));
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
@@ -534,7 +535,7 @@ void TheTVDBFetcher::refreshToken() {
 
 QPointer<KIO::StoredTransferJob> TheTVDBFetcher::getJob(const QUrl& url_, bool checkToken_) {
   if(checkToken_) checkAccessToken();
-  QPointer<KIO::StoredTransferJob> job = KIO::storedGet(url_, KIO::NoReload, KIO::HideProgressInfo);
+  QPointer<KIO::StoredTransferJob> job = NetworkReplay::storedGet(url_, KIO::NoReload, KIO::HideProgressInfo);
   job->addMetaData(QStringLiteral("accept"), QStringLiteral("application/json"));
   job->addMetaData(QStringLiteral("customHTTPHeader"), QStringLiteral("Authorization: Bearer ") + m_accessToken);
   KJobWidgets::setWindow(job, GUI::Proxy::widget());
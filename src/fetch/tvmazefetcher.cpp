@@ -29,6 +29,7 @@
 #include "../utils/guiproxy.h"
 #include "../utils/objvalue.h"
 #include "../core/tellico_strings.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -115,7 +116,7 @@ void TVmazeFetcher::continueSearch() {
       return;
   }
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   connect(m_job.data(), &KJob::result, this, &TVmazeFetcher::slotComplete);
 }
@@ -30,6 +30,8 @@
 #include "../utils/guiproxy.h"
 #include "../utils/xmlhandler.h"
 #include "../utils/datafileregistry.h"
+#include "../core/networkreplay.h"
+#include "../core/tracer.h"
 #include "../tellico_debug.h"
 
 #include <KIO/StoredTransferJob>
@@ -72,7 +74,7 @@ void XMLFetcher::doSearch() {
   }
 //  myDebug() << "url: " << u.url();
 
-  m_job = KIO::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
+  m_job = NetworkReplay::storedGet(u, KIO::NoReload, KIO::HideProgressInfo);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
   m_job->addMetaData(QLatin1String("SendUserAgent"), QLatin1String("true"));
   m_job->addMetaData(QStringLiteral("UserAgent"),
@@ -135,9 +137,16 @@ void XMLFetcher::slotComplete(KJob* ) {
   f.close();
 #endif
 
-  parseData(data);
+  {
+    TRACE_ZONE("fetch", "XMLFetcher::parseData");
+    parseData(data);
+  }
 
-  const QString str = m_xsltHandler->applyStylesheet(XMLHandler::readXMLData(data));
+  QString str;
+  {
+    TRACE_ZONE("fetch", "XMLFetcher::applyStylesheet");
+    str = m_xsltHandler->applyStylesheet(XMLHandler::readXMLData(data));
+  }
 #if 0
   myWarning() << "Remove debug from xmlfetcher.cpp";
   QFile f2(QStringLiteral("/tmp/test-tellico.xml"));
@@ -150,7 +159,11 @@ void XMLFetcher::slotComplete(KJob* ) {
   Import::TellicoImporter imp(str);
   // be quiet when loading images
   imp.setOptions(imp.options() ^ Import::ImportShowImageErrors);
-  Data::CollPtr coll = imp.collection();
+  Data::CollPtr coll;
+  {
+    TRACE_ZONE("fetch", "XMLFetcher::readCollection");
+    coll = imp.collection();
+  }
   if(!coll) {
     myDebug() << "no collection pointer";
     stop();
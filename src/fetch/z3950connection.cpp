@@ -36,6 +36,9 @@
 
 #include <QFile>
 #include <QApplication>
+#include <QMultiHash>
+#include <QMutex>
+#include <QElapsedTimer>
 
 #ifdef HAVE_YAZ
 extern "C" {
@@ -49,6 +52,70 @@ namespace {
   static const size_t Z3950_DEFAULT_MAX_RECORDS = 20;
 
 #ifdef HAVE_YAZ
+  // servers close sessions which are idle too long, so don't try to reuse an old connection
+  static const qint64 Z3950_CONNECTION_IDLE_TIMEOUT = 4 * 60 * 1000; // 4 minutes
+  static const int Z3950_MAX_IDLE_CONNECTIONS = 8;
+
+  struct PooledConnection {
+    ZOOM_options options;
+    ZOOM_connection conn;
+    QElapsedTimer idleTimer;
+  };
+
+  void destroyConnection(const PooledConnection& pooled_) {
+    ZOOM_connection_destroy(pooled_.conn);
+    ZOOM_options_destroy(pooled_.options);
+  }
+
+  // the idle connections, keyed by server, database, and user
+  class ConnectionPool {
+  public:
+    ~ConnectionPool() { clear(); }
+
+    bool take(const QString& key_, PooledConnection& pooled_) {
+      QMutexLocker locker(&m_mutex);
+      auto it = m_connections.find(key_);
+      while(it != m_connections.end() && it.key() == key_) {
+        const PooledConnection pooled = it.value();
+        it = m_connections.erase(it);
+        if(!pooled.idleTimer.hasExpired(Z3950_CONNECTION_IDLE_TIMEOUT)) {
+          pooled_ = pooled;
+          return true;
+        }
+        destroyConnection(pooled);
+      }
+      return false;
+    }
+
+    void put(const QString& key_, PooledConnection pooled_) {
+      QMutexLocker locker(&m_mutex);
+      if(m_connections.size() >= Z3950_MAX_IDLE_CONNECTIONS) {
+        destroyConnection(pooled_);
+        return;
+      }
+      pooled_.idleTimer.start();
+      m_connections.insert(key_, pooled_);
+    }
+
+    int count() const {
+      QMutexLocker locker(&m_mutex);
+      return m_connections.size();
+    }
+
+    void clear() {
+      QMutexLocker locker(&m_mutex);
+      for(const auto& pooled : std::as_const(m_connections)) {
+        destroyConnection(pooled);
+      }
+      m_connections.clear();
+    }
+
+  private:
+    mutable QMutex m_mutex;
+    QMultiHash<QString, PooledConnection> m_connections;
+  };
+  Q_GLOBAL_STATIC(ConnectionPool, s_connectionPool)
+
   class QueryDestroyer {
   public:
     QueryDestroyer(ZOOM_query query_) : query(query_) {}
@@ -84,22 +151,13 @@ using namespace Tellico;
 using Tellico::Fetch::Z3950ResultFound;
 using Tellico::Fetch::Z3950Connection;
 
-Z3950ResultFound::Z3950ResultFound(const QString& s) : QEvent(uid())
-    , m_result(s) {
-  ++Z3950Connection::resultsLeft;
-}
-
-Z3950ResultFound::~Z3950ResultFound() {
-  --Z3950Connection::resultsLeft;
-}
-
 class Z3950Connection::Private {
 public:
 #ifdef HAVE_YAZ
   Private() : conn_opt(nullptr), conn(nullptr) {}
   ~Private() {
-    ZOOM_options_destroy(conn_opt);
     ZOOM_connection_destroy(conn);
+    ZOOM_options_destroy(conn_opt);
   };
 
   ZOOM_options conn_opt;
@@ -109,8 +167,6 @@ public:
 #endif
 };
 
-int Z3950Connection::resultsLeft = 0;
-
 Z3950Connection::Z3950Connection(Fetch::Fetcher* fetcher,
                                  const QString& host,
                                  uint port,
@@ -135,11 +191,25 @@ Z3950Connection::Z3950Connection(Fetch::Fetcher* fetcher,
 }
 
 Z3950Connection::~Z3950Connection() {
-  m_connected = false;
+  releaseConnection(true);
   delete d;
   d = nullptr;
 }
 
+int Z3950Connection::idleConnectionCount() {
+#ifdef HAVE_YAZ
+  return s_connectionPool->count();
+#else
+  return 0;
+#endif
+}
+
+void Z3950Connection::closeIdleConnections() {
+#ifdef HAVE_YAZ
+  s_connectionPool->clear();
+#endif
+}
+
 void Z3950Connection::reset() {
   m_start = 0;
   m_limit = Z3950_DEFAULT_MAX_RECORDS;
@@ -165,13 +235,21 @@ void Z3950Connection::setCharacterSet(const QString& queryCharSet_, const QStrin
 void Z3950Connection::run() {
   m_aborted = false;
   m_hasMore = false;
-  resultsLeft = 0;
 #ifdef HAVE_YAZ
 
+  // makeConnection() already reports any error
   if(!makeConnection()) {
-    done();
     return;
   }
+  // the connection goes back to the pool once the search is done, unless there was an error
+  class Releaser {
+  public:
+    Releaser(Z3950Connection* conn_) : conn(conn_) {}
+    ~Releaser() { conn->releaseConnection(conn->m_connected); }
+  private:
+    Z3950Connection* conn;
+  };
+  Releaser releaser(this);
 
   ZOOM_query query = ZOOM_query_create();
   QueryDestroyer qd(query);
@@ -332,15 +410,25 @@ void Z3950Connection::run() {
   }
 
   const size_t realLimit = qMin(numResults, m_limit);
+  const size_t count = realLimit > m_start ? realLimit - m_start : 0;
+  // grab all the records with a single present request rather than one at a time
+  // the records are owned by the result set
+  QVector<ZOOM_record> records(static_cast<qsizetype>(count), nullptr);
+  if(count > 0 && !m_aborted) {
+    ZOOM_resultset_records(resultSet, records.data(), m_start, count);
+  }
 
+  QStringList results;
+  results.reserve(static_cast<qsizetype>(count));
   bool showError = true;
-  for(size_t i = m_start; i < realLimit && !m_aborted; ++i) {
-//    myLog() << "grabbing index" << i;
-    ZOOM_record rec = ZOOM_resultset_record(resultSet, i);
+  for(size_t i = 0; i < count && !m_aborted; ++i) {
+    ZOOM_record rec = records.at(i);
     if(!rec) {
-      myDebug() << "no record returned for index" << i;
+      myDebug() << "no record returned for index" << m_start + i;
       errcode = ZOOM_connection_error(d->conn, &errmsg, &addinfo);
       if(errcode != 0) {
+        // a connection with an error is closed rather than going back to the pool
+        m_connected = false;
         QString s = i18n("Connection search error %1: %2", errcode, responseToString(errmsg));
         if(!QByteArray(addinfo).isEmpty()) {
           s += QLatin1String(" (") + responseToString(addinfo) + QLatin1Char(')');
@@ -349,6 +437,11 @@ void Z3950Connection::run() {
         if(showError) {
           showError = false;
           m_hasMore = true;
+          // send the records which were already read before the error
+          if(m_fetcher && !results.isEmpty()) {
+            QApplication::postEvent(m_fetcher.data(), new Z3950ResultFound(results));
+            results.clear();
+          }
           done(s, MessageHandler::Error);
         }
       }
@@ -380,10 +473,11 @@ void Z3950Connection::run() {
 #endif
       data = toXML(ZOOM_record_get(rec, "raw", &len), m_responseCharSet);
     }
-    if(m_fetcher) {
-      auto ev = new Z3950ResultFound(data);
-      QApplication::postEvent(m_fetcher.data(), ev);
-    }
+    results += data;
+  }
+  // the events are posted from the same thread, so the results always arrive before the done event
+  if(m_fetcher && !results.isEmpty()) {
+    QApplication::postEvent(m_fetcher.data(), new Z3950ResultFound(results));
   }
 
   m_hasMore = m_limit < numResults;
@@ -401,6 +495,17 @@ bool Z3950Connection::makeConnection() {
   }
 // I don't know what to do except assume database, user, and password are in locale encoding
 #ifdef HAVE_YAZ
+  // the query character set can change during the search, so the key is only computed
+  // once, and the connection goes back in the pool under the same key it was taken with
+  m_connectionKey = connectionKey();
+  PooledConnection pooled;
+  if(s_connectionPool->take(m_connectionKey, pooled)) {
+    d->conn_opt = pooled.options;
+    d->conn = pooled.conn;
+    m_connected = true;
+    return true;
+  }
+
   d->conn_opt = ZOOM_options_create();
   ZOOM_options_set(d->conn_opt, "implementationName", "Tellico");
   QByteArray ba = queryToByteArray(m_dbname);
@@ -418,8 +523,10 @@ bool Z3950Connection::makeConnection() {
   const char* addinfo;
   errcode = ZOOM_connection_error(d->conn, &errmsg, &addinfo);
   if(errcode != 0) {
-    ZOOM_options_destroy(d->conn_opt);
     ZOOM_connection_destroy(d->conn);
+    ZOOM_options_destroy(d->conn_opt);
+    d->conn = nullptr;
+    d->conn_opt = nullptr;
     m_connected = false;
 
     QString s = i18n("Connection error %1: %2", errcode, responseToString(errmsg));
@@ -437,15 +544,42 @@ bool Z3950Connection::makeConnection() {
   return true;
 }
 
+void Z3950Connection::releaseConnection(bool reuse_) {
+#ifdef HAVE_YAZ
+  if(!d || !d->conn) {
+    m_connected = false;
+    return;
+  }
+  if(reuse_ && m_connected && !m_aborted) {
+    PooledConnection pooled;
+    pooled.options = d->conn_opt;
+    pooled.conn = d->conn;
+    s_connectionPool->put(m_connectionKey, pooled);
+  } else {
+    ZOOM_connection_destroy(d->conn);
+    ZOOM_options_destroy(d->conn_opt);
+  }
+  d->conn = nullptr;
+  d->conn_opt = nullptr;
+#else
+  Q_UNUSED(reuse_);
+#endif
+  m_connected = false;
+}
+
+QString Z3950Connection::connectionKey() const {
+  // the database name, user, and password are all set on the connection
+  return QStringLiteral("%1:%2/%3|%4|%5|%6").arg(m_host, QString::number(m_port), m_dbname,
+                                                 m_user, m_password, m_queryCharSet);
+}
+
 void Z3950Connection::done() {
-  checkPendingEvents();
   if(m_fetcher) {
     qApp->postEvent(m_fetcher.data(), new Z3950ConnectionDone(m_hasMore));
   }
 }
 
 void Z3950Connection::done(const QString& msg_, int type_) {
-  checkPendingEvents();
   if(!m_fetcher) {
     return;
   }
@@ -456,13 +590,6 @@ void Z3950Connection::done(const QString& msg_, int type_) {
   }
 }
 
-void Z3950Connection::checkPendingEvents() {
-  // if there's still some pending result events, go ahead and just wait 1 second
-  if(resultsLeft > 0) {
-    sleep(1);
-  }
-}
-
 inline
 QByteArray Z3950Connection::queryToByteArray(const QString& text_) {
   return iconvRun(text_.toUtf8(), QStringLiteral("utf-8"), m_queryCharSet);
@@ -28,22 +28,25 @@
 #include <QThread>
 #include <QEvent>
 #include <QPointer>
+#include <QStringList>
 
 namespace Tellico {
   namespace Fetch {
     class Fetcher;
 
+/**
+ * Holds all the records from a single present request
+ */
 class Z3950ResultFound : public QEvent {
 public:
-  Z3950ResultFound(const QString& s);
-  ~Z3950ResultFound();
-  const QString& result() const { return m_result; }
+  Z3950ResultFound(const QStringList& results) : QEvent(uid()), m_results(results) {}
+  const QStringList& results() const { return m_results; }
 
   static QEvent::Type uid() { return static_cast<QEvent::Type>(QEvent::User + 11111); }
 
 private:
   Q_DISABLE_COPY(Z3950ResultFound)
-  QString m_result;
+  QStringList m_results;
 };
 
 class Z3950ConnectionDone : public QEvent {
@@ -77,6 +80,11 @@ private:
 };
 
 /**
+ * Runs a Z39.50 search in its own thread.
+ *
+ * The ZOOM connections are kept in a shared pool once a search is done, so that the next search
+ * to the same server, by any fetcher, skips the connect and init requests and the authentication.
+ *
  * @author Robby Stephenson
  */
 class Z3950Connection : public QThread {
@@ -97,16 +105,29 @@ public:
 
   void abort() { m_aborted = true; }
 
+  /**
+   * Returns the number of idle connections which are kept open for later searches
+   */
+  static int idleConnectionCount();
+  /**
+   * Closes all of the idle connections
+   */
+  static void closeIdleConnections();
+
 private:
   static QByteArray iconvRun(const QByteArray& text, const QString& fromCharSet, const QString& toCharSet);
   static QString toXML(const QByteArray& marc, const QString& fromCharSet);
 
   bool makeConnection();
+  /**
+   * Returns the connection to the pool, or closes it if it can't be used again
+   */
+  void releaseConnection(bool reuse);
+  QString connectionKey() const;
   void done();
   void done(const QString& message, int type);
   QByteArray queryToByteArray(const QString& text);
   QString responseToString(const QByteArray& text);
-  void checkPendingEvents();
 
   class Private;
   Private* d;
@@ -120,6 +141,7 @@ private:
   QString m_dbname;
   QString m_user;
   QString m_password;
+  QString m_connectionKey;
   QString m_queryCharSet;
   QString m_responseCharSet;
   QString m_syntax;
@@ -128,9 +150,6 @@ private:
   size_t m_start;
   size_t m_limit;
   bool m_hasMore;
-
-  friend class Z3950ResultFound;
-  static int resultsLeft;
 };
 
   } // end namespace
@@ -511,7 +511,9 @@ void Z3950Fetcher::customEvent(QEvent* event_) {
       myWarning() << "result returned after done signal!";
     }
     Z3950ResultFound* e = static_cast<Z3950ResultFound*>(event_);
-    handleResult(e->result());
+    for(const auto& result : e->results()) {
+      handleResult(result);
+    }
   } else if(event_->type() == Z3950ConnectionDone::uid()) {
     Z3950ConnectionDone* e = static_cast<Z3950ConnectionDone*>(event_);
     if(e->messageType() > -1) {
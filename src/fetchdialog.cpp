@@ -77,6 +77,8 @@
 
 namespace {
   static const int FETCH_MIN_WIDTH = 600;
+  // the number of values for each search, when searching for a long list of ISBN or UPC values
+  static const int FETCH_ISBN_BATCH_SIZE = 100;
 
   static const int StringDataType = QEvent::User;
   static const int ImageDataType = QEvent::User+1;
@@ -130,7 +132,9 @@ FetchDialog::FetchDialog(QWidget* parent_)
     : QDialog(parent_)
     , m_timer(new QTimer(this))
     , m_started(false)
+    , m_stopRequested(false)
     , m_resultCount(0)
+    , m_searchValueCount(0)
     , m_treeWasResized(false)
     , m_barcodePreview(nullptr)
     , m_barcodeRecognitionThread(nullptr) {
@@ -381,27 +385,59 @@ void FetchDialog::slotSearchClicked() {
   m_valueLineEdit->selectAll();
   if(m_started) {
     setStatus(i18n("Cancelling the search..."));
+    m_stopRequested = true;
     Fetch::Manager::self()->stop();
   } else {
     const QString value = m_valueLineEdit->text().simplified();
     if(value.isEmpty()) {
       return;
     }
-    m_resultCount = 0;
+    const Fetch::FetchKey key = static_cast<Fetch::FetchKey>(m_keyCombo->currentData().toInt());
+    const bool multipleValues = m_multipleISBN->isChecked() && (key == Fetch::ISBN || key == Fetch::UPC);
+    // a stopped search for multiple values picks up with the values that were not searched yet
+    const bool resume = multipleValues && value == m_oldSearch && !m_pendingValues.isEmpty();
+    if(!resume) {
+      m_resultCount = 0;
+      m_pendingValues.clear();
+      if(multipleValues) {
+        m_pendingValues = FieldFormat::splitValue(value);
+      }
+      m_searchValueCount = m_pendingValues.count();
+    }
     m_oldSearch = value;
     m_started = true;
+    m_stopRequested = false;
     KGuiItem::assign(m_searchButton, KGuiItem(i18n("&Stop"),
                                               QIcon::fromTheme(QStringLiteral("dialog-cancel"))));
     startProgress();
+    // a short list of values is still searched all at once, but a resumed search
+    // only searches the values that are left
+    if(resume || m_pendingValues.count() > FETCH_ISBN_BATCH_SIZE) {
+      searchNextBatch();
+      return;
+    }
+    m_pendingValues.clear();
     setStatus(i18n("Searching..."));
     qApp->processEvents();
     Fetch::Manager::self()->startSearch(m_sourceCombo->currentText(),
-                                        static_cast<Fetch::FetchKey>(m_keyCombo->currentData().toInt()),
+                                        key,
                                         value,
                                         Data::Document::self()->collection()->type());
   }
 }
 
+void FetchDialog::searchNextBatch() {
+  const QStringList values = m_pendingValues.mid(0, FETCH_ISBN_BATCH_SIZE);
+  const int searched = m_searchValueCount - m_pendingValues.count();
+  setStatus(i18n("Searching for values %1 to %2 of %3...",
+                 searched + 1, searched + values.count(), m_searchValueCount));
+  qApp->processEvents();
+  Fetch::Manager::self()->startSearch(m_sourceCombo->currentText(),
+                                      static_cast<Fetch::FetchKey>(m_keyCombo->currentData().toInt()),
+                                      values.join(FieldFormat::delimiterString()),
+                                      Data::Document::self()->collection()->type());
+}
+
 void FetchDialog::slotClearClicked() {
   fetchDone(false);
   m_treeWidget->clear();
@@ -413,6 +449,7 @@ void FetchDialog::slotClearClicked() {
   m_addButton->setEnabled(false);
   m_moreButton->setEnabled(false);
   m_isbnList.clear();
+  m_pendingValues.clear();
   m_statusMessages.clear();
   setStatus(i18n("Ready.")); // because slotFetchDone() writes text
 }
@@ -443,6 +480,20 @@ void FetchDialog::setStatus(const QString& text_) {
 }
 
 void FetchDialog::slotFetchDone() {
+  // the values of the finished batch are only removed once the search is done, so that a
+  // search which is stopped can start again with the same batch
+  if(m_started && !m_pendingValues.isEmpty()) {
+    if(m_stopRequested) {
+      fetchDone(false);
+      return;
+    }
+    m_pendingValues.erase(m_pendingValues.begin(),
+                          m_pendingValues.begin() + qMin(FETCH_ISBN_BATCH_SIZE, m_pendingValues.count()));
+    if(!m_pendingValues.isEmpty()) {
+      searchNextBatch();
+      return;
+    }
+  }
   fetchDone(true);
 }
 
@@ -781,11 +832,7 @@ void FetchDialog::slotEditMultipleISBN() {
         }
       }
     }
-    if(m_isbnList.count() > 100) {
-      Kernel::self()->sorry(i18n("<qt>An ISBN search can contain a maximum of 100 ISBN values. Only the "
-                                 "first 100 values in your list will be used.</qt>"), this);
-      m_isbnList = m_isbnList.mid(0, 100);
-    }
+    // long lists are searched in batches, so there's no limit on the number of values
     m_valueLineEdit->setText(m_isbnList.join(FieldFormat::delimiterString()));
   }
   m_isbnTextEdit = nullptr; // gets auto-deleted
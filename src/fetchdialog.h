@@ -111,6 +111,10 @@ private Q_SLOTS:
 
 private:
   void fetchDone(bool checkISBN);
+  /**
+   * Searches for the next batch of the values left in a multiple value search.
+   */
+  void searchNextBatch();
   void startProgress();
   void stopProgress();
   void setStatus(const QString& text);
@@ -139,9 +143,13 @@ private:
   QPointer<KTextEdit> m_isbnTextEdit;
 
   bool m_started;
+  bool m_stopRequested;
   int m_resultCount;
   QString m_oldSearch;
   QStringList m_isbnList;
+  // the values which are not searched yet, when searching for multiple values in batches
+  QStringList m_pendingValues;
+  int m_searchValueCount;
   QStringList m_statusMessages;
   QHash<int, Data::EntryPtr> m_entries;
   QList<Fetch::FetchResult*> m_results;
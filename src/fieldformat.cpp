@@ -25,8 +25,128 @@
 #include "fieldformat.h"
 #include "config/tellico_config.h"
 
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+
+#include <memory>
+
 using Tellico::FieldFormat;
 
+namespace {
+  // the maximum number of formatted strings to keep for each format type and options
+  static const int FORMAT_CACHE_SIZE = 50000;
+
+  // the word lists from the config are compiled into matchers a single time, rather than
+  // for every string being formatted. The matchers are never changed once they are compiled, so that
+  // any thread can keep using them. FieldFormat::resetCache() throws them away along with the previously
+  // formatted strings, and they get compiled again the next time they are needed
+  class FormatMatchers {
+  public:
+    struct Article {
+      QString article;
+      QString articleSpace;
+      QRegularExpression rx;
+    };
+
+    QList<Article> articles;
+    QStringList articleAposList;
+    // the sets are case-folded, for case-insensitive matching
+    QSet<QString> nameSuffixes;
+    QSet<QString> surnamePrefixTokens;
+    QSet<QString> noCapitalization;
+
+    static std::shared_ptr<const FormatMatchers> self();
+    static bool findFormatted(const QString& value, int type, int options, QString& text, uint& generation);
+    static void insertFormatted(const QString& value, int type, int options, const QString& text, uint generation);
+    static void reset();
+
+  private:
+    FormatMatchers();
+
+    static QSet<QString> foldedSet(const QStringList& list) {
+      QSet<QString> set;
+      set.reserve(list.size());
+      for(const QString& s : list) {
+        set.insert(s.toCaseFolded());
+      }
+      return set;
+    }
+
+    // everything below is guarded by the mutex
+    static QMutex s_mutex;
+    static std::shared_ptr<const FormatMatchers> s_matchers;
+    // indexed by the format type and the options
+    static QHash<QString, QString> s_formatted[5][4];
+    // incremented on every reset, so that a string formatted with the old lists does not get cached
+    static uint s_generation;
+  };
+
+  QMutex FormatMatchers::s_mutex;
+  std::shared_ptr<const FormatMatchers> FormatMatchers::s_matchers;
+  QHash<QString, QString> FormatMatchers::s_formatted[5][4];
+  uint FormatMatchers::s_generation = 0;
+
+  FormatMatchers::FormatMatchers() {
+    foreach(const QString& article, Tellico::Config::articleList()) {
+      Article a;
+      a.article = article;
+      a.articleSpace = article + QLatin1Char(' ');
+      a.rx = QRegularExpression(QLatin1Char('^') + QRegularExpression::escape(article) + QLatin1String("\\s*"),
+                                QRegularExpression::CaseInsensitiveOption);
+      a.rx.optimize();
+      articles << a;
+    }
+    articleAposList = Tellico::Config::articleAposList();
+    nameSuffixes = foldedSet(Tellico::Config::nameSuffixList());
+    surnamePrefixTokens = foldedSet(Tellico::Config::surnamePrefixTokens());
+    noCapitalization = foldedSet(Tellico::Config::noCapitalizationList());
+  }
+
+  std::shared_ptr<const FormatMatchers> FormatMatchers::self() {
+    QMutexLocker locker(&s_mutex);
+    if(!s_matchers) {
+      s_matchers.reset(new FormatMatchers());
+    }
+    return s_matchers;
+  }
+
+  bool FormatMatchers::findFormatted(const QString& value_, int type_, int options_, QString& text_, uint& generation_) {
+    QMutexLocker locker(&s_mutex);
+    generation_ = s_generation;
+    const QHash<QString, QString>& cache = s_formatted[type_][options_];
+    auto it = cache.constFind(value_);
+    if(it == cache.constEnd()) {
+      return false;
+    }
+    text_ = it.value();
+    return true;
+  }
+
+  void FormatMatchers::insertFormatted(const QString& value_, int type_, int options_, const QString& text_, uint generation_) {
+    QMutexLocker locker(&s_mutex);
+    if(generation_ != s_generation) {
+      return;
+    }
+    QHash<QString, QString>& cache = s_formatted[type_][options_];
+    if(cache.size() >= FORMAT_CACHE_SIZE) {
+      cache.clear();
+    }
+    cache.insert(value_, text_);
+  }
+
+  void FormatMatchers::reset() {
+    QMutexLocker locker(&s_mutex);
+    s_matchers.reset();
+    for(auto& typeCache : s_formatted) {
+      for(auto& cache : typeCache) {
+        cache.clear();
+      }
+    }
+    ++s_generation;
+  }
+}
+
 QString FieldFormat::delimiterString() {
   static QString ds(QStringLiteral("; "));
   return ds;
@@ -151,7 +271,16 @@ QString FieldFormat::format(const QString& value_, Type type_, Request request_)
     options |= FormatAuto;
   }
 
+  // dates depend on the current date and unformatted values are returned as-is, so only cache the rest
+  const bool useCache = type_ == FormatTitle || type_ == FormatName ||
+                        (type_ == FormatPlain && options.testFlag(FormatCapitalize));
+  const int cacheOptions = (options & (FormatCapitalize | FormatAuto)).toInt();
+  uint generation = 0;
   QString text;
+  if(useCache && FormatMatchers::findFormatted(value_, type_, cacheOptions, text, generation)) {
+    return text;
+  }
+
   switch(type_) {
     case FormatTitle:
       text = title(value_, options);
@@ -169,6 +298,9 @@ QString FieldFormat::format(const QString& value_, Type type_, Request request_)
       text = value_;
       break;
   }
+  if(useCache) {
+    FormatMatchers::insertFormatted(value_, type_, cacheOptions, text, generation);
+  }
   return text;
 }
 
@@ -195,15 +327,14 @@ QString FieldFormat::title(const QString& title_, Options opt_) {
   if(opt_.testFlag(FormatAuto)) {
     const QString lower = newTitle.toLower();
     // TODO if the title has ",the" at the end, put it at the front
-    foreach(const QString& article, Config::articleList()) {
+    const auto matchers = FormatMatchers::self();
+    for(const auto& article : std::as_const(matchers->articles)) {
       // assume white space is already stripped
       // the articles are already in lower-case
-      if(lower.startsWith(article + QLatin1Char(' '))) {
-        QRegularExpression rx(QLatin1Char('^') + QRegularExpression::escape(article) + QLatin1String("\\s*"),
-                              QRegularExpression::CaseInsensitiveOption);
+      if(lower.startsWith(article.articleSpace)) {
         // can't just use article since it's in lower-case
-        QString titleArticle = newTitle.left(article.length());
-        newTitle = newTitle.remove(rx)
+        QString titleArticle = newTitle.left(article.article.length());
+        newTitle = newTitle.remove(article.rx)
                            .append(QLatin1String(", "))
                            .append(titleArticle);
         break;
@@ -219,6 +350,8 @@ QString FieldFormat::name(const QString& name_, Options opt_) {
   // the ending look-ahead is so that a space is not added at the end
   static const QRegularExpression periodSpace(QLatin1String("\\.\\s*(?=.)"));
 
+  const auto matchers = FormatMatchers::self();
+
   QString name = name_;
   name.replace(periodSpace, QStringLiteral(". "));
   if(opt_.testFlag(FormatCapitalize)) {
@@ -234,7 +367,7 @@ QString FieldFormat::name(const QString& name_, Options opt_) {
 
   // if it contains a comma already and the last word is not a suffix, don't format it
   if(!opt_.testFlag(FormatAuto) ||
-      (name.indexOf(QLatin1Char(',')) > -1 && !Config::nameSuffixList().contains(words.last(), Qt::CaseInsensitive))) {
+      (name.indexOf(QLatin1Char(',')) > -1 && !matchers->nameSuffixes.contains(words.last().toCaseFolded()))) {
     // arbitrarily impose rule that no spaces before a comma and
     // a single space after every comma
     name.replace(commaSplitRegularExpression(), QStringLiteral(", "));
@@ -243,7 +376,7 @@ QString FieldFormat::name(const QString& name_, Options opt_) {
     // but only if there is more than one word
 
     // if the last word is a suffix, it has to be kept with last name
-    if(Config::nameSuffixList().contains(words.last(), Qt::CaseInsensitive)) {
+    if(matchers->nameSuffixes.contains(words.last().toCaseFolded())) {
       words.prepend(words.last().append(QLatin1Char(',')));
       words.removeLast();
     }
@@ -257,7 +390,7 @@ QString FieldFormat::name(const QString& name_, Options opt_) {
     // In a previous version of Tellico, using a prefix such as "van der" (with a space) would work
     // because QStringList::contains did substring matching, but now need to add a function for tokenizing
     // the list with whitespace as well as comma
-    while(Config::surnamePrefixTokens().contains(words.last(), Qt::CaseInsensitive)) {
+    while(matchers->surnamePrefixTokens.contains(words.last().toCaseFolded())) {
       words.prepend(words.last());
       words.removeLast();
     }
@@ -309,6 +442,7 @@ QString FieldFormat::capitalize(QString str_) {
 
   // regexp to split words
   static const QRegularExpression rx(QLatin1String("[-\\s,.;]"));
+  const auto matchers = FormatMatchers::self();
 
   // special case for french words like l'espace
   QRegularExpressionMatch match = rx.match(str_, 1);
@@ -317,7 +451,7 @@ QString FieldFormat::capitalize(QString str_) {
 
   QString word = str_.mid(0, pos);
   // now check to see if words starts with apostrophe list
-  foreach(const QString& aposArticle, Config::articleAposList()) {
+  foreach(const QString& aposArticle, matchers->articleAposList) {
     if(word.startsWith(aposArticle, Qt::CaseInsensitive)) {
       const uint l = aposArticle.length();
       str_.replace(l, 1, str_.at(l).toUpper());
@@ -335,7 +469,7 @@ QString FieldFormat::capitalize(QString str_) {
     word = str_.mid(pos+1, nextPos-pos-1);
     bool aposMatch = false;
     // now check to see if words starts with apostrophe list
-    foreach(const QString& aposArticle, Config::articleAposList()) {
+    foreach(const QString& aposArticle, matchers->articleAposList) {
       if(word.startsWith(aposArticle, Qt::CaseInsensitive)) {
         const uint l = aposArticle.length();
         // if the word is not the end of the string, capitalize the letter after it
@@ -350,8 +484,9 @@ QString FieldFormat::capitalize(QString str_) {
     if(!aposMatch) {
       // check against the noCapitalization list AND the surnamePrefix list
       // does this hold true everywhere other than english?
-      if(!Config::noCapitalizationList().contains(word, Qt::CaseInsensitive) &&
-         !Config::surnamePrefixTokens().contains(word, Qt::CaseInsensitive) &&
+      const QString foldedWord = word.toCaseFolded();
+      if(!matchers->noCapitalization.contains(foldedWord) &&
+         !matchers->surnamePrefixTokens.contains(foldedWord) &&
          nextPos-pos > 1) {
         str_.replace(pos+1, 1, str_.at(pos+1).toUpper());
       }
@@ -362,3 +497,7 @@ QString FieldFormat::capitalize(QString str_) {
   }
   return str_;
 }
+
+void FieldFormat::resetCache() {
+  FormatMatchers::reset();
+}
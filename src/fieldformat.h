@@ -129,6 +129,11 @@ public:
    * @param str String to fix
    */
   static QString capitalize(QString str);
+  /**
+   * Throws away the word lists compiled from the config, along with the previously
+   * formatted values. Has to be called after any of the word lists in the config change.
+   */
+  static void resetCache();
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(FieldFormat::Options)
@@ -24,6 +24,7 @@
 
 #include "filter.h"
 #include "entry.h"
+#include "collection.h"
 #include "utils/string_utils.h"
 #include "images/imageinfo.h"
 #include "images/imagefactory.h"
@@ -32,15 +33,20 @@
 #include <QRegularExpression>
 
 #include <functional>
+#include <algorithm>
 
 using Tellico::Filter;
 using Tellico::FilterRule;
 
-FilterRule::FilterRule() : m_function(FuncEquals) {
+FilterRule::FilterRule() : m_function(FuncEquals), m_patternNumber(0), m_revision(0)
+    , m_compiledCollId(-1), m_compiledFieldsRevision(-1)
+    , m_isImageField(false), m_isFormattedField(false) {
 }
 
 FilterRule::FilterRule(const QString& fieldName_, const QString& pattern_, Function func_)
-    : m_fieldName(fieldName_), m_function(func_), m_pattern(pattern_) {
+    : m_fieldName(fieldName_), m_function(func_), m_pattern(pattern_), m_patternNumber(0), m_revision(0)
+    , m_compiledCollId(-1), m_compiledFieldsRevision(-1)
+    , m_isImageField(false), m_isFormattedField(false) {
   updatePattern();
 }
 
@@ -55,6 +61,10 @@ bool FilterRule::matches(Tellico::Data::EntryPtr entry_) const {
   if(!entry_ || !entry_->collection()) {
     return false;
   }
+  const Data::Collection* coll = entry_->collection().data();
+  if(coll->id() != m_compiledCollId || coll->fieldsRevision() != m_compiledFieldsRevision) {
+    compile(coll);
+  }
   switch (m_function) {
     case FuncEquals:
       return equals(entry_);
@@ -96,16 +106,14 @@ bool FilterRule::equals(Tellico::Data::EntryPtr entry_) const {
         return true;
       }
     }
-  } else if(entry_->collection()->hasField(m_fieldName) &&
-            entry_->collection()->fieldByName(m_fieldName)->type() == Data::Field::Image) {
+  } else if(m_isImageField) {
     // this is just for image size comparison, all other number comparisons are ok
     // falling back to the string comparison after this
     return numberCompare(entry_, std::equal_to<double>());
   } else {
-    return m_pattern.compare(entry_->field(m_fieldName), Qt::CaseInsensitive) == 0 ||
-           (entry_->collection()->hasField(m_fieldName) &&
-            entry_->collection()->fieldByName(m_fieldName)->formatType() != FieldFormat::FormatNone &&
-            m_pattern.compare(entry_->formattedField(m_fieldName, FieldFormat::ForceFormat), Qt::CaseInsensitive) == 0);
+    return m_pattern.compare(entry_->field(m_field), Qt::CaseInsensitive) == 0 ||
+           (m_isFormattedField &&
+            m_pattern.compare(entry_->formattedField(m_field, FieldFormat::ForceFormat), Qt::CaseInsensitive) == 0);
   }
 
   return false;
@@ -136,7 +144,7 @@ bool FilterRule::contains(Tellico::Data::EntryPtr entry_) const {
       }
     }
   } else {
-    const QString value = entry_->field(m_fieldName);
+    const QString value = entry_->field(m_field);
     if(value.contains(m_pattern, Qt::CaseInsensitive)) {
       return true;
     }
@@ -144,9 +152,8 @@ bool FilterRule::contains(Tellico::Data::EntryPtr entry_) const {
     if(value2 != value && value2.contains(m_pattern, Qt::CaseInsensitive)) {
       return true;
     }
-    if(entry_->collection()->hasField(m_fieldName) &&
-       entry_->collection()->fieldByName(m_fieldName)->formatType() != FieldFormat::FormatNone) {
-      const QString fvalue = entry_->formattedField(m_fieldName);
+    if(m_isFormattedField) {
+      const QString fvalue = entry_->formattedField(m_field);
       if(fvalue == value) {
         return false; // if the formatted value is equal to original value, no need to recheck
       }
@@ -165,7 +172,7 @@ bool FilterRule::contains(Tellico::Data::EntryPtr entry_) const {
 
 bool FilterRule::matchesRegExp(Tellico::Data::EntryPtr entry_) const {
   // empty field name means search all
-  const QRegularExpression pattern = m_patternVariant.toRegularExpression();
+  const QRegularExpression& pattern = m_patternRegExp;
   if(m_fieldName.isEmpty()) {
     foreach(const QString& value, entry_->fieldValues()) {
       if(pattern.match(value).hasMatch()) {
@@ -178,10 +185,9 @@ bool FilterRule::matchesRegExp(Tellico::Data::EntryPtr entry_) const {
       }
     }
   } else {
-    return pattern.match(entry_->field(m_fieldName)).hasMatch() ||
-           (entry_->collection()->hasField(m_fieldName) &&
-            entry_->collection()->fieldByName(m_fieldName)->formatType() != FieldFormat::FormatNone &&
-            pattern.match(entry_->formattedField(m_fieldName, FieldFormat::ForceFormat)).hasMatch());
+    return pattern.match(entry_->field(m_field)).hasMatch() ||
+           (m_isFormattedField &&
+            pattern.match(entry_->formattedField(m_field, FieldFormat::ForceFormat)).hasMatch());
   }
 
   return false;
@@ -193,11 +199,9 @@ bool FilterRule::before(Tellico::Data::EntryPtr entry_) const {
   if(m_fieldName.isEmpty()) {
     return false;
   }
-  const QDate pattern = m_patternVariant.toDate();
-//  const QDate value = QDate::fromString(entry_->field(m_fieldName), Qt::ISODate);
-  // Bug 361625: some older versions of Tellico serialized the date with single digit month and day
-  const QDate value = QDate::fromString(entry_->field(m_fieldName), QStringLiteral("yyyy-M-d"));
-  return value.isValid() && value < pattern;
+  // the entry keeps the parsed date, which allows single digit month and day as well, see Bug 361625
+  const QDate value = entry_->dateField(m_field);
+  return value.isValid() && value < m_patternDate;
 }
 
 bool FilterRule::after(Tellico::Data::EntryPtr entry_) const {
@@ -206,11 +210,9 @@ bool FilterRule::after(Tellico::Data::EntryPtr entry_) const {
   if(m_fieldName.isEmpty()) {
     return false;
   }
-  const QDate pattern = m_patternVariant.toDate();
-//  const QDate value = QDate::fromString(entry_->field(m_fieldName), Qt::ISODate);
-  // Bug 361625: some older versions of Tellico serialized the date with single digit month and day
-  const QDate value = QDate::fromString(entry_->field(m_fieldName), QStringLiteral("yyyy-M-d"));
-  return value.isValid() && value > pattern;
+  // the entry keeps the parsed date, which allows single digit month and day as well, see Bug 361625
+  const QDate value = entry_->dateField(m_field);
+  return value.isValid() && value > m_patternDate;
 }
 
 bool FilterRule::lessThan(Tellico::Data::EntryPtr entry_) const {
@@ -235,6 +237,26 @@ void FilterRule::updatePattern() {
     // we don't even use it
     m_patternVariant = QVariant();
   }
+
+  // keep the typed patterns around rather than converting the variant for every entry
+  m_patternRegExp = m_patternVariant.toRegularExpression();
+  if(m_patternRegExp.isValid() && !m_patternRegExp.pattern().isEmpty()) {
+    m_patternRegExp.optimize();
+  }
+  m_patternDate = m_patternVariant.toDate();
+  // the equal compare is assumed to use the pattern string and the variant will be empty
+  m_patternNumber = m_patternVariant.isNull() ? m_pattern.toDouble()
+                                              : m_patternVariant.toDouble();
+  ++m_revision;
+}
+
+void FilterRule::compile(const Data::Collection* coll_) const {
+  Q_ASSERT(coll_);
+  m_compiledCollId = coll_->id();
+  m_compiledFieldsRevision = coll_->fieldsRevision();
+  m_field = m_fieldName.isEmpty() ? Data::FieldPtr() : coll_->fieldByName(m_fieldName);
+  m_isImageField = m_field && m_field->type() == Data::Field::Image;
+  m_isFormattedField = m_field && m_field->formatType() != FieldFormat::FormatNone;
 }
 
 void FilterRule::setFunction(Function func_) {
@@ -242,6 +264,64 @@ void FilterRule::setFunction(Function func_) {
   updatePattern();
 }
 
+void FilterRule::setFieldName(const QString& fieldName_) {
+  m_fieldName = fieldName_;
+  // force the field lookup to be redone
+  m_compiledCollId = -1;
+  ++m_revision;
+}
+
+int FilterRule::cost() const {
+  int cost;
+  switch(m_function) {
+    case FuncBefore:
+    case FuncAfter:
+    case FuncLess:
+    case FuncGreater:
+      cost = 2;
+      break;
+    case FuncEquals:
+    case FuncNotEquals:
+      cost = 3;
+      break;
+    case FuncContains:
+    case FuncNotContains:
+      // includes the accent removal
+      cost = 6;
+      break;
+    case FuncRegExp:
+    case FuncNotRegExp:
+      cost = 10;
+      break;
+    default:
+      cost = 10;
+      break;
+  }
+  // an empty field name means checking every value, formatted or not
+  if(m_fieldName.isEmpty()) {
+    cost *= 20;
+  }
+  return cost;
+}
+
+double FilterRule::selectivity() const {
+  switch(m_function) {
+    case FuncEquals:
+      return 0.05;
+    case FuncNotEquals:
+      return 0.95;
+    case FuncContains:
+    case FuncRegExp:
+      return 0.2;
+    case FuncNotContains:
+    case FuncNotRegExp:
+      return 0.8;
+    default:
+      break;
+  }
+  return 0.5;
+}
+
 QString FilterRule::pattern() const {
   return m_pattern;
 }
@@ -255,23 +335,18 @@ bool FilterRule::numberCompare(Tellico::Data::EntryPtr entry_, Func func) const
   }
 
   bool ok = false;
-  const QString valueString = entry_->field(m_fieldName);
   double value;
-  if(entry_->collection()->hasField(m_fieldName) &&
-     entry_->collection()->fieldByName(m_fieldName)->type() == Data::Field::Image) {
+  if(m_isImageField) {
     ok = true;
-    const Data::ImageInfo info = ImageFactory::imageInfo(valueString);
+    const Data::ImageInfo info = ImageFactory::imageInfo(entry_->field(m_field));
     // image size comparison presumes "fitting inside a box" so
     // consider the pattern value to be the size of the square and compare against biggest dimension
     // an empty empty (null info) should match against 0 size
     value = info.isNull() ? 0 : qMax(info.width(), info.height());
   } else {
-    value = valueString.toDouble(&ok);
+    value = entry_->numberField(m_field, &ok);
   }
-  // the equal compare is assumed to use the pattern string and the variant will be empty
-  // TODO: switch to using the variant for everything
-  return ok && func(value, m_patternVariant.isNull() ? m_pattern.toDouble()
-                                                     : m_patternVariant.toDouble());
+  return ok && func(value, m_patternNumber);
 }
 
 /*******************************************************/
@@ -295,7 +370,7 @@ bool Filter::matches(Tellico::Data::EntryPtr entry_) const {
   }
 
   bool match = false;
-  foreach(const FilterRule* rule, *this) {
+  foreach(const FilterRule* rule, plan()) {
     if(rule->matches(entry_)) {
       match = true;
       if(m_op == Filter::MatchAny) {
@@ -311,6 +386,36 @@ bool Filter::matches(Tellico::Data::EntryPtr entry_) const {
   return match;
 }
 
+// the rules are independent of each other, so the order they get checked in doesn't change
+// the result. Evaluate the rules most likely to short-circuit the match for the least cost first.
+const QList<const Tellico::FilterRule*>& Filter::plan() const {
+  bool valid = m_planSource.count() == count();
+  for(int i = 0; valid && i < count(); ++i) {
+    const FilterRule* rule = at(i);
+    valid = m_planSource.at(i).first == rule && m_planSource.at(i).second == rule->revision();
+  }
+  if(valid) {
+    return m_plan;
+  }
+
+  m_planSource.clear();
+  m_plan.clear();
+  foreach(const FilterRule* rule, static_cast<const QList<FilterRule*>&>(*this)) {
+    m_planSource.append(qMakePair(rule, rule->revision()));
+    m_plan.append(rule);
+  }
+  const bool matchAll = m_op == MatchAll;
+  // for matching all, the rule should fail quickly, for matching any, the rule should pass quickly
+  auto score = [matchAll](const FilterRule* rule) {
+    const double p = matchAll ? 1.0 - rule->selectivity() : rule->selectivity();
+    return rule->cost() / p;
+  };
+  std::stable_sort(m_plan.begin(), m_plan.end(), [score](const FilterRule* r1, const FilterRule* r2) {
+    return score(r1) < score(r2);
+  });
+  return m_plan;
+}
+
 bool Filter::operator==(const Filter& other) const {
   return m_op == other.m_op &&
          m_name == other.m_name &&
@@ -30,6 +30,8 @@
 #include <QList>
 #include <QString>
 #include <QVariant>
+#include <QRegularExpression>
+#include <QDate>
 
 namespace Tellico {
 
@@ -82,7 +84,7 @@ public:
   /**
    * Set field name
    */
-  void setFieldName(const QString& fieldName) { m_fieldName = fieldName; }
+  void setFieldName(const QString& fieldName);
   /**
    * Return pattern
    */
@@ -91,10 +93,24 @@ public:
    * Set pattern
    */
 //  void setPattern(const QString& pattern) { m_pattern = pattern; }
+  /**
+   * Returns the relative cost of checking the rule against a single entry.
+   * @ref Filter uses it to order the rules so the cheapest ones are checked first.
+   */
+  int cost() const;
+  /**
+   * Returns a rough estimate of the fraction of entries that the rule matches.
+   */
+  double selectivity() const;
+  /**
+   * Returns a counter which is incremented whenever the field name or function changes.
+   */
+  uint revision() const { return m_revision; }
 
 private:
   template <typename Func>
   bool numberCompare(Tellico::Data::EntryPtr entry, Func f) const;
+  void compile(const Data::Collection* coll) const;
 
   bool equals(Data::EntryPtr entry) const;
   bool contains(Data::EntryPtr entry) const;
@@ -109,6 +125,17 @@ private:
   Function m_function;
   QString m_pattern;
   QVariant m_patternVariant;
+  QRegularExpression m_patternRegExp;
+  QDate m_patternDate;
+  double m_patternNumber;
+  uint m_revision;
+
+  // the field lookups are resolved once for each collection and field list revision
+  mutable Data::ID m_compiledCollId;
+  mutable int m_compiledFieldsRevision;
+  mutable Data::FieldPtr m_field;
+  mutable bool m_isImageField;
+  mutable bool m_isFormattedField;
 };
 
 /**
@@ -128,7 +155,7 @@ public:
   Filter(const Filter& other);
   ~Filter();
 
-  void setMatch(FilterOp op) { m_op = op; }
+  void setMatch(FilterOp op) { m_op = op; m_planSource.clear(); }
   FilterOp op() const { return m_op; }
   bool matches(Tellico::Data::EntryPtr entry) const;
 
@@ -141,9 +168,15 @@ public:
 
 private:
   Filter& operator=(const Filter& other);
+  const QList<const FilterRule*>& plan() const;
 
   FilterOp m_op;
   QString m_name;
+
+  // the rules in the order in which they get evaluated, along with the rules and
+  // rule revisions the order was computed from, so any changes cause the plan to be rebuilt
+  mutable QList<const FilterRule*> m_plan;
+  mutable QList<QPair<const FilterRule*, uint>> m_planSource;
 };
 
 } // end namespace
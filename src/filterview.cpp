@@ -72,15 +72,15 @@ void FilterView::addCollection(Tellico::Data::CollPtr coll_) {
 }
 
 void FilterView::addEntries(Tellico::Data::EntryList entries_) {
-  invalidate(entries_);
+  sourceModel()->addEntries(entries_);
 }
 
 void FilterView::modifyEntries(Tellico::Data::EntryList entries_) {
-  invalidate(entries_);
+  sourceModel()->modifyEntries(entries_);
 }
 
 void FilterView::removeEntries(Tellico::Data::EntryList entries_) {
-  invalidate(entries_);
+  sourceModel()->removeEntries(entries_);
 }
 
 void FilterView::slotReset() {
@@ -192,22 +192,3 @@ void FilterView::updateHeader() {
     model()->setHeaderData(0, Qt::Horizontal, i18n("Filter (Sort by Count)"));
   }
 }
-
-void FilterView::invalidate(Tellico::Data::EntryList entries_) {
-  const int rows = model()->rowCount();
-  for(int row = 0; row < rows; ++row) {
-    QModelIndex index = sourceModel()->index(row, 0);
-    FilterPtr filter = sourceModel()->filter(index);
-    if(!filter) {
-      continue;
-    }
-    // two cases: if the filter used to match the entry and no longer does, then check the children indexes
-    // if the filter matches now, check the actual match
-    foreach(Data::EntryPtr entry, entries_) {
-      if(sourceModel()->indexContainsEntry(index, entry) || filter->matches(entry)) {
-        sourceModel()->invalidate(index);
-        break;
-      }
-    }
-  }
-}
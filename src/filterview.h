@@ -78,7 +78,6 @@ private Q_SLOTS:
 private:
   void contextMenuEvent(QContextMenuEvent* event) override;
   void updateHeader();
-  void invalidate(Data::EntryList entries);
 
   bool m_notSortedYet;
   Data::CollPtr m_coll;
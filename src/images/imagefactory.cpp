@@ -30,6 +30,7 @@
 #include "../config/tellico_config.h"
 #include "../utils/tellico_utils.h"
 #include "../utils/gradient.h"
+#include "../core/tracer.h"
 #include "../tellico_debug.h"
 
 #include <KColorUtils>
@@ -41,6 +42,13 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QTimer>
+#include <QSet>
+
+namespace {
+  // the most images downloaded at the same time, in total and from a single host
+  static const int IMAGE_MAX_DOWNLOADS = 16;
+  static const int IMAGE_MAX_DOWNLOADS_PER_HOST = 4;
+}
 
 using namespace Tellico;
 using Tellico::ImageFactory;
@@ -65,6 +73,22 @@ public:
   ImageZipArchive imageZipArchive;
   StringSet nullImages;
   QTimer releaseImagesTimer;
+
+  struct ImageRequest {
+    QUrl url;
+    QUrl referrer;
+    bool quiet;
+    bool linkOnly;
+  };
+  // the downloads waiting for a free slot, and every url either waiting or being downloaded
+  QList<ImageRequest> pendingRequests;
+  StringSet requestedUrls;
+  QHash<QString, int> runningJobsPerHost;
+  QSet<KJob*> runningJobs;
+  // the downloads still running for a document which was closed, their images are not kept
+  QSet<KJob*> discardedJobs;
+  // the image id for every url already downloaded, different urls may have the same image
+  QHash<QString, QString> downloadedImageIds;
 };
 
 ImageFactory::ImageFactory() : QObject(), d(new Private()) {
@@ -143,6 +167,12 @@ const Tellico::Data::Image& ImageFactory::addImageImpl(const QUrl& url_, bool qu
     myDebug() << "Returning null image";
     return Data::Image::null;
   }
+  const Data::Image& downloaded = downloadedImage(url_, link_);
+  if(!downloaded.isNull()) {
+    return downloaded;
+  }
+  TraceZone zone("image", "ImageFactory::addImage");
+  zone.setArgument(url_.toDisplayString());
   ImageJob* job = new ImageJob(url_, QString(), quiet_);
   job->setLinkOnly(link_);
   job->setReferrer(refer_);
@@ -164,10 +194,14 @@ const Tellico::Data::Image& ImageFactory::addImageImpl(const QUrl& url_, bool qu
   }
 
   myLog() << "Loading image from url:" << img.id() << url_.toDisplayString(QUrl::PreferLocalFile);
+  if(!link_) {
+    d->downloadedImageIds.insert(url_.url(), img.id());
+  }
   // hold the image in memory since it probably isn't written locally to disk yet
   if(!d->imageDict.contains(img.id())) {
     d->imageDict.insert(img.id(), new Data::Image(img));
     s_imageInfoMap.insert(img.id(), Data::ImageInfo(img));
+    TRACE_COUNTER("image", "images in memory", d->imageDict.count());
   }
   return img;
 }
@@ -532,11 +566,54 @@ void ImageFactory::requestImageById(const QString& id_) {
 }
 
 void ImageFactory::requestImageByUrlImpl(const QUrl& url_, bool quiet_, const QUrl& refer_, bool link_) {
-  auto job = new ImageJob(url_, QString() /* id, use calculated one */, quiet_);
-  job->setLinkOnly(link_);
-  job->setReferrer(refer_);
-  connect(job, &ImageJob::result,
-          this, &ImageFactory::slotImageJobResult);
+  // the same url is only downloaded once, even if it's requested again before it's done
+  if(d->requestedUrls.has(url_.url())) {
+    return;
+  }
+  const Data::Image& downloaded = downloadedImage(url_, link_);
+  if(!downloaded.isNull()) {
+    const QString id = downloaded.id();
+    QTimer::singleShot(0, this, [this, id] () {
+      Q_EMIT imageAvailable(id);
+    });
+    return;
+  }
+  d->requestedUrls.add(url_.url());
+  d->pendingRequests.append(Private::ImageRequest{url_, refer_, quiet_, link_});
+  startImageJobs();
+}
+
+void ImageFactory::startImageJobs() {
+  auto it = d->pendingRequests.begin();
+  while(it != d->pendingRequests.end() && d->runningJobs.size() < IMAGE_MAX_DOWNLOADS) {
+    // KIO keeps the connections to each host alive, so a few jobs per host are enough
+    const QString host = it->url.host();
+    if(d->runningJobsPerHost.value(host) >= IMAGE_MAX_DOWNLOADS_PER_HOST) {
+      ++it;
+      continue;
+    }
+    auto job = new ImageJob(it->url, QString() /* id, use calculated one */, it->quiet);
+    job->setLinkOnly(it->linkOnly);
+    job->setReferrer(it->referrer);
+    connect(job, &ImageJob::result,
+            this, &ImageFactory::slotImageJobResult);
+    d->runningJobs.insert(job);
+    ++d->runningJobsPerHost[host];
+    it = d->pendingRequests.erase(it);
+  }
+}
+
+const Tellico::Data::Image& ImageFactory::downloadedImage(const QUrl& url_, bool link_) const {
+  // link only images use the url as the id
+  const QString id = link_ ? url_.url() : d->downloadedImageIds.value(url_.url());
+  if(id.isEmpty()) {
+    return Data::Image::null;
+  }
+  const Data::Image* img = d->imageCache.object(id);
+  if(!img) {
+    img = d->imageDict.value(id);
+  }
+  return img ? *img : Data::Image::null;
 }
 
 Tellico::Data::ImageInfo ImageFactory::imageInfo(const QString& id_) {
@@ -607,6 +684,12 @@ void ImageFactory::clean(bool purgeTempDirectory_) {
   s_imageInfoMap.clear();
   factory->d->imageCache.clear();
   factory->d->pixmapCache.clear();
+  factory->d->downloadedImageIds.clear();
+  // nothing waiting to be downloaded is needed any more, and the downloads already running
+  // are left to finish without keeping their images
+  factory->d->pendingRequests.clear();
+  factory->d->requestedUrls.clear();
+  factory->d->discardedJobs.unite(factory->d->runningJobs);
   if(purgeTempDirectory_) {
     myLog() << "Purging images from the temporary directory";
     factory->d->tempImageDir.purge();
@@ -693,6 +776,10 @@ bool ImageFactory::hasNullImage(const QString& id_) const {
   return d->nullImages.contains(id_);
 }
 
+int ImageFactory::runningDownloadCount(const QString& host_) const {
+  return host_.isEmpty() ? d->runningJobs.size() : d->runningJobsPerHost.value(host_);
+}
+
 // the purpose here is to remove images from the dict if they're is on the disk somewhere,
 // either in tempDir() or in dataDir(). The use for this is for calling pixmap() on an
 // image too big to stay in the cache. Then it stays in the dict forever.
@@ -762,6 +849,22 @@ void ImageFactory::slotImageJobResult(KJob* job_) {
     myWarning() << "No image job";
     return;
   }
+  const QString host = imageJob->url().host();
+  d->runningJobs.remove(job_);
+  if(--d->runningJobsPerHost[host] <= 0) {
+    d->runningJobsPerHost.remove(host);
+  }
+  // the url of a discarded download might already be requested again for the new document
+  const bool discarded = d->discardedJobs.remove(job_);
+  if(!discarded) {
+    d->requestedUrls.remove(imageJob->url().url());
+  }
+  // start the next download before handling this one
+  startImageJobs();
+  if(discarded) {
+    return;
+  }
+
   const Data::Image& img = imageJob->image();
   if(img.isNull()) {
     myDebug() << "null image for" << imageJob->url();
@@ -774,6 +877,10 @@ void ImageFactory::slotImageJobResult(KJob* job_) {
   if(!d->imageDict.contains(img.id())) {
     d->imageDict.insert(img.id(), new Data::Image(img));
     s_imageInfoMap.insert(img.id(), Data::ImageInfo(img));
+    TRACE_COUNTER("image", "images in memory", d->imageDict.count());
+  }
+  if(!imageJob->linkOnly()) {
+    d->downloadedImageIds.insert(imageJob->url().url(), img.id());
   }
   Q_EMIT factory->imageAvailable(img.id());
 }
@@ -136,6 +136,8 @@ public:
   bool hasImageInMemory(const QString& id) const;
   // just used for testing
   bool hasNullImage(const QString& id) const;
+  // just used for testing, the downloads from a host or from every host if it's empty
+  int runningDownloadCount(const QString& host = QString()) const;
   /**
    * Requests an image to be made available. Images already in the cache or available locally are
    * considered to be instantly available. Otherwise, the id is assumed to be a URL and is downloaded
@@ -190,8 +192,17 @@ private:
    */
   const Data::Image& addImageImpl(const QUrl& url, bool quiet=false,
                                   const QUrl& referrer = QUrl(), bool linkOnly = false);
+  /**
+   * Queues an image download. Only a few images are downloaded at the same time from each host,
+   * and a url which is already queued or was already downloaded is not downloaded again.
+   */
   void requestImageByUrlImpl(const QUrl& url, bool quiet=false,
                              const QUrl& referrer = QUrl(), bool linkOnly = false);
+  void startImageJobs();
+  /**
+   * Returns the image already downloaded from a url, if it's still in memory.
+   */
+  const Data::Image& downloadedImage(const QUrl& url, bool linkOnly) const;
   /**
    * Add an image, reading it from a regular QImage, which is the case when dragging and dropping
    * an image in the @ref ImageWidget. The format has to be included, since the QImage doesn't
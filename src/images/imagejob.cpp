@@ -25,6 +25,8 @@
 #include <config.h>
 #include "imagejob.h"
 #include "../utils/guiproxy.h"
+#include "../core/networkreplay.h"
+#include "../core/tracer.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -34,9 +36,20 @@
 #include <QFileInfo>
 #include <QBuffer>
 #include <QImageReader>
+#include <QThreadPool>
+#include <QPromise>
+#include <QFutureWatcher>
+
+#include <memory>
 
 namespace {
   static const int IMAGEJOB_TIMEOUT = 5; // seconds
+
+  // the downloaded images are decoded in the background, shared by all the jobs
+  QThreadPool* decodePool() {
+    static QThreadPool pool;
+    return &pool;
+  }
 }
 
 using Tellico::ImageJob;
@@ -68,6 +81,13 @@ void ImageJob::setReferrer(const QUrl& referrer_) {
 }
 
 void ImageJob::slotStart() {
+  if(Tracer::isEnabled()) {
+    // the job result might be emitted before returning, so connect first
+    Tracer::self()->asyncBegin("image", "ImageJob", reinterpret_cast<quintptr>(this), m_url.toDisplayString());
+    connect(this, &KJob::finished, this, [this]() {
+      Tracer::self()->asyncEnd("image", "ImageJob", reinterpret_cast<quintptr>(this));
+    });
+  }
   if(!m_url.isValid()) {
     setError(KIO::ERR_MALFORMED_URL);
     emitResult();
@@ -95,7 +115,7 @@ void ImageJob::slotStart() {
     }
     // non-local valid url
     // KIO::storedGet seems to handle Content-Encoding: gzip ok
-    KIO::StoredTransferJob* getJob = KIO::storedGet(m_url, KIO::NoReload, flags);
+    KIO::StoredTransferJob* getJob = NetworkReplay::storedGet(m_url, KIO::NoReload, flags);
     QObject::connect(getJob, &KJob::result, this, &ImageJob::getJobResult);
     getJob->addMetaData(QLatin1String("SendUserAgent"), QLatin1String("true"));
     getJob->addMetaData(QStringLiteral("UserAgent"),
@@ -112,45 +132,71 @@ void ImageJob::slotStart() {
 }
 
 void ImageJob::getJobResult(KJob* job_) {
-  const auto errorText = i18n("Tellico is unable to load the image - %1.", m_url.toDisplayString());
   KIO::StoredTransferJob* getJob = qobject_cast<KIO::StoredTransferJob*>(job_);
   if(!getJob || getJob->error()) {
     // error handling for subjob is handled by KCompositeJob
-    setErrorText(errorText);
+    setErrorText(i18n("Tellico is unable to load the image - %1.", m_url.toDisplayString()));
     emitResult();
     return;
   }
 
-  // If we used the Image() c'tor that take a bytearray of data, I'm not sure how to
-  // figure out the image format directly. Instead, write into a buffer and use QImageReader
-  QByteArray data = getJob->data();
-  QBuffer buffer(&data);
-  buffer.open(QIODevice::ReadOnly);
-  const auto format = QString::fromLatin1(QImageReader::imageFormat(&buffer));
-  m_image = Data::Image(data, format, m_id);
+  // decoding a large image takes a while, so it's done in the thread pool and the result
+  // is only emitted back in this thread. The watcher is deleted with the job, so nothing
+  // is emitted if the job is killed in the meantime. Only the QImage is read in the pool,
+  // the Data::Image is created here since the image ids use the shared string store
+  auto decoded = std::make_shared<QPair<QImage, QByteArray>>();
+  auto promise = std::make_shared<QPromise<void>>();
+  auto watcher = new QFutureWatcher<void>(this);
+  connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, decoded]() {
+    watcher->deleteLater();
+    imageDecoded(decoded->first, decoded->second);
+  });
+  watcher->setFuture(promise->future());
+
+  const QByteArray data = getJob->data();
+  decodePool()->start([promise, decoded, data]() {
+    promise->start();
+    *decoded = decodeImage(data);
+    promise->finish();
+  });
+}
+
+void ImageJob::imageDecoded(const QImage& image_, const QByteArray& format_) {
+  if(!image_.isNull()) {
+    // if we can't write the input format, then change to one we can
+    // the id is calculated with the output format, since the format is included in the id
+    m_image = Data::Image(image_, QString::fromLatin1(Data::Image::outputFormat(format_)));
+    if(!m_id.isEmpty()) {
+      m_image.setID(m_id);
+    }
+  }
   if(m_image.isNull()) {
-    setErrorText(errorText);
+    setErrorText(i18n("Tellico is unable to load the image - %1.", m_url.toDisplayString()));
     setError(KIO::ERR_UNKNOWN);
     m_image = Data::Image::null;
-  } else {
-    // if we can't write the input format, then change to one we can
-    const auto outputFormat = Data::Image::outputFormat(m_image.format());
-    if(m_image.format() != outputFormat) {
-      m_image.setFormat(outputFormat);
-      // recalculate m_id if necessary, since the format is included in the id
-      if(m_id.isEmpty()) {
-        m_image.calculateID();
-      }
-    }
-    if(m_linkOnly) {
-      m_image.setLinkOnly(true);
-      m_image.setID(m_url.url());
-    }
+  } else if(m_linkOnly) {
+    m_image.setLinkOnly(true);
+    m_image.setID(m_url.url());
   }
   emitResult();
 }
 
+// static
+QPair<QImage, QByteArray> ImageJob::decodeImage(const QByteArray& data_) {
+  // If we used the Image() c'tor that take a bytearray of data, I'm not sure how to
+  // figure out the image format directly. Instead, write into a buffer and use QImageReader
+  QByteArray data = data_;
+  QBuffer buffer(&data);
+  buffer.open(QIODevice::ReadOnly);
+  const QByteArray format = QImageReader::imageFormat(&buffer);
+  return qMakePair(QImage::fromData(data), format);
+}
+
 void ImageJob::getJobTimeout() {
+  // the download is done, the image is still being decoded
+  if(!hasSubjobs()) {
+    return;
+  }
   setError(KIO::ERR_SERVER_TIMEOUT);
   for(auto job : subjobs()) {
     job->kill(KIO::Job::EmitResult);
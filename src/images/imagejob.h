@@ -29,6 +29,8 @@
 
 #include "image.h"
 
+#include <QPair>
+
 namespace Tellico {
 
 /**
@@ -55,6 +57,9 @@ private Q_SLOTS:
   void getJobTimeout();
 
 private:
+  void imageDecoded(const QImage& image, const QByteArray& format);
+  static QPair<QImage, QByteArray> decodeImage(const QByteArray& data);
+
   QUrl m_url;
   QString m_id;
   bool m_linkOnly;
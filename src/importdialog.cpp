@@ -29,6 +29,7 @@
 #include "collection.h"
 #include "progressmanager.h"
 #include "utils/guiproxy.h"
+#include "core/tracer.h"
 
 #include "translators/importer.h"
 #include "translators/tellicoimporter.h"
@@ -102,6 +103,10 @@ ImportDialog::ImportDialog(Tellico::Import::Format format_, const QList<QUrl>& u
                                   "current collection. This is only possible when the "
                                   "collection types match. Entries must match exactly "
                                   "in order to be merged."));
+  m_radioUpdate = new QRadioButton(i18n("&Update current collection"), groupBox);
+  m_radioUpdate->setWhatsThis(i18n("Update the current collection from the same files which were "
+                                   "imported before. Only new or modified files are read again, and "
+                                   "the entries for files which no longer exist are selected."));
   if(m_importer->canImport(Data::Document::self()->collection()->type())) {
     // append by default?
     m_radioAppend->setChecked(true);
@@ -109,16 +114,21 @@ ImportDialog::ImportDialog(Tellico::Import::Format format_, const QList<QUrl>& u
     m_radioReplace->setChecked(true);
     m_radioAppend->setEnabled(false);
     m_radioMerge->setEnabled(false);
+    m_radioUpdate->setEnabled(false);
   }
+  // only show the update option for the importers which support it
+  m_radioUpdate->setVisible(m_importer->canUpdate());
 
   vlay->addWidget(m_radioReplace);
   vlay->addWidget(m_radioAppend);
   vlay->addWidget(m_radioMerge);
+  vlay->addWidget(m_radioUpdate);
 
   m_buttonGroup = new QButtonGroup(widget);
   m_buttonGroup->addButton(m_radioReplace, Import::Replace);
   m_buttonGroup->addButton(m_radioAppend, Import::Append);
   m_buttonGroup->addButton(m_radioMerge, Import::Merge);
+  m_buttonGroup->addButton(m_radioUpdate, Import::Update);
 
   QWidget* w = m_importer->widget(widget);
 //  m_importer->readOptions(KSharedConfig::openConfig());
@@ -164,6 +174,8 @@ Tellico::Data::CollPtr ImportDialog::collection() {
             ProgressManager::self(), &ProgressManager::setProgress);
     connect(&item, &ProgressItem::signalCancelled, m_importer, &Import::Importer::slotCancel);
     ProgressItem::Done done(m_importer);
+    // the class name identifies the importer in the trace
+    TRACE_ZONE("import", m_importer->metaObject()->className());
     m_coll = m_importer->collection();
   }
   return m_coll;
@@ -178,11 +190,18 @@ Tellico::Import::Action ImportDialog::action() const {
     return Import::Replace;
   } else if(m_radioAppend->isChecked()) {
     return Import::Append;
+  } else if(m_radioUpdate->isChecked()) {
+    return Import::Update;
   } else {
     return Import::Merge;
   }
 }
 
+const Tellico::Import::UpdateResult& ImportDialog::updateResult() const {
+  Q_ASSERT(m_importer);
+  return m_importer->updateResult();
+}
+
 // static
 Tellico::Import::Importer* ImportDialog::importer(Tellico::Import::Format format_, const QList<QUrl>& urls_) {
 #define CHECK_SIZE if(urls_.size() > 1) myWarning() << "only importing first URL"
@@ -486,11 +505,18 @@ void ImportDialog::slotUpdateAction() {
 }
 
 // static
-Tellico::Data::CollPtr ImportDialog::importURL(Tellico::Import::Format format_, const QUrl& url_) {
+Tellico::Data::CollPtr ImportDialog::importURL(Tellico::Import::Format format_, const QUrl& url_, Tellico::Import::UpdateResult* update_) {
   QScopedPointer<Import::Importer> imp(importer(format_, QList<QUrl>() << url_));
   if(!imp) {
     return Data::CollPtr();
   }
+  if(update_) {
+    if(!imp->canUpdate()) {
+      GUI::Proxy::sorry(i18n("The current collection can not be updated from this file."));
+      return Data::CollPtr();
+    }
+    imp->slotActionChanged(Import::Update);
+  }
 
   Data::CollPtr c;
   {
@@ -503,11 +529,16 @@ Tellico::Data::CollPtr ImportDialog::importURL(Tellico::Import::Format format_,
     connect(&item, &ProgressItem::signalCancelled, imp.data(), &Import::Importer::slotCancel);
     ProgressItem::Done done(imp.data());
 
+    TraceZone zone("import", imp->metaObject()->className());
+    zone.setArgument(url_.toDisplayString(QUrl::PreferLocalFile));
     c = imp->collection();
   }
   if(!c && !imp->statusMessage().isEmpty()) {
     GUI::Proxy::sorry(imp->statusMessage());
   }
+  if(update_) {
+    *update_ = imp->updateResult();
+  }
   return c;
 }
 
@@ -527,7 +558,11 @@ Tellico::Data::CollPtr ImportDialog::importText(Tellico::Import::Format format_,
   connect(&item, &ProgressItem::signalCancelled, imp, &Import::Importer::slotCancel);
   ProgressItem::Done done(imp);
 
-  Data::CollPtr c = imp->collection();
+  Data::CollPtr c;
+  {
+    TRACE_ZONE("import", imp->metaObject()->className());
+    c = imp->collection();
+  }
   if(!c && !imp->statusMessage().isEmpty()) {
     GUI::Proxy::sorry(imp->statusMessage());
   }
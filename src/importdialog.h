@@ -40,6 +40,7 @@ class QButtonGroup;
 namespace Tellico {
   namespace Import {
     class Importer;
+    struct UpdateResult;
   }
 
 /**
@@ -55,13 +56,18 @@ public:
   Data::CollPtr collection();
   QString statusMessage() const;
   Import::Action action() const;
+  const Import::UpdateResult& updateResult() const;
 
   static QString fileFilter(Import::Format format);
   static Import::Target importTarget(Import::Format format);
   static QString startDir(Import::Format format);
 
   static Import::Importer* importer(Import::Format format, const QList<QUrl>& urls);
-  static Data::CollPtr importURL(Import::Format format, const QUrl& url);
+  /**
+   * Imports a url without showing the dialog. If the update result is not null, the importer
+   * updates the current collection instead, and fails if it can not.
+   */
+  static Data::CollPtr importURL(Import::Format format, const QUrl& url, Import::UpdateResult* update = nullptr);
   static Data::CollPtr importText(Import::Format format, const QString& text);
 
 private Q_SLOTS:
@@ -76,6 +82,7 @@ private:
   QRadioButton* m_radioAppend;
   QRadioButton* m_radioReplace;
   QRadioButton* m_radioMerge;
+  QRadioButton* m_radioUpdate;
   QButtonGroup* m_buttonGroup;
 };
 
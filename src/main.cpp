@@ -26,6 +26,7 @@
 
 #include "mainwindow.h"
 #include "core/logger.h"
+#include "core/tracer.h"
 #include "translators/translators.h" // needed for file type enum
 #include "tellico_debug.h"
 
@@ -43,6 +44,7 @@
 #include <QCommandLineOption>
 #include <QStandardPaths>
 #include <QDir>
+#include <QFileInfo>
 
 int main(int argc, char* argv[]) {
   /**
@@ -115,6 +117,7 @@ int main(int argc, char* argv[]) {
   parser.addOption(QCommandLineOption(QStringList() << QStringLiteral("pdf"), i18n("Import <filename> as a PDF file")));
   parser.addOption(QCommandLineOption(QStringList() << QStringLiteral("log"), i18n("Log diagnostic output")));
   parser.addOption(QCommandLineOption(QStringList() << QStringLiteral("logfile"), i18n("Write log output to <filename>"), QStringLiteral("logfile")));
+  parser.addOption(QCommandLineOption(QStringList() << QStringLiteral("trace"), i18n("Write a performance trace to <filename>"), QStringLiteral("tracefile")));
   parser.addPositionalArgument(QStringLiteral("[filename]"), i18n("File to open"));
 
   aboutData.setupCommandLine(&parser);
@@ -137,11 +140,23 @@ int main(int argc, char* argv[]) {
     logFile = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/tellico_log.txt");
   }
   if(!logFile.isEmpty()) {
+    // structured output is easier for other tools to read
+    if(qEnvironmentVariable("TELLICO_LOG_FORMAT").compare(QLatin1String("json"), Qt::CaseInsensitive) == 0) {
+      Tellico::Logger::self()->setFormat(Tellico::Logger::JsonLines);
+    }
     Tellico::Logger::self()->setLogFile(logFile);
     myLog() << "Starting Tellico" << QStringLiteral(TELLICO_VERSION) << "at" << QDateTime::currentDateTime().toString(Qt::ISODate);
     myLog() << "Opening log file" << logFile;
   }
 
+  QString traceFile = qEnvironmentVariable("TELLICO_TRACEFILE");
+  if(parser.isSet(QStringLiteral("trace"))) {
+    traceFile = parser.value(QStringLiteral("trace"));
+  }
+  if(!traceFile.isEmpty()) {
+    Tellico::Tracer::self()->start(QFileInfo(traceFile).absoluteFilePath());
+  }
+
   if(app.isSessionRestored()) {
     myLog() << "Restoring previous session";
     kRestoreMainWindows<Tellico::MainWindow>();
@@ -190,5 +205,8 @@ int main(int argc, char* argv[]) {
     }
   }
 
-  return app.exec();
+  const int ret = app.exec();
+  // the trace is only written when tracing stops
+  Tellico::Tracer::self()->stop();
+  return ret;
 }
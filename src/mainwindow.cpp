@@ -40,6 +40,7 @@
 #include "collectionfieldsdialog.h"
 #include "controller.h"
 #include "importdialog.h"
+#include "translators/importer.h"
 #include "exportdialog.h"
 #include "printhandler.h"
 #include "entryview.h"
@@ -2100,8 +2101,9 @@ bool MainWindow::importFile(Tellico::Import::Format format_, const QUrl& url_, T
 
   bool failed = false;
   Data::CollPtr coll;
+  Import::UpdateResult update;
   if(!url_.isEmpty() && url_.isValid() && NetAccess::exists(url_, true, this)) {
-    coll = ImportDialog::importURL(format_, url_);
+    coll = ImportDialog::importURL(format_, url_, action_ == Import::Update ? &update : nullptr);
   } else {
     Kernel::self()->sorry(TC_I18N2(errorLoad, url_.fileName()));
     failed = true;
@@ -2127,7 +2129,8 @@ bool MainWindow::importFile(Tellico::Import::Format format_, const QUrl& url_, T
       Controller::self()->slotCollectionAdded(Data::Document::self()->collection());
       m_initialized = true;
     }
-    failed = !importCollection(coll, action_);
+    failed = action_ == Import::Update ? !updateCollection(coll, update)
+                                       : !importCollection(coll, action_);
   }
 
   StatusBar::self()->clearStatus();
@@ -2374,7 +2377,11 @@ void MainWindow::importFile(Tellico::Import::Format format_, const QList<QUrl>&
       }
       return;
     }
-    importCollection(coll, dlg.action());
+    if(dlg.action() == Import::Update) {
+      updateCollection(coll, dlg.updateResult());
+    } else {
+      importCollection(coll, dlg.action());
+    }
   }
 }
 
@@ -2392,6 +2399,7 @@ bool MainWindow::importCollection(Tellico::Data::CollPtr coll_, Tellico::Import:
   bool failed = false;
   switch(action_) {
     case Import::Append:
+    case Import::Update: // without any changes to existing entries, an update is the same as appending
       {
         // only append if match, but special case importing books into bibliographies
         Data::CollPtr c = Data::Document::self()->collection();
@@ -2434,6 +2442,25 @@ bool MainWindow::importCollection(Tellico::Data::CollPtr coll_, Tellico::Import:
   return !failed;
 }
 
+bool MainWindow::updateCollection(Tellico::Data::CollPtr coll_, const Tellico::Import::UpdateResult& update_) {
+  if(Data::Document::self()->collection()->type() != coll_->type()) {
+    Kernel::self()->sorry(TC_I18N1(errorAppendType));
+    return false;
+  }
+  Kernel::self()->updateCollection(coll_, update_.modifiedEntries);
+  slotEnableModifiedActions(true);
+  m_detailedView->slotRefreshImages();
+
+  // the entries are not removed, since the files might only be unavailable for now
+  if(!update_.missingEntries.isEmpty()) {
+    Controller::self()->slotUpdateSelection(update_.missingEntries);
+    slotStatusMsg(i18np("One entry refers to a file which no longer exists.",
+                        "%1 entries refer to files which no longer exist.",
+                        update_.missingEntries.count()));
+  }
+  return true;
+}
+
 void MainWindow::slotURLAction(const QUrl& url_) {
   Q_ASSERT(url_.scheme() == QLatin1String("tc"));
   const QString actionName = url_.fileName();
@@ -55,6 +55,9 @@ namespace Tellico {
     class TabWidget;
     class DockWidget;
   }
+  namespace Import {
+    struct UpdateResult;
+  }
   class Controller;
   class ViewStack;
   class DetailedListView;
@@ -466,6 +469,7 @@ private:
   void importFile(Import::Format format, const QList<QUrl>& kurls);
   void importText(Import::Format format, const QString& text);
   bool importCollection(Data::CollPtr coll, Import::Action action);
+  bool updateCollection(Data::CollPtr coll, const Import::UpdateResult& update);
 
   // the reason that I have to keep pointers to all these
   // is because they get plugged into menus later in Controller
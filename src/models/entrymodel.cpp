@@ -32,6 +32,8 @@
 #include "../images/imagefactory.h"
 #include "../tellico_debug.h"
 
+#include <QSet>
+
 namespace {
   static const int ENTRYMODEL_IMAGE_HEIGHT = 64;
   // number of entries in a list considered to be "small" in that
@@ -314,23 +316,25 @@ void EntryModel::removeEntries(const Tellico::Data::EntryList& entries_) {
   // iterating over all of them, which really hurts, just signal a full replacement
   const bool bigRemoval = (entries_.size() > SMALL_OPERATION_ENTRY_SIZE);
   if(bigRemoval) {
+    // and remove them all in one pass through the list
+    QSet<const Data::Entry*> removed;
+    removed.reserve(entries_.count());
+    foreach(Data::EntryPtr entry, entries_) {
+      removed.insert(entry.data());
+    }
     beginResetModel();
+    m_entries.removeIf([&removed](const Data::EntryPtr& e) { return removed.contains(e.data()); });
+    endResetModel();
+    return;
   }
   foreach(Data::EntryPtr entry, entries_) {
     int idx = m_entries.indexOf(entry);
     if(idx > -1) {
-      if(!bigRemoval) {
-        beginRemoveRows(QModelIndex(), idx, idx);
-      }
+      beginRemoveRows(QModelIndex(), idx, idx);
       m_entries.removeAt(idx);
-      if(!bigRemoval) {
-        endRemoveRows();
-      }
+      endRemoveRows();
     }
   }
-  if(bigRemoval) {
-    endResetModel();
-  }
 }
 
 void EntryModel::setFields(const Tellico::Data::FieldList& fields_) {
@@ -33,6 +33,7 @@
 
 #include <KLocalizedString>
 #include <QIcon>
+#include <QSet>
 
 using namespace Tellico;
 using Tellico::FilterModel;
@@ -51,13 +52,24 @@ public:
   void setID(Data::ID id_) { m_id = id_; }
   int childCount() const { return m_children.count(); }
 
-  void addChild(Node* child) {  m_children.append(child); }
-  void removeChild(int i) {  delete m_children.takeAt(i); }
-  void removeAll() { qDeleteAll(m_children); m_children.clear(); }
+  void addChild(Node* child) {  m_children.append(child); m_childIds.insert(child->id()); }
+  void removeChild(int i) {  Node* child = m_children.takeAt(i); m_childIds.remove(child->id()); delete child; }
+  void removeChildren(int first, int count) {
+    for(int i = first; i < first + count; ++i) {
+      m_childIds.remove(m_children.at(i)->id());
+      delete m_children.at(i);
+    }
+    m_children.remove(first, count);
+  }
+  void removeAll() { qDeleteAll(m_children); m_children.clear(); m_childIds.clear(); }
+  // only meaningful for filter nodes, where the children are entries
+  bool hasChildId(Data::ID id_) const { return m_childIds.contains(id_); }
 
 private:
   Node* m_parent;
   QList<Node*> m_children;
+  // the set of entry ids for a filter node, kept in step with the children
+  QSet<Data::ID> m_childIds;
   Data::ID m_id;
 };
 
@@ -288,14 +300,91 @@ bool FilterModel::indexContainsEntry(const QModelIndex& parent_, Data::EntryPtr
   if(!parentNode) {
     return false;
   }
-  for(int i = 0; i < parentNode->childCount(); ++i) {
-    Node* childNode = parentNode->child(i);
-    Q_ASSERT(childNode);
-    if(childNode && childNode->id() == entry_->id()) {
-      return true;
+  return parentNode->hasChildId(entry_->id());
+}
+
+void FilterModel::addEntries(const Tellico::Data::EntryList& entries_) {
+  updateFilterNodes(entries_, false /* not removed */);
+}
+
+void FilterModel::modifyEntries(const Tellico::Data::EntryList& entries_) {
+  updateFilterNodes(entries_, false /* not removed */);
+}
+
+void FilterModel::removeEntries(const Tellico::Data::EntryList& entries_) {
+  updateFilterNodes(entries_, true /* removed */);
+}
+
+// rather than matching every entry in the collection again, only the changed entries are
+// checked against each filter and the child rows are inserted or removed as needed
+void FilterModel::updateFilterNodes(const Tellico::Data::EntryList& entries_, bool removed_) {
+  if(entries_.isEmpty()) {
+    return;
+  }
+  for(int row = 0; row < m_filters.count(); ++row) {
+    Node* filterNode = m_rootNode->child(row);
+    Q_ASSERT(filterNode);
+    // a filter node which has not been populated yet will be once it is needed
+    if(!filterNode || filterNode->id() == -1) {
+      continue;
+    }
+    FilterPtr filter = m_filters.at(row);
+    QSet<Data::ID> removedIds, modifiedIds;
+    Data::EntryList addedEntries;
+    foreach(Data::EntryPtr entry, entries_) {
+      const bool wasMatch = filterNode->hasChildId(entry->id());
+      const bool isMatch = !removed_ && filter->matches(entry);
+      if(wasMatch && !isMatch) {
+        removedIds.insert(entry->id());
+      } else if(!wasMatch && isMatch) {
+        addedEntries.append(entry);
+      } else if(wasMatch) {
+        modifiedIds.insert(entry->id());
+      }
+    }
+    if(removedIds.isEmpty() && addedEntries.isEmpty() && modifiedIds.isEmpty()) {
+      continue;
+    }
+
+    const QModelIndex filterIndex = index(row, 0);
+    if(!removedIds.isEmpty() || !modifiedIds.isEmpty()) {
+      // iterate backwards so the row numbers stay valid while removing, and handle
+      // each contiguous range of rows together rather than one row at a time
+      int i = filterNode->childCount() - 1;
+      while(i >= 0) {
+        const Data::ID id = filterNode->child(i)->id();
+        if(removedIds.contains(id)) {
+          int first = i;
+          while(first > 0 && removedIds.contains(filterNode->child(first - 1)->id())) {
+            --first;
+          }
+          beginRemoveRows(filterIndex, first, i);
+          filterNode->removeChildren(first, i - first + 1);
+          endRemoveRows();
+          i = first - 1;
+        } else if(modifiedIds.contains(id)) {
+          int first = i;
+          while(first > 0 && modifiedIds.contains(filterNode->child(first - 1)->id())) {
+            --first;
+          }
+          Q_EMIT dataChanged(index(first, 0, filterIndex), index(i, 0, filterIndex));
+          i = first - 1;
+        } else {
+          --i;
+        }
+      }
+    }
+    if(!addedEntries.isEmpty()) {
+      const int first = filterNode->childCount();
+      beginInsertRows(filterIndex, first, first + addedEntries.count() - 1);
+      foreach(Data::EntryPtr entry, addedEntries) {
+        filterNode->addChild(new Node(filterNode, entry->id()));
+      }
+      endInsertRows();
     }
+    // the entry count may have changed
+    Q_EMIT dataChanged(filterIndex, filterIndex);
   }
-  return false;
 }
 
 void FilterModel::populateFilterNode(Node* node_, const FilterPtr filter_) const {
@@ -59,9 +59,17 @@ public:
   void invalidate(const QModelIndex& index);
   bool indexContainsEntry(const QModelIndex& parent, Data::EntryPtr entry) const;
 
+  /**
+   * Updates the matched entries of every populated filter, checking only the changed entries.
+   */
+  void addEntries(const Data::EntryList& entries);
+  void modifyEntries(const Data::EntryList& entries);
+  void removeEntries(const Data::EntryList& entries);
+
 private:
   class Node;
   void populateFilterNode(Node* node, const FilterPtr filter) const;
+  void updateFilterNodes(const Data::EntryList& entries, bool removed);
 
   FilterList m_filters;
   QString m_header;
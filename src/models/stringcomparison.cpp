@@ -31,6 +31,9 @@
 using namespace Tellico;
 
 namespace {
+  // the maximum number of parsed values to keep for a comparison
+  static const int PARSED_CACHE_SIZE = 100000;
+
   int compareFloat(const QString& s1, const QString& s2) {
     bool ok1, ok2;
     float n1 = s1.toFloat(&ok1);
@@ -100,38 +103,51 @@ Tellico::NumberComparison::NumberComparison() : StringComparison() {
 }
 
 int Tellico::NumberComparison::compare(const QString& str1_, const QString& str2_) {
-  bool ok1, ok2;
-  float num1 = 0, num2 = 0;
-
-  const QStringList values1 = FieldFormat::splitValue(str1_);
-  const QStringList values2 = FieldFormat::splitValue(str2_);
-  int index = 0;
-  do {
-    if((ok1 = index < values1.count())) {
-      num1 = values1.at(index).toFloat(&ok1);
-    }
-    if((ok2 = index < values2.count())) {
-      num2 = values2.at(index).toFloat(&ok2);
+  const QVector<float> nums1 = numbers(str1_);
+  const QVector<float> nums2 = numbers(str2_);
+  const int count = qMin(nums1.count(), nums2.count());
+  for(int index = 0; index < count; ++index) {
+    const float num1 = nums1.at(index);
+    const float num2 = nums2.at(index);
+    if(!qFuzzyCompare(num1, num2)) {
+      const float ret = num1 - num2;
+      // if abs(ret) < 0.5, we want to round up/down to -1 or 1
+      // so that comparing 0.2 to 0.4 yields 1, for example, and not 0
+      return ret < 0 ? qMin(-1, qRound(ret)) : qMax(1, qRound(ret));
     }
-    if(ok1 && ok2) {
-      if(!qFuzzyCompare(num1, num2)) {
-        const float ret = num1 - num2;
-        // if abs(ret) < 0.5, we want to round up/down to -1 or 1
-        // so that comparing 0.2 to 0.4 yields 1, for example, and not 0
-        return ret < 0 ? qMin(-1, qRound(ret)) : qMax(1, qRound(ret));
-      }
-    }
-    ++index;
-  } while(ok1 && ok2);
+  }
 
-  if(ok1 && !ok2) {
+  // the first value that is not a number ends the comparison
+  if(nums1.count() > count) {
     return 1;
-  } else if(!ok1 && ok2) {
+  } else if(nums2.count() > count) {
     return -1;
   }
   return 0;
 }
 
+// returns the leading values which are numbers, stopping at the first one that is not
+QVector<float> Tellico::NumberComparison::numbers(const QString& str_) {
+  auto it = m_numbers.constFind(str_);
+  if(it != m_numbers.constEnd()) {
+    return it.value();
+  }
+  QVector<float> nums;
+  foreach(const QString& value, FieldFormat::splitValue(str_)) {
+    bool ok;
+    const float num = value.toFloat(&ok);
+    if(!ok) {
+      break;
+    }
+    nums << num;
+  }
+  if(m_numbers.size() >= PARSED_CACHE_SIZE) {
+    m_numbers.clear();
+  }
+  m_numbers.insert(str_, nums);
+  return nums;
+}
+
 // for details on the LCC comparison, see
 // http://www.mcgees.org/2001/08/08/sort-by-library-of-congress-call-number-in-perl/
 // http://library.dts.edu/Pages/RM/Helps/lc_call.shtml
@@ -204,45 +220,43 @@ int Tellico::ISODateComparison::compare(const QString& str1, const QString& str2
   if(str2.isEmpty()) { // str1 is not
     return 1;
   }
+  const QDate date1 = date(str1);
+  const QDate date2 = date(str2);
+  if(date1 < date2) {
+    return -1;
+  } else if(date1 > date2) {
+    return 1;
+  }
+  return 0;
+}
+
+QDate Tellico::ISODateComparison::date(const QString& str_) {
+  auto it = m_dates.constFind(str_);
+  if(it != m_dates.constEnd()) {
+    return it.value();
+  }
   // modelled after Field::formatDate()
   // so dates would sort as expected without padding month and day with zero
   // and accounting for "current year - 1 - 1" default scheme
   const QDate now = QDate::currentDate();
-  QStringList dlist1 = str1.split(QLatin1Char('-'), Qt::KeepEmptyParts);
+  QStringList dlist = str_.split(QLatin1Char('-'), Qt::KeepEmptyParts);
   bool ok = true;
-  int y1 = dlist1.count() > 0 ? dlist1[0].toInt(&ok) : now.year();
-  if(!ok) {
-    y1 = now.year();
-  }
-  int m1 = dlist1.count() > 1 ? dlist1[1].toInt(&ok) : 1;
-  if(!ok) {
-    m1 = 1;
-  }
-  int d1 = dlist1.count() > 2 ? dlist1[2].toInt(&ok) : 1;
-  if(!ok) {
-    d1 = 1;
-  }
-  QDate date1(y1, m1, d1);
-
-  QStringList dlist2 = str2.split(QLatin1Char('-'), Qt::KeepEmptyParts);
-  int y2 = dlist2.count() > 0 ? dlist2[0].toInt(&ok) : now.year();
+  int y = dlist.count() > 0 ? dlist[0].toInt(&ok) : now.year();
   if(!ok) {
-    y2 = now.year();
+    y = now.year();
   }
-  int m2 = dlist2.count() > 1 ? dlist2[1].toInt(&ok) : 1;
+  int m = dlist.count() > 1 ? dlist[1].toInt(&ok) : 1;
   if(!ok) {
-    m2 = 1;
+    m = 1;
   }
-  int d2 = dlist2.count() > 2 ? dlist2[2].toInt(&ok) : 1;
+  int d = dlist.count() > 2 ? dlist[2].toInt(&ok) : 1;
   if(!ok) {
-    d2 = 1;
+    d = 1;
   }
-  QDate date2(y2, m2, d2);
-
-  if(date1 < date2) {
-    return -1;
-  } else if(date1 > date2) {
-    return 1;
+  const QDate date(y, m, d);
+  if(m_dates.size() >= PARSED_CACHE_SIZE) {
+    m_dates.clear();
   }
-  return 0;
+  m_dates.insert(str_, date);
+  return date;
 }
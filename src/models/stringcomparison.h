@@ -26,6 +26,9 @@
 #define TELLICO_STRINGCOMPARISON_H
 
 #include <QRegularExpression>
+#include <QHash>
+#include <QVector>
+#include <QDate>
 
 #include "../datavectors.h"
 
@@ -59,6 +62,11 @@ class NumberComparison : public StringComparison {
 public:
   NumberComparison();
   virtual int compare(const QString& str1, const QString& str2) override;
+
+private:
+  QVector<float> numbers(const QString& str);
+  // sorting compares each value many times, so keep the parsed numbers
+  QHash<QString, QVector<float>> m_numbers;
 };
 
 class LCCComparison : public StringComparison {
@@ -75,6 +83,11 @@ class ISODateComparison : public StringComparison {
 public:
   ISODateComparison();
   virtual int compare(const QString& str1, const QString& str2) override;
+
+private:
+  QDate date(const QString& str);
+  // sorting compares each value many times, so keep the parsed dates
+  QHash<QString, QDate> m_dates;
 };
 
 }
@@ -30,6 +30,7 @@
 #include "controller.h"
 #include "tellico_debug.h"
 #include "gui/combobox.h"
+#include "core/filehandler.h"
 #include "utils/cursorsaver.h"
 #include "utils/datafileregistry.h"
 #include "utils/tellico_utils.h"
@@ -79,7 +80,7 @@ using Tellico::ReportDialog;
 
 // default button is going to be used as a print button, so it's separated
 ReportDialog::ReportDialog(QWidget* parent_)
-    : QDialog(parent_), m_exporter(nullptr), m_tempFile(nullptr) {
+    : QDialog(parent_), m_exporter(nullptr), m_tempFile(nullptr), m_tempFileReport(false) {
   setModal(false);
   setWindowTitle(i18n("Collection Report"));
 
@@ -280,35 +281,24 @@ void ReportDialog::generateAllEntries() {
     return;
   }
 
-  // do some surgery on the HTML since we've got <html> elements in every page
-  static const QRegularExpression bodyRx(QLatin1String("<body[^>]*>"));
-  m_exporter->setEntries(Controller::self()->visibleEntries());
-  QString html = m_exporter->text();
-  auto bodyMatch = bodyRx.match(html);
-  Q_ASSERT(bodyMatch.hasMatch());
-  const QString htmlStart = html.left(bodyMatch.capturedStart() + bodyMatch.capturedLength());
-  const QString htmlEnd = html.mid(html.lastIndexOf(QLatin1String("</body")));
+  // the entry pages go straight into a temporary file, rather than building the whole report in memory
+  delete m_tempFile;
+  m_tempFile = new QTemporaryFile(QDir::tempPath() + QLatin1String("/tellicoreport_XXXXXX") + QLatin1String(".html"));
+  if(!m_tempFile->open()) {
+    myWarning() << "unable to open temporary file for the report";
+    return;
+  }
   const QString htmlBetween = QStringLiteral("<p style=\"page-break-after: always;\">&nbsp;</p>"
                                              "<p style=\"page-break-before: always;\">&nbsp;</p>");
-
-  // estimate how much space in the string to reserve
-  const auto estimatedSize = Controller::self()->visibleEntries().size() * html.size();
-  html = htmlStart;
-  html.reserve(1.1*estimatedSize);
-  foreach(Data::EntryPtr entry, Controller::self()->visibleEntries()) {
-    m_exporter->setEntries(Data::EntryList() << entry);
-    QString fullText = m_exporter->text();
-    // extract the body portion
-    auto bodyMatch = bodyRx.match(fullText);
-    if(bodyMatch.hasMatch()) {
-      const auto bodyEnd = fullText.lastIndexOf(QLatin1String("</body"));
-      const auto bodyLength = bodyEnd - bodyMatch.capturedEnd();
-      html += fullText.mid(bodyMatch.capturedEnd(), bodyLength) + htmlBetween;
-    }
+  m_exporter->setEntries(Controller::self()->visibleEntries());
+  // the temporary file is not in the template directory, so relative paths for CSS and images
+  // have to be resolved from the template file
+  if(!m_exporter->writeEntryPages(m_tempFile, htmlBetween, QUrl::fromLocalFile(m_xsltFile))) {
+    myWarning() << "unable to write the report";
   }
-  html += htmlEnd;
-  m_exporter->setCustomHtml(html);
-  showText(html, QUrl::fromLocalFile(m_xsltFile));
+  m_tempFile->close();
+  m_tempFileReport = true;
+  m_webView->load(QUrl::fromLocalFile(m_tempFile->fileName()));
 }
 
 void ReportDialog::slotRefresh() {
@@ -334,6 +324,7 @@ void ReportDialog::slotRefresh() {
 }
 
 void ReportDialog::showText(const QString& text_, const QUrl& url_) {
+  m_tempFileReport = false;
   // limit is 2 MB after percent encoding, etc., so give some padding
   if(text_.size() > 1200000) {
     delete m_tempFile;
@@ -436,7 +427,10 @@ void ReportDialog::slotSaveAs() {
                    + QLatin1String(";;")
                    + i18n("All Files") + QLatin1String(" (*)");
     QUrl u = QFileDialog::getSaveFileUrl(this, QString(), QUrl(), filter);
-    if(!u.isEmpty() && u.isValid()) {
+    if(!u.isEmpty() && u.isValid() && m_tempFileReport && m_tempFile) {
+      // the report was already written to the temporary file
+      FileHandler::writeDataURL(u, FileHandler::readDataFile(QUrl::fromLocalFile(m_tempFile->fileName())));
+    } else if(!u.isEmpty() && u.isValid()) {
       QUrl oldURL = m_exporter->url();
       m_exporter->setURL(u);
 
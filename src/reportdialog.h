@@ -78,6 +78,8 @@ private:
   Export::HTMLExporter* m_exporter;
   QString m_xsltFile;
   QTemporaryFile* m_tempFile;
+  // true when the report is only in the temporary file
+  bool m_tempFileReport;
 };
 
 } // end namespace
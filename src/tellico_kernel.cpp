@@ -300,6 +300,15 @@ void Kernel::replaceCollection(Tellico::Data::CollPtr coll_) {
                                            coll_));
 }
 
+void Kernel::updateCollection(Tellico::Data::CollPtr coll_, const QList<QPair<Tellico::Data::EntryPtr, Tellico::Data::EntryPtr> >& modifiedEntries_) {
+  beginCommandGroup(i18n("Update Collection"));
+  appendCollection(coll_);
+  for(const auto& entryPair : modifiedEntries_) {
+    updateEntry(entryPair.first, entryPair.second, true /* overwrite */);
+  }
+  endCommandGroup();
+}
+
 void Kernel::renameCollection() {
   bool ok;
   QString newTitle = QInputDialog::getText(m_widget, i18n("Rename Collection"), i18n("New collection name:"),
@@ -29,6 +29,7 @@
 #include "borrower.h"
 
 #include <QStringList>
+#include <QPair>
 
 class QUndoStack;
 class QWidget;
@@ -91,6 +92,11 @@ public:
   void appendCollection(Data::CollPtr coll);
   void mergeCollection(Data::CollPtr coll);
   void replaceCollection(Data::CollPtr coll);
+  /**
+   * Appends the new entries in the collection and updates each of the modified entries
+   * with the values of the entry it is paired with, as a single command.
+   */
+  void updateCollection(Data::CollPtr coll, const QList<QPair<Data::EntryPtr, Data::EntryPtr> >& modifiedEntries);
 
   void renameCollection();
   QUndoStack* commandHistory() { return m_commandHistory; }
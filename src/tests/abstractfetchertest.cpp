@@ -27,6 +27,7 @@
 #include "abstractfetchertest.h"
 
 #include "../fetch/fetcherjob.h"
+#include "../core/networkreplay.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
@@ -44,6 +45,10 @@ AbstractFetcherTest::AbstractFetcherTest() : QObject(), m_loop(this), m_hasNetwo
   QStandardPaths::setTestModeEnabled(true);
   KLocalizedString::setApplicationDomain("tellico");
   QLoggingCategory::setFilterRules(QStringLiteral("tellico.debug = true\ntellico.info = false"));
+  // replaying the recorded responses doesn't need a network
+  if(Tellico::NetworkReplay::mode() == Tellico::NetworkReplay::Replay) {
+    m_hasNetwork = true;
+  }
 }
 
 Tellico::Data::EntryList AbstractFetcherTest::doFetch(Tellico::Fetch::Fetcher::Ptr fetcher,
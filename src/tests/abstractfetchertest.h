@@ -40,6 +40,9 @@ public:
   AbstractFetcherTest();
 
 protected:
+  /**
+   * Recorded responses can be used instead of the network, see NetworkReplay
+   */
   bool hasNetwork() const { return m_hasNetwork; }
   Tellico::Data::EntryList doFetch(Tellico::Fetch::Fetcher::Ptr fetcher,
                                    const Tellico::Fetch::FetchRequest& request,
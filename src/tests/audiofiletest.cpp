@@ -27,6 +27,9 @@
 #include "audiofiletest.h"
 
 #include "../translators/audiofileimporter.h"
+#include "../translators/translators.h"
+#include "../entry.h"
+#include "../collection.h"
 #include "../images/imagefactory.h"
 #include "../images/image.h"
 
@@ -140,3 +143,52 @@ void AudioFileTest::testNonRecursive() {
   QCOMPARE(coll->type(), Tellico::Data::Collection::Album);
   QCOMPARE(coll->entryCount(), 1);
 }
+
+void AudioFileTest::testUpdate() {
+  QUrl url = QUrl::fromLocalFile(QFINDTESTDATA("data/audio/test.mp3"));
+  QVERIFY(!url.isEmpty());
+  const QUrl dirUrl = url.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash);
+  Tellico::Import::AudioFileImporter importer(dirUrl);
+  importer.setOptions(importer.options() ^ Tellico::Import::ImportProgress);
+  importer.setAddFilePath(true);
+  Tellico::Data::CollPtr coll = importer.collection();
+  QVERIFY(coll);
+  QCOMPARE(coll->entryCount(), 1);
+
+  // the mp3 file is now newer than its entry
+  Tellico::Data::EntryPtr mp3Entry = coll->entryById(1);
+  QVERIFY(mp3Entry);
+  mp3Entry->setField(QStringLiteral("mdate"), QStringLiteral("2000-01-01"));
+  Tellico::Data::EntryPtr missingEntry(new Tellico::Data::Entry(coll));
+  missingEntry->setField(QStringLiteral("title"), QStringLiteral("Missing Album"));
+  missingEntry->setField(QStringLiteral("file"), dirUrl.toLocalFile() + QLatin1String("/missing.mp3"));
+  coll->addEntries(missingEntry);
+
+  // the updater does not have the file path option set
+  Tellico::Import::AudioFileImporter updater(dirUrl);
+  updater.setOptions(updater.options() ^ Tellico::Import::ImportProgress);
+  updater.setCurrentCollection(coll);
+  QVERIFY(updater.canUpdate());
+  updater.slotActionChanged(Tellico::Import::Update);
+  Tellico::Data::CollPtr updateColl = updater.collection();
+  QVERIFY(updateColl);
+  // no new files
+  QCOMPARE(updateColl->entryCount(), 0);
+  // but the file locations are still included for the next update
+  QVERIFY(updateColl->hasField(QStringLiteral("file")));
+
+  const Tellico::Import::UpdateResult& result = updater.updateResult();
+  QCOMPARE(result.modifiedEntries.count(), 1);
+  QVERIFY(result.modifiedEntries.at(0).first == mp3Entry);
+  QCOMPARE(result.modifiedEntries.at(0).second->field("title"), QStringLiteral("mp3 album"));
+  QVERIFY(result.modifiedEntries.at(0).second->field("file").contains(QStringLiteral("data/audio/test.mp3")));
+  QCOMPARE(result.missingEntries.count(), 1);
+  QVERIFY(result.missingEntries.at(0) == missingEntry);
+
+  // the update leaves the file path option alone
+  updater.slotActionChanged(Tellico::Import::Append);
+  coll = updater.collection();
+  QVERIFY(coll);
+  QCOMPARE(coll->entryCount(), 1);
+  QVERIFY(!coll->hasField(QStringLiteral("file")));
+}
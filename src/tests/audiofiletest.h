@@ -36,6 +36,7 @@ private Q_SLOTS:
   void testOgg();
   void testMp3();
   void testNonRecursive();
+  void testUpdate();
 };
 
 #endif
@@ -184,3 +184,42 @@ void BibtexTest::testModify() {
   QVERIFY(field);
   QCOMPARE(field->name(), QLatin1String("bibtex-key"));
 }
+
+void BibtexTest::testImportBatches() {
+#ifdef ENABLE_BTPARSE
+  // the importer parses the text in batches of 1000 records, so this spans two of them
+  QString text = QStringLiteral("@string{early = \"Early Macro\"}\n");
+  for(int i = 0; i < 1200; ++i) {
+    if(i == 1000) {
+      // the macro is defined after the first batch and used right away
+      text += QStringLiteral("@string{late = \"Late Macro\"}\n");
+    }
+    text += QStringLiteral("@article{key%1,\n  title = {Title %1},\n  publisher = %2\n}\n")
+              .arg(i).arg(i < 1000 ? QStringLiteral("early") : QStringLiteral("late"));
+  }
+
+  Tellico::Import::BibtexImporter importer(text);
+  Tellico::Data::CollPtr tmpColl(new Tellico::Data::BibtexCollection(true));
+  importer.setCurrentCollection(tmpColl);
+
+  Tellico::Data::CollPtr coll = importer.collection();
+  QVERIFY(coll);
+  QCOMPARE(coll->entryCount(), 1200);
+
+  Tellico::Data::BibtexCollection* bColl = static_cast<Tellico::Data::BibtexCollection*>(coll.data());
+  QCOMPARE(bColl->macroList().value(QStringLiteral("early")), QL1("Early Macro"));
+  QCOMPARE(bColl->macroList().value(QStringLiteral("late")), QL1("Late Macro"));
+
+  Tellico::Data::EntryPtr entry = bColl->entryByBibtexKey(QStringLiteral("key999"));
+  QVERIFY(entry);
+  QCOMPARE(entry->field("title"), QL1("Title 999"));
+  QCOMPARE(entry->field("publisher"), QL1("early"));
+  entry = bColl->entryByBibtexKey(QStringLiteral("key1000"));
+  QVERIFY(entry);
+  QCOMPARE(entry->field("title"), QL1("Title 1000"));
+  QCOMPARE(entry->field("publisher"), QL1("late"));
+  entry = bColl->entryByBibtexKey(QStringLiteral("key1199"));
+  QVERIFY(entry);
+  QCOMPARE(entry->field("publisher"), QL1("late"));
+#endif
+}
@@ -38,6 +38,7 @@ private Q_SLOTS:
   void testMapping();
   void testMaybe();
   void testModify();
+  void testImportBatches();
 };
 
 #endif
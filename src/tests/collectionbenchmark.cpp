@@ -0,0 +1,374 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#undef QT_NO_CAST_FROM_ASCII
+
+#include "collectionbenchmark.h"
+#include "syntheticcollection.h"
+
+#include "../collection.h"
+#include "../collectionfactory.h"
+#include "../collections/collectioninitializer.h"
+#include "../entry.h"
+#include "../field.h"
+#include "../filter.h"
+#include "../document.h"
+#include "../translators/tellicoimporter.h"
+#include "../translators/tellicoxmlexporter.h"
+#include "../translators/tellicozipexporter.h"
+#include "../translators/htmlexporter.h"
+#include "../translators/xslthandler.h"
+#include "../models/fieldcomparison.h"
+#include "../images/imagefactory.h"
+#include "../utils/datafileregistry.h"
+
+#include <KLocalizedString>
+
+#include <QTest>
+#include <QStandardPaths>
+#include <QLoggingCategory>
+#include <QDomDocument>
+
+#include <algorithm>
+
+QTEST_GUILESS_MAIN( CollectionBenchmark )
+
+namespace {
+  // every benchmark uses the same collections
+  static const quint32 BENCHMARK_SEED = 1;
+  // rendering every entry of a large collection would take too long
+  static const int BENCHMARK_RENDER_COUNT = 100;
+}
+
+void CollectionBenchmark::initTestCase() {
+  QStandardPaths::setTestModeEnabled(true);
+  KLocalizedString::setApplicationDomain("tellico");
+  // the benchmarks should not be measuring the logging
+  QLoggingCategory::setFilterRules(QStringLiteral("tellico.debug = false\ntellico.info = false"));
+  Tellico::ImageFactory::init();
+  // need to register the collection types
+  Tellico::CollectionInitializer ci;
+  Tellico::DataFileRegistry::self()->addDataLocation(QFINDTESTDATA("../../xslt/tellico2html.xsl"));
+  Tellico::DataFileRegistry::self()->addDataLocation(QFINDTESTDATA("../../xslt/entry-templates/Fancy.xsl"));
+  QVERIFY(m_tempDir.isValid());
+
+  const QString types = qEnvironmentVariable("TELLICO_BENCHMARK_TYPES");
+  for(int type = Tellico::Data::Collection::Book; type <= Tellico::Data::Collection::BoardGame; ++type) {
+    if(types.isEmpty() || types.split(QLatin1Char(',')).contains(Tellico::CollectionFactory::typeName(type))) {
+      m_types += type;
+    }
+  }
+  QVERIFY2(!m_types.isEmpty(), "TELLICO_BENCHMARK_TYPES has no known collection type");
+
+  const QString counts = qEnvironmentVariable("TELLICO_BENCHMARK_ENTRIES", QStringLiteral("1000"));
+  for(const auto& count : counts.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+    bool ok;
+    const int n = count.trimmed().toInt(&ok);
+    if(ok && n > 0) {
+      m_entryCounts += n;
+    }
+  }
+  QVERIFY2(!m_entryCounts.isEmpty(), "TELLICO_BENCHMARK_ENTRIES has no valid entry count");
+  m_withImages = qEnvironmentVariableIntValue("TELLICO_BENCHMARK_IMAGES") > 0;
+}
+
+void CollectionBenchmark::cleanupTestCase() {
+  m_coll = Tellico::Data::CollPtr();
+  Tellico::ImageFactory::clean(true);
+}
+
+void CollectionBenchmark::populateData() {
+  QTest::addColumn<int>("type");
+  QTest::addColumn<int>("entryCount");
+
+  for(int type : std::as_const(m_types)) {
+    for(int count : std::as_const(m_entryCounts)) {
+      const QString tag = Tellico::CollectionFactory::typeName(type) + QLatin1Char('-') + QString::number(count);
+      QTest::newRow(tag.toLatin1().constData()) << type << count;
+    }
+  }
+}
+
+Tellico::Data::CollPtr CollectionBenchmark::collection() {
+  QFETCH(int, type);
+  QFETCH(int, entryCount);
+  const QString key = QStringLiteral("%1-%2").arg(type).arg(entryCount);
+  if(key != m_collKey) {
+    m_coll = Tellico::Data::CollPtr();
+    m_coll = SyntheticCollection(BENCHMARK_SEED).create(type, entryCount, m_withImages);
+    m_collKey = key;
+  }
+  return m_coll;
+}
+
+QString CollectionBenchmark::writeFile(bool zip_) {
+  Tellico::Data::CollPtr coll = collection();
+  const QString fileName = m_tempDir.filePath(m_collKey + (zip_ ? QStringLiteral(".tc") : QStringLiteral(".xml")));
+  if(QFile::exists(fileName)) {
+    return fileName;
+  }
+  QScopedPointer<Tellico::Export::Exporter> exporter;
+  if(zip_) {
+    auto zipExporter = new Tellico::Export::TellicoZipExporter(coll);
+    zipExporter->setIncludeImages(m_withImages);
+    exporter.reset(zipExporter);
+  } else {
+    exporter.reset(new Tellico::Export::TellicoXMLExporter(coll));
+  }
+  exporter->setEntries(coll->entries());
+  exporter->setURL(QUrl::fromLocalFile(fileName));
+  exporter->setOptions(exporter->options() | Tellico::Export::ExportForce | Tellico::Export::ExportComplete);
+  return exporter->exec() ? fileName : QString();
+}
+
+void CollectionBenchmark::benchmarkCreate_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkCreate() {
+  QFETCH(int, type);
+  QFETCH(int, entryCount);
+
+  QBENCHMARK_ONCE {
+    Tellico::Data::CollPtr coll = SyntheticCollection(BENCHMARK_SEED).create(type, entryCount, m_withImages);
+    QCOMPARE(coll->entryCount(), entryCount);
+  }
+}
+
+void CollectionBenchmark::benchmarkSaveXML_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkSaveXML() {
+  Tellico::Data::CollPtr coll = collection();
+  const QUrl url = QUrl::fromLocalFile(m_tempDir.filePath(QStringLiteral("save.xml")));
+
+  QBENCHMARK {
+    Tellico::Export::TellicoXMLExporter exporter(coll);
+    exporter.setEntries(coll->entries());
+    exporter.setURL(url);
+    exporter.setOptions(exporter.options() | Tellico::Export::ExportForce | Tellico::Export::ExportComplete);
+    QVERIFY(exporter.exec());
+  }
+}
+
+void CollectionBenchmark::benchmarkSaveZip_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkSaveZip() {
+  Tellico::Data::CollPtr coll = collection();
+  const QUrl url = QUrl::fromLocalFile(m_tempDir.filePath(QStringLiteral("save.tc")));
+
+  QBENCHMARK {
+    Tellico::Export::TellicoZipExporter exporter(coll);
+    exporter.setIncludeImages(m_withImages);
+    exporter.setEntries(coll->entries());
+    exporter.setURL(url);
+    exporter.setOptions(exporter.options() | Tellico::Export::ExportForce | Tellico::Export::ExportComplete);
+    QVERIFY(exporter.exec());
+  }
+}
+
+void CollectionBenchmark::benchmarkOpenXML_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkOpenXML() {
+  QFETCH(int, entryCount);
+  const QString fileName = writeFile(false);
+  QVERIFY(!fileName.isEmpty());
+
+  QBENCHMARK {
+    Tellico::Import::TellicoImporter importer(QUrl::fromLocalFile(fileName));
+    Tellico::Data::CollPtr coll = importer.collection();
+    QVERIFY(coll);
+    QCOMPARE(coll->entryCount(), entryCount);
+  }
+}
+
+void CollectionBenchmark::benchmarkOpenZip_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkOpenZip() {
+  QFETCH(int, entryCount);
+  const QString fileName = writeFile(true);
+  QVERIFY(!fileName.isEmpty());
+
+  QBENCHMARK {
+    // load all the images, rather than delaying them
+    Tellico::Import::TellicoImporter importer(QUrl::fromLocalFile(fileName), true);
+    Tellico::Data::CollPtr coll = importer.collection();
+    QVERIFY(coll);
+    QCOMPARE(coll->entryCount(), entryCount);
+  }
+}
+
+void CollectionBenchmark::benchmarkFilter_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkFilter() {
+  Tellico::Data::CollPtr coll = collection();
+  // a common word in the titles, and anyone in one of the people fields
+  const QString word = coll->entries().first()->field(QStringLiteral("title")).section(QLatin1Char(' '), 0, 0);
+  Tellico::FilterPtr filter(new Tellico::Filter(Tellico::Filter::MatchAny));
+  filter->append(new Tellico::FilterRule(QStringLiteral("title"), word, Tellico::FilterRule::FuncContains));
+  if(!coll->peopleFields().isEmpty()) {
+    const QString name = coll->peopleFields().first()->name();
+    filter->append(new Tellico::FilterRule(name, QStringLiteral("an"), Tellico::FilterRule::FuncContains));
+  }
+
+  const Tellico::Data::EntryList entries = coll->entries();
+  int count = 0;
+  QBENCHMARK {
+    count = 0;
+    for(const auto& entry : entries) {
+      if(filter->matches(entry)) {
+        ++count;
+      }
+    }
+  }
+  QVERIFY(count > 0);
+}
+
+void CollectionBenchmark::benchmarkSort_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkSort() {
+  Tellico::Data::CollPtr coll = collection();
+  QScopedPointer<Tellico::FieldComparison> comp(Tellico::FieldComparison::create(coll->fieldByName(QStringLiteral("title"))));
+  QVERIFY(comp);
+
+  QBENCHMARK {
+    Tellico::Data::EntryList entries = coll->entries();
+    std::sort(entries.begin(), entries.end(), [&comp](Tellico::Data::EntryPtr e1, Tellico::Data::EntryPtr e2) {
+      return comp->compare(e1, e2) < 0;
+    });
+  }
+}
+
+void CollectionBenchmark::benchmarkGroup_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkGroup() {
+  Tellico::Data::CollPtr coll = collection();
+  const QString groupField = coll->defaultGroupField();
+  QVERIFY(!groupField.isEmpty());
+
+  QBENCHMARK {
+    coll->invalidateGroups();
+    QVERIFY(coll->entryGroupDictByName(groupField));
+  }
+}
+
+void CollectionBenchmark::benchmarkMerge_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkMerge() {
+  QFETCH(int, type);
+  QFETCH(int, entryCount);
+  // half of the merged entries are already in the collection, half are new
+  Tellico::Data::CollPtr coll1 = SyntheticCollection(BENCHMARK_SEED).create(type, entryCount, m_withImages);
+  Tellico::Data::CollPtr coll2 = SyntheticCollection(BENCHMARK_SEED).create(type, entryCount / 2, m_withImages);
+  coll2->addEntries(SyntheticCollection(BENCHMARK_SEED + 1).createEntries(coll2, entryCount - entryCount / 2, m_withImages));
+
+  // the merge changes the collection, so it can only be run once
+  bool structuralChange;
+  QBENCHMARK_ONCE {
+    Tellico::Data::Document::mergeCollection(coll1, coll2, &structuralChange);
+  }
+  QVERIFY(coll1->entryCount() >= entryCount);
+}
+
+void CollectionBenchmark::benchmarkDerived_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkDerived() {
+  QFETCH(int, type);
+  QFETCH(int, entryCount);
+  // adding the field changes the collection, so use a new one
+  Tellico::Data::CollPtr coll = SyntheticCollection(BENCHMARK_SEED).create(type, entryCount, m_withImages);
+  QString valueTemplate = QStringLiteral("%{title}");
+  if(!coll->peopleFields().isEmpty()) {
+    valueTemplate += QStringLiteral(" by %{%1:1}").arg(coll->peopleFields().first()->name());
+  }
+  valueTemplate += QStringLiteral(" (%{%1})").arg(coll->defaultGroupField());
+  Tellico::Data::FieldPtr field(new Tellico::Data::Field(QStringLiteral("benchmark"), QStringLiteral("Benchmark")));
+  field->setProperty(QStringLiteral("template"), valueTemplate);
+  field->setFlags(Tellico::Data::Field::Derived);
+  QVERIFY(coll->addField(field));
+
+  const Tellico::Data::EntryList entries = coll->entries();
+  QBENCHMARK {
+    for(const auto& entry : entries) {
+      entry->formattedField(field);
+    }
+  }
+}
+
+void CollectionBenchmark::benchmarkHtmlExport_data() {
+  populateData();
+}
+
+void CollectionBenchmark::benchmarkHtmlExport() {
+  Tellico::Data::CollPtr coll = collection();
+
+  QBENCHMARK {
+    Tellico::Export::HTMLExporter exporter(coll);
+    exporter.setEntries(coll->entries());
+    exporter.setParseDOM(false);
+    QVERIFY(!exporter.text().isEmpty());
+  }
+}
+
+void CollectionBenchmark::benchmarkEntryRendering_data() {
+  populateData();
+}
+
+// renders the entries the same way as the entry view, with the default template
+void CollectionBenchmark::benchmarkEntryRendering() {
+  Tellico::Data::CollPtr coll = collection();
+  Tellico::XSLTHandler handler(QFile::encodeName(QFINDTESTDATA("../../xslt/entry-templates/Fancy.xsl")));
+  QVERIFY(handler.isValid());
+  handler.addStringParam("imgdir", Tellico::ImageFactory::tempDir().toEncoded());
+  handler.addStringParam("datadir", QUrl::fromLocalFile(QFINDTESTDATA("../../xslt/")).toEncoded());
+
+  const Tellico::Data::EntryList entries = coll->entries().mid(0, BENCHMARK_RENDER_COUNT);
+  QBENCHMARK {
+    for(const auto& entry : entries) {
+      Tellico::Export::TellicoXMLExporter exporter(coll);
+      exporter.setEntries(Tellico::Data::EntryList() << entry);
+      exporter.setOptions(exporter.options() | Tellico::Export::ExportVerifyImages |
+                          Tellico::Export::ExportComplete | Tellico::Export::ExportAbsoluteLinks);
+      const QString html = handler.applyStylesheet(exporter.exportXML().toString());
+      QVERIFY(!html.isEmpty());
+    }
+  }
+}
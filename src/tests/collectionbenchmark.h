@@ -0,0 +1,89 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef COLLECTIONBENCHMARK_H
+#define COLLECTIONBENCHMARK_H
+
+#include "../datavectors.h"
+
+#include <QObject>
+#include <QTemporaryDir>
+
+/**
+ * Benchmarks for large collections. The collections are created by SyntheticCollection,
+ * so every run uses the same data.
+ *
+ * The sizes and types are chosen with environment variables:
+ * TELLICO_BENCHMARK_ENTRIES is a comma-separated list of entry counts, 1000 by default,
+ * TELLICO_BENCHMARK_TYPES is a comma-separated list of collection type names, all types by default,
+ * and TELLICO_BENCHMARK_IMAGES=1 adds images to the entries.
+ *
+ * The results can be written in any QTest format, like "-o results.xml,xml" or "-o results.csv,csv".
+ */
+class CollectionBenchmark : public QObject {
+Q_OBJECT
+
+private Q_SLOTS:
+  void initTestCase();
+  void cleanupTestCase();
+  void benchmarkCreate_data();
+  void benchmarkCreate();
+  void benchmarkSaveXML_data();
+  void benchmarkSaveXML();
+  void benchmarkSaveZip_data();
+  void benchmarkSaveZip();
+  void benchmarkOpenXML_data();
+  void benchmarkOpenXML();
+  void benchmarkOpenZip_data();
+  void benchmarkOpenZip();
+  void benchmarkFilter_data();
+  void benchmarkFilter();
+  void benchmarkSort_data();
+  void benchmarkSort();
+  void benchmarkGroup_data();
+  void benchmarkGroup();
+  void benchmarkMerge_data();
+  void benchmarkMerge();
+  void benchmarkDerived_data();
+  void benchmarkDerived();
+  void benchmarkHtmlExport_data();
+  void benchmarkHtmlExport();
+  void benchmarkEntryRendering_data();
+  void benchmarkEntryRendering();
+
+private:
+  void populateData();
+  Tellico::Data::CollPtr collection();
+  QString writeFile(bool zip);
+
+  QList<int> m_types;
+  QList<int> m_entryCounts;
+  bool m_withImages;
+  QTemporaryDir m_tempDir;
+  // the last collection is kept, since creating it takes longer than most benchmarks
+  Tellico::Data::CollPtr m_coll;
+  QString m_collKey;
+};
+
+#endif
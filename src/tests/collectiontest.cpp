@@ -27,6 +27,7 @@
 #include "../collection.h"
 #include "../field.h"
 #include "../entry.h"
+#include "../entrygroup.h"
 #include "../collectionfactory.h"
 #include "../collections/collectioninitializer.h"
 #include "../collections/bookcollection.h"
@@ -36,6 +37,7 @@
 #include "../images/imagefactory.h"
 #include "../document.h"
 #include "../utils/mergeconflictresolver.h"
+#include "../charts/collectionstatistics.h"
 
 #include <KLocalizedString>
 #include <KProcess>
@@ -354,6 +356,105 @@ void CollectionTest::testValue_data() {
   QTest::newRow("test5") << "the return of the king;the who" << "Return of the King, The; Who, The" << int(Tellico::FieldFormat::FormatTitle);
 }
 
+void CollectionTest::testTypedValue() {
+  Tellico::Data::CollPtr coll(new Tellico::Data::Collection(true)); // add default field
+  Tellico::Data::FieldPtr number(new Tellico::Data::Field(QStringLiteral("number"), QStringLiteral("Number"),
+                                                          Tellico::Data::Field::Number));
+  coll->addField(number);
+  Tellico::Data::FieldPtr date(new Tellico::Data::Field(QStringLiteral("date"), QStringLiteral("Date"),
+                                                        Tellico::Data::Field::Date));
+  coll->addField(date);
+
+  Tellico::Data::EntryPtr entry(new Tellico::Data::Entry(coll));
+  coll->addEntries(entry);
+
+  bool ok = true;
+  entry->numberField(number, &ok);
+  QVERIFY(!ok);
+  QVERIFY(!entry->dateField(date).isValid());
+
+  // the parsed values have to be updated when the field value changes
+  entry->setField(number, QStringLiteral("3.5"));
+  QCOMPARE(entry->numberField(number, &ok), 3.5);
+  QVERIFY(ok);
+  entry->setField(number, QStringLiteral("7"));
+  QCOMPARE(entry->numberField(number, &ok), 7.0);
+  QVERIFY(ok);
+  entry->setField(number, QStringLiteral("seven"));
+  entry->numberField(number, &ok);
+  QVERIFY(!ok);
+
+  entry->setField(date, QStringLiteral("2011-1-25"));
+  QCOMPARE(entry->dateField(date), QDate(2011, 1, 25));
+  entry->setField(date, QStringLiteral("2012-02-26"));
+  QCOMPARE(entry->dateField(date), QDate(2012, 2, 26));
+  entry->setField(date, QString());
+  QVERIFY(!entry->dateField(date).isValid());
+}
+
+void CollectionTest::testRemoveEntries() {
+  Tellico::Data::CollPtr coll(new Tellico::Data::BookCollection(true));
+  Tellico::Data::EntryList entries;
+  for(int i = 0; i < 100; ++i) {
+    Tellico::Data::EntryPtr entry(new Tellico::Data::Entry(coll));
+    entry->setField(QStringLiteral("title"), QStringLiteral("Title %1").arg(i));
+    entry->setField(QStringLiteral("author"), (i % 2 == 0) ? QStringLiteral("Author Even")
+                                                           : QStringLiteral("Author Odd"));
+    entries << entry;
+  }
+  coll->addEntries(entries);
+  QCOMPARE(coll->entryCount(), 100);
+
+  Tellico::Data::EntryGroupDict* dict = coll->entryGroupDictByName(QStringLiteral("author"));
+  QVERIFY(dict);
+  QCOMPARE(dict->count(), 2);
+
+  // remove all the odd entries and a few even ones
+  Tellico::Data::EntryList removed;
+  for(int i = 0; i < 100; ++i) {
+    if(i % 2 == 1 || i < 10) {
+      removed << entries.at(i);
+    }
+  }
+  QVERIFY(coll->removeEntries(removed));
+  QCOMPARE(coll->entryCount(), 45);
+  QVERIFY(!coll->entryById(entries.at(1)->id()));
+  QVERIFY(!coll->entryById(entries.at(2)->id()));
+  QVERIFY(coll->entryById(entries.at(10)->id()));
+  // order is kept
+  QCOMPARE(coll->entries().first(), entries.at(10));
+  QCOMPARE(coll->entries().last(), entries.at(98));
+
+  foreach(Tellico::Data::EntryPtr entry, removed) {
+    QVERIFY(entry->groups().isEmpty());
+  }
+  QCOMPARE(entries.at(10)->groups().count(), 1);
+  Tellico::Data::EntryGroup* evenGroup = entries.at(10)->groups().first();
+  QCOMPARE(evenGroup->count(), 45);
+  QVERIFY(!evenGroup->contains(entries.at(2)));
+  // the emptied group is deleted
+  QCOMPARE(dict->count(), 1);
+}
+
+void CollectionTest::testSwapValues() {
+  Tellico::Data::CollPtr coll(new Tellico::Data::Collection(true)); // add default field
+  Tellico::Data::EntryPtr entry1(new Tellico::Data::Entry(coll));
+  entry1->setField(QStringLiteral("title"), QStringLiteral("Title 1"));
+  coll->addEntries(entry1);
+  Tellico::Data::EntryPtr entry2(new Tellico::Data::Entry(*entry1));
+  entry2->setField(QStringLiteral("title"), QStringLiteral("Title 2"));
+
+  const Tellico::Data::ID id = entry1->id();
+  entry1->swapValues(*entry2);
+  QCOMPARE(entry1->id(), id);
+  QCOMPARE(entry1->title(), QStringLiteral("Title 2"));
+  QCOMPARE(entry2->title(), QStringLiteral("Title 1"));
+  entry1->swapValues(*entry2);
+  QCOMPARE(entry1->id(), id);
+  QCOMPARE(entry1->title(), QStringLiteral("Title 1"));
+  QCOMPARE(entry2->title(), QStringLiteral("Title 2"));
+}
+
 void CollectionTest::testDtd() {
   const QString xmllint = QStandardPaths::findExecutable(QStringLiteral("xmllint"));
   if(xmllint.isEmpty()) {
@@ -726,3 +827,49 @@ void CollectionTest::testNonTitle() {
   // since there's a new field formatted as a title, the entry title changes
   QCOMPARE(entry->title(), QStringLiteral("Proxy Title"));
 }
+
+void CollectionTest::testStatistics() {
+  Tellico::Data::CollPtr coll(new Tellico::Data::BookCollection(true));
+  Tellico::Data::EntryList entries;
+  // enough entries to be split between threads
+  for(int i = 0; i < 5000; ++i) {
+    Tellico::Data::EntryPtr entry(new Tellico::Data::Entry(coll));
+    entry->setField(QStringLiteral("title"), QStringLiteral("Title %1").arg(i));
+    entry->setField(QStringLiteral("author"), (i % 2 == 0) ? QStringLiteral("Author Even")
+                                                           : QStringLiteral("Author Odd; Author Prime"));
+    if(i % 5 > 0) {
+      entry->setField(QStringLiteral("pub_year"), QString::number(2000 + i % 10));
+    }
+    entries << entry;
+  }
+  coll->addEntries(entries);
+
+  const QStringList fieldNames = {QStringLiteral("author"), QStringLiteral("pub_year"), QStringLiteral("nothing")};
+  auto stats = Tellico::CollectionStatistics::self()->statistics(coll, fieldNames);
+  QCOMPARE(stats.count(), 2);
+
+  const auto authorStats = stats.value(QStringLiteral("author"));
+  QCOMPARE(authorStats.emptyCount, 0);
+  QCOMPARE(authorStats.valueCounts.count(), 3);
+  QCOMPARE(authorStats.valueCounts.value(QStringLiteral("Author Even")), 2500);
+  QCOMPARE(authorStats.valueCounts.value(QStringLiteral("Author Prime")), 2500);
+  QCOMPARE(authorStats.groupCounts.count(), 3);
+  const auto topAuthors = authorStats.topGroups(2);
+  QCOMPARE(topAuthors.count(), 2);
+  QCOMPARE(topAuthors.at(0).second, 2500);
+
+  const auto yearStats = stats.value(QStringLiteral("pub_year"));
+  QCOMPARE(yearStats.emptyCount, 1000);
+  QCOMPARE(yearStats.numericCount, 4000);
+  QCOMPARE(yearStats.minimum, 2001.0);
+  QCOMPARE(yearStats.maximum, 2009.0);
+  QCOMPARE(yearStats.valueCounts.value(QStringLiteral("2001")), 500);
+  // the empty group is counted, but never one of the top groups
+  QCOMPARE(yearStats.groupCounts.value(QString()), 1000);
+  QCOMPARE(yearStats.topGroups(20).count(), 8);
+
+  // removing entries makes the statistics stale
+  coll->removeEntries(entries.mid(0, 1000));
+  const auto newStats = Tellico::CollectionStatistics::self()->statistics(coll, QStringLiteral("author"));
+  QCOMPARE(newStats.valueCounts.value(QStringLiteral("Author Even")), 2000);
+}
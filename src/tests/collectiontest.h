@@ -40,6 +40,9 @@ private Q_SLOTS:
   void testDerived();
   void testValue();
   void testValue_data();
+  void testTypedValue();
+  void testRemoveEntries();
+  void testSwapValues();
   void testDtd();
   void testDtd_data();
   void testDuplicate();
@@ -51,6 +54,7 @@ private Q_SLOTS:
   void testGamePlatform();
   void testEsrb();
   void testNonTitle();
+  void testStatistics();
 };
 
 #endif
@@ -35,6 +35,10 @@
 
 #include <QTest>
 #include <QStandardPaths>
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include <QDir>
 
 QTEST_MAIN( CsvTest )
 
@@ -81,6 +85,38 @@ void CsvTest::testTokens_data() {
     << (QStringList() << QL1("robby") << QL1("stephenson\n,is,cool"));
 }
 
+void CsvTest::testDeviceTokens() {
+  // rows which are longer than a chunk, and quoted values with line breaks
+  const QString longValue(100000, QLatin1Char('x'));
+  QString text = QStringLiteral("robby,\"stephenson\n,is,cool\"\n\n");
+  text += QLatin1String("short,") + longValue + QLatin1String(",\"last\"\n");
+  text += QStringLiteral("unicode,\u00e9t\u00e9,no newline");
+
+  QByteArray data = "\xEF\xBB\xBF" + text.toUtf8();
+  QBuffer buffer(&data);
+  QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+  Tellico::CSVParser p(&buffer);
+  p.setDelimiter(QStringLiteral(","));
+  QStringList tokens;
+  QVERIFY(p.hasNext());
+  p.nextTokens(tokens);
+  QCOMPARE(tokens, QStringList() << QL1("robby") << QL1("stephenson\n,is,cool"));
+  QVERIFY(p.hasNext());
+  p.nextTokens(tokens);
+  QCOMPARE(tokens, QStringList() << QL1("short") << longValue << QL1("last"));
+  QVERIFY(p.hasNext());
+  p.nextTokens(tokens);
+  QCOMPARE(tokens, QStringList() << QL1("unicode") << QString::fromUtf8("\xC3\xA9t\xC3\xA9") << QL1("no newline"));
+  QVERIFY(!p.hasNext());
+
+  // the first row can be skipped
+  buffer.seek(0);
+  p.reset(&buffer);
+  p.skipLine();
+  QCOMPARE(p.nextTokens().first(), QL1("short"));
+}
+
 void CsvTest::testEntry() {
   Tellico::Data::CollPtr coll(new Tellico::Data::Collection(true));
   Tellico::Data::EntryPtr entry(new Tellico::Data::Entry(coll));
@@ -149,3 +185,32 @@ void CsvTest::testBug386483() {
   QCOMPARE(cols.at(1), QStringLiteral("artist2"));
   QCOMPARE(cols.at(2), QStringLiteral("0:34"));
 }
+
+void CsvTest::testImportLarge() {
+  // more rows than are added to the collection at once
+  const int numRows = 2500;
+  QTemporaryFile tempFile(QDir::tempPath() + QStringLiteral("/csvtest_XXXXXX.csv"));
+  QVERIFY(tempFile.open());
+  {
+    QTextStream ts(&tempFile);
+    ts << "title,author,binding\n";
+    for(int i = 0; i < numRows; ++i) {
+      ts << "\"Title " << i << "\",\"Author, " << i << "\",Hardback\n";
+    }
+  }
+  tempFile.close();
+
+  Tellico::Import::CSVImporter importer(QUrl::fromLocalFile(tempFile.fileName()));
+  importer.setCollectionType(Tellico::Data::Collection::Book);
+  importer.setImportColumns({0, 1, 2},
+                            {QStringLiteral("title"), QStringLiteral("author"), QStringLiteral("binding")});
+  importer.slotFirstRowHeader(true);
+  Tellico::Data::CollPtr coll = importer.collection();
+  QVERIFY(coll);
+  QCOMPARE(coll->entryCount(), numRows);
+
+  Tellico::Data::EntryList entries = coll->entries();
+  QCOMPARE(entries.first()->field(QStringLiteral("title")), QStringLiteral("Title 0"));
+  QCOMPARE(entries.last()->field(QStringLiteral("author")), QStringLiteral("Author, 2499"));
+  QCOMPARE(entries.last()->field(QStringLiteral("binding")), QStringLiteral("Hardback"));
+}
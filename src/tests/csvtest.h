@@ -36,9 +36,11 @@ private Q_SLOTS:
 
   void testTokens();
   void testTokens_data();
+  void testDeviceTokens();
   void testEntry();
   void testImportBook();
   void testBug386483();
+  void testImportLarge();
 };
 
 #endif
@@ -0,0 +1,132 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#undef QT_NO_CAST_FROM_ASCII
+
+#include "fetcherreplaytest.h"
+
+#include "../fetch/isbndbfetcher.h"
+#include "../fetch/dblpfetcher.h"
+#include "../fetch/messagelogger.h"
+#include "../collections/bibtexcollection.h"
+#include "../collectionfactory.h"
+#include "../entry.h"
+#include "../images/imagefactory.h"
+#include "../utils/datafileregistry.h"
+
+#include <KConfigGroup>
+#include <KSharedConfig>
+
+#include <QTest>
+#include <QStandardPaths>
+
+QTEST_GUILESS_MAIN( FetcherReplayTest )
+
+FetcherReplayTest::FetcherReplayTest() : AbstractFetcherTest()
+    , m_mode(Tellico::NetworkReplay::mode())
+    , m_directory(Tellico::NetworkReplay::directory()) {
+}
+
+void FetcherReplayTest::initTestCase() {
+  QStandardPaths::setTestModeEnabled(true);
+  Tellico::ImageFactory::init();
+  Tellico::RegisterCollection<Tellico::Data::BibtexCollection> registerBibtex(Tellico::Data::Collection::Bibtex, "bibtex");
+  Tellico::DataFileRegistry::self()->addDataLocation(QFINDTESTDATA("../../xslt/dblp2tellico.xsl"));
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, QFINDTESTDATA("data/network-replay"));
+}
+
+void FetcherReplayTest::cleanupTestCase() {
+  Tellico::NetworkReplay::setMode(m_mode, m_directory);
+}
+
+void FetcherReplayTest::testIsbndb() {
+  // the key is not part of the recorded request, so any value works
+  KConfigGroup cg = KSharedConfig::openConfig(QString(), KConfig::SimpleConfig)->group(QStringLiteral("isbndb replay"));
+  cg.writeEntry("API Key", QStringLiteral("replay"));
+
+  Tellico::Fetch::FetchRequest request(Tellico::Data::Collection::Book, Tellico::Fetch::ISBN,
+                                       QStringLiteral("0620062126"));
+  Tellico::Fetch::Fetcher::Ptr fetcher(new Tellico::Fetch::ISBNdbFetcher(this));
+  fetcher->readConfig(cg);
+
+  Tellico::Fetch::MessageLogger* logger = new Tellico::Fetch::MessageLogger;
+  fetcher->setMessageHandler(logger);
+
+  Tellico::Data::EntryList results = doFetch(fetcher, request);
+  QVERIFY(logger->errorList.isEmpty());
+
+  QCOMPARE(results.size(), 1);
+
+  Tellico::Data::EntryPtr entry = results.at(0);
+  QCOMPARE(entry->field(QStringLiteral("title")), QStringLiteral("Killie's Africa"));
+  QCOMPARE(entry->field(QStringLiteral("author")), QStringLiteral("Herd, Norman"));
+  QCOMPARE(entry->field(QStringLiteral("isbn")), QStringLiteral("0620062126"));
+  QCOMPARE(entry->field(QStringLiteral("publisher")), QStringLiteral("Blue Crane Books"));
+}
+
+void FetcherReplayTest::benchmarkIsbndb() {
+  KConfigGroup cg = KSharedConfig::openConfig(QString(), KConfig::SimpleConfig)->group(QStringLiteral("isbndb replay"));
+  cg.writeEntry("API Key", QStringLiteral("replay"));
+
+  Tellico::Fetch::FetchRequest request(Tellico::Data::Collection::Book, Tellico::Fetch::ISBN,
+                                       QStringLiteral("0620062126"));
+  // with the recorded response, this measures the JSON parsing and the conversion to entries
+  QBENCHMARK {
+    Tellico::Fetch::Fetcher::Ptr fetcher(new Tellico::Fetch::ISBNdbFetcher(this));
+    fetcher->readConfig(cg);
+    Tellico::Data::EntryList results = doFetch(fetcher, request);
+    QCOMPARE(results.size(), 1);
+  }
+}
+
+void FetcherReplayTest::testDblp() {
+  Tellico::Fetch::FetchRequest request(Tellico::Data::Collection::Bibtex, Tellico::Fetch::Keyword,
+                                       QStringLiteral("Chip and PIN is Broken"));
+  Tellico::Fetch::Fetcher::Ptr fetcher(new Tellico::Fetch::DBLPFetcher(this));
+
+  Tellico::Data::EntryList results = doFetch(fetcher, request, 1);
+
+  QCOMPARE(results.size(), 1);
+
+  Tellico::Data::EntryPtr entry = results.at(0);
+  QCOMPARE(entry->field(QStringLiteral("title")), QStringLiteral("Chip and PIN is Broken."));
+  QCOMPARE(entry->field(QStringLiteral("author")), QStringLiteral("Steven J. Murdoch; Saar Drimer; Ross J. Anderson; Mike Bond"));
+  QCOMPARE(entry->field(QStringLiteral("year")), QStringLiteral("2010"));
+  QCOMPARE(entry->field(QStringLiteral("pages")), QStringLiteral("433-446"));
+  QCOMPARE(entry->field(QStringLiteral("booktitle")), QStringLiteral("IEEE Symposium on Security and Privacy"));
+  QCOMPARE(entry->field(QStringLiteral("url")), QStringLiteral("https://dblp.org/rec/conf/sp/MurdochDAB10"));
+  QCOMPARE(entry->field(QStringLiteral("entry-type")), QStringLiteral("inproceedings"));
+  QCOMPARE(entry->field(QStringLiteral("bibtex-key")), QStringLiteral("MurdochDAB10"));
+}
+
+void FetcherReplayTest::benchmarkDblp() {
+  Tellico::Fetch::FetchRequest request(Tellico::Data::Collection::Bibtex, Tellico::Fetch::Keyword,
+                                       QStringLiteral("Chip and PIN is Broken"));
+  // with the recorded response, this measures the XML parsing, the stylesheet, and the conversion to entries
+  QBENCHMARK {
+    Tellico::Fetch::Fetcher::Ptr fetcher(new Tellico::Fetch::DBLPFetcher(this));
+    Tellico::Data::EntryList results = doFetch(fetcher, request, 1);
+    QCOMPARE(results.size(), 1);
+  }
+}
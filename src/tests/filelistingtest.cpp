@@ -28,6 +28,7 @@
 #include "filelistingtest.h"
 
 #include "../translators/filelistingimporter.h"
+#include "../translators/translators.h"
 #include "../translators/xmphandler.h"
 #include "../images/imagefactory.h"
 #include "../core/netaccess.h"
@@ -37,6 +38,7 @@
 #include <QTest>
 #include <QLoggingCategory>
 #include <QStandardPaths>
+#include <QDate>
 
 // can't be GUILESS to get the icon preview
 QTEST_MAIN( FileListingTest )
@@ -224,3 +226,46 @@ void FileListingTest::testVideo() {
   QCOMPARE(castList.at(1), QStringLiteral("Sigourney Weaver::Lt. Ellen Louise Ripley"));
   QVERIFY(!e1->field("plot").isEmpty());
 }
+
+void FileListingTest::testUpdate() {
+  QUrl url = QUrl::fromLocalFile(QFINDTESTDATA("data/test_movie.mpg"));
+  const QUrl dirUrl = url.adjusted(QUrl::RemoveFilename);
+  Tellico::Import::FileListingImporter importer(dirUrl);
+  importer.setCollectionType(Tellico::Data::Collection::Video);
+  Tellico::Data::CollPtr coll = importer.collection();
+  QVERIFY(coll);
+  QCOMPARE(coll->entryCount(), 2);
+
+  // the test movie file is now newer than its entry, but the other one is not
+  Tellico::Data::EntryPtr movieEntry;
+  foreach(Tellico::Data::EntryPtr entry, coll->entries()) {
+    if(entry->field("url") == url.url()) {
+      movieEntry = entry;
+      entry->setField(QStringLiteral("mdate"), QStringLiteral("2000-01-01"));
+    } else {
+      entry->setField(QStringLiteral("mdate"), QDate::currentDate().addDays(1).toString(Qt::ISODate));
+    }
+  }
+  QVERIFY(movieEntry);
+  Tellico::Data::EntryPtr missingEntry(new Tellico::Data::Entry(coll));
+  missingEntry->setField(QStringLiteral("title"), QStringLiteral("Missing Movie"));
+  missingEntry->setField(QStringLiteral("url"), dirUrl.url() + QLatin1String("missing_movie.mpg"));
+  coll->addEntries(missingEntry);
+
+  Tellico::Import::FileListingImporter updater(dirUrl);
+  updater.setCollectionType(Tellico::Data::Collection::Video);
+  updater.setCurrentCollection(coll);
+  QVERIFY(updater.canUpdate());
+  updater.slotActionChanged(Tellico::Import::Update);
+  Tellico::Data::CollPtr updateColl = updater.collection();
+  QVERIFY(updateColl);
+  // no new files
+  QCOMPARE(updateColl->entryCount(), 0);
+
+  const Tellico::Import::UpdateResult& result = updater.updateResult();
+  QCOMPARE(result.modifiedEntries.count(), 1);
+  QVERIFY(result.modifiedEntries.at(0).first == movieEntry);
+  QCOMPARE(result.modifiedEntries.at(0).second->field("title"), QStringLiteral("Test Movie"));
+  QCOMPARE(result.missingEntries.count(), 1);
+  QVERIFY(result.missingEntries.at(0) == missingEntry);
+}
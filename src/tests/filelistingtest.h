@@ -37,6 +37,7 @@ private Q_SLOTS:
   void testStat();
   void testBook();
   void testVideo();
+  void testUpdate();
 };
 
 #endif
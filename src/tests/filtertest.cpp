@@ -398,3 +398,40 @@ void FilterTest::testFilterParser() {
   QCOMPARE(rule1->fieldName(), QLatin1String("author"));
   QCOMPARE(rule1->pattern(), QLatin1String("sutter"));
 }
+
+void FilterTest::testFilterPlan() {
+  Tellico::Data::CollPtr coll(new Tellico::Data::BookCollection(true, QStringLiteral("TestCollection")));
+  Tellico::Data::EntryPtr entry(new Tellico::Data::Entry(coll));
+  entry->setField(QStringLiteral("title"), QStringLiteral("The Hobbit"));
+  entry->setField(QStringLiteral("author"), QStringLiteral("J.R.R. Tolkien"));
+
+  // the rules get evaluated in a different order than they were added, the result is the same
+  Tellico::Filter filter(Tellico::Filter::MatchAll);
+  filter.append(new Tellico::FilterRule(QString(), QStringLiteral("tolkien"), Tellico::FilterRule::FuncContains));
+  filter.append(new Tellico::FilterRule(QStringLiteral("title"), QStringLiteral("hob+it"), Tellico::FilterRule::FuncRegExp));
+  filter.append(new Tellico::FilterRule(QStringLiteral("title"), QStringLiteral("The Hobbit"), Tellico::FilterRule::FuncEquals));
+  QVERIFY(filter.matches(entry));
+
+  entry->setField(QStringLiteral("author"), QStringLiteral("Tolkien"));
+  QVERIFY(filter.matches(entry));
+  entry->setField(QStringLiteral("author"), QStringLiteral("Lewis"));
+  QVERIFY(!filter.matches(entry));
+
+  filter.setMatch(Tellico::Filter::MatchAny);
+  QVERIFY(filter.matches(entry));
+  filter.at(2)->setFunction(Tellico::FilterRule::FuncNotEquals);
+  filter.at(1)->setFieldName(QStringLiteral("author"));
+  QVERIFY(!filter.matches(entry));
+
+  // a rule for a field which does not exist yet matches an empty value
+  Tellico::Filter filter2(Tellico::Filter::MatchAll);
+  filter2.append(new Tellico::FilterRule(QStringLiteral("test"), QString(), Tellico::FilterRule::FuncEquals));
+  QVERIFY(filter2.matches(entry));
+  // adding the field has to update the field lookup
+  Tellico::Data::FieldPtr testField(new Tellico::Data::Field(QStringLiteral("test"), QStringLiteral("Test")));
+  coll->addField(testField);
+  entry->setField(QStringLiteral("test"), QStringLiteral("value"));
+  QVERIFY(!filter2.matches(entry));
+  coll->removeField(QStringLiteral("test"));
+  QVERIFY(filter2.matches(entry));
+}
@@ -35,6 +35,7 @@ private Q_SLOTS:
   void testFilter();
   void testGroupViewFilter();
   void testFilterParser();
+  void testFilterPlan();
 };
 
 #endif
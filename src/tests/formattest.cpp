@@ -39,6 +39,7 @@ void FormatTest::initTestCase() {
   KLocalizedString::setApplicationDomain("tellico");
   Tellico::Config::setArticlesString(QStringLiteral("the,l'"));
   Tellico::Config::setNoCapitalizationString(QStringLiteral("the,of,et,de"));
+  Tellico::FieldFormat::resetCache();
 }
 
 void FormatTest::testCapitalization() {
@@ -151,6 +152,7 @@ void FormatTest::testStripArticles() {
   QFETCH(QString, stripped);
 
   Tellico::Config::setArticlesString(articles);
+  Tellico::FieldFormat::resetCache();
   Tellico::FieldFormat::stripArticles(string);
   QCOMPARE(string, stripped);
 }
@@ -171,3 +173,34 @@ void FormatTest::testStripArticles_data() {
   QTest::newRow("test9") << "l'" << "the name" << "the name";
   QTest::newRow("test10") << "l'" << "l'name," << "name";
 }
+
+void FormatTest::testFormatCache() {
+  Tellico::Config::setArticlesString(QStringLiteral("the,l'"));
+  Tellico::FieldFormat::resetCache();
+  const QString title(QStringLiteral("the return of the king"));
+  QCOMPARE(Tellico::FieldFormat::format(title, Tellico::FieldFormat::FormatTitle, Tellico::FieldFormat::ForceFormat),
+           QStringLiteral("Return of the King, The"));
+  // the same value comes back out of the cache
+  QCOMPARE(Tellico::FieldFormat::format(title, Tellico::FieldFormat::FormatTitle, Tellico::FieldFormat::ForceFormat),
+           QStringLiteral("Return of the King, The"));
+  QCOMPARE(Tellico::FieldFormat::format(title, Tellico::FieldFormat::FormatTitle, Tellico::FieldFormat::AsIsFormat),
+           title);
+
+  // changing the articles has to invalidate the cached values
+  Tellico::Config::setArticlesString(QStringLiteral("l'"));
+  Tellico::FieldFormat::resetCache();
+  QCOMPARE(Tellico::FieldFormat::format(title, Tellico::FieldFormat::FormatTitle, Tellico::FieldFormat::ForceFormat),
+           QStringLiteral("The Return of the King"));
+  Tellico::Config::setArticlesString(QStringLiteral("the,l'"));
+  Tellico::FieldFormat::resetCache();
+
+  const QString name(QStringLiteral("john q. public jr."));
+  QCOMPARE(Tellico::FieldFormat::format(name, Tellico::FieldFormat::FormatName, Tellico::FieldFormat::ForceFormat),
+           QStringLiteral("Public, Jr., John Q."));
+  Tellico::Config::setNameSuffixesString(QStringLiteral("iii"));
+  Tellico::FieldFormat::resetCache();
+  QCOMPARE(Tellico::FieldFormat::format(name, Tellico::FieldFormat::FormatName, Tellico::FieldFormat::ForceFormat),
+           QStringLiteral("Jr., John Q. Public"));
+  Tellico::Config::setNameSuffixesString(QStringLiteral("jr.,jr,iii,iv"));
+  Tellico::FieldFormat::resetCache();
+}
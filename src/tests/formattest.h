@@ -41,6 +41,7 @@ private Q_SLOTS:
   void testSplit();
   void testStripArticles();
   void testStripArticles_data();
+  void testFormatCache();
 };
 
 #endif
@@ -46,6 +46,7 @@
 #include <QStandardPaths>
 #include <QProcess>
 #include <QLoggingCategory>
+#include <QBuffer>
 
 QTEST_GUILESS_MAIN( HtmlExporterTest )
 
@@ -344,3 +345,38 @@ void HtmlExporterTest::testEntryTemplates_data() {
     QTest::newRow(file.toUtf8().constData()) << file;
   }
 }
+
+void HtmlExporterTest::testEntryPages() {
+  Tellico::ImageFactory::clean(true);
+
+  QUrl url = QUrl::fromLocalFile(QFINDTESTDATA(QStringLiteral("data/books-format11.bc")));
+  Tellico::Import::TellicoImporter importer(url);
+  Tellico::Data::CollPtr coll = importer.collection();
+  QVERIFY(coll);
+  QVERIFY(coll->entryCount() > 1);
+
+  Tellico::Export::HTMLExporter exporter(coll);
+  exporter.setParseDOM(false);
+  exporter.setEntries(coll->entries());
+  exporter.setXSLTFile(QStringLiteral("Default.xsl"));
+
+  QBuffer buffer;
+  QVERIFY(buffer.open(QIODevice::WriteOnly));
+  const QString separator = QStringLiteral("<hr class=\"page-separator\"/>");
+  const QUrl baseUrl = QUrl::fromLocalFile(QFINDTESTDATA("../../xslt/entry-templates/Default.xsl"));
+  QVERIFY(exporter.writeEntryPages(&buffer, separator, baseUrl));
+  // the entry list is restored afterwards
+  QCOMPARE(exporter.entries().count(), coll->entryCount());
+
+  const QString output = QString::fromUtf8(buffer.data());
+  // a single document with a page for each entry
+  QCOMPARE(output.count(QStringLiteral("<body"), Qt::CaseInsensitive), 1);
+  QCOMPARE(output.count(QStringLiteral("</body"), Qt::CaseInsensitive), 1);
+  QCOMPARE(output.count(separator), coll->entryCount() - 1);
+  // the base url is only added to the head once
+  QCOMPARE(output.count(QStringLiteral("<base href=")), 1);
+  QVERIFY(output.contains(baseUrl.toString(QUrl::FullyEncoded)));
+  for(const auto& entry : coll->entries()) {
+    QVERIFY(output.contains(entry->title(), Qt::CaseInsensitive));
+  }
+}
@@ -28,6 +28,8 @@
 #include "../images/imagejob.h"
 #include "../images/imagefactory.h"
 #include "../images/imageinfo.h"
+#include "../images/image.h"
+#include "../core/networkreplay.h"
 
 #include <KLocalizedString>
 #include <KIO/Global>
@@ -38,6 +40,8 @@
 #include <QNetworkInterface>
 #include <QSignalSpy>
 #include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QDir>
 
 QTEST_GUILESS_MAIN( ImageJobTest )
 
@@ -380,3 +384,112 @@ void ImageJobTest::testFactoryRequestNetworkLinkOnly() {
   QCOMPARE(img.format(), QByteArray("png"));
   QCOMPARE(img.linkOnly(), true);
 }
+
+void ImageJobTest::testFactoryRequestNetworkDuplicates() {
+  if(!hasNetwork()) QSKIP("This test requires network access", SkipSingle);
+
+  // start without any image downloaded
+  Tellico::ImageFactory::clean(false);
+  QSignalSpy spy(Tellico::ImageFactory::self(), &Tellico::ImageFactory::imageAvailable);
+
+  // the url is only downloaded once, no matter how many times it is requested
+  QUrl u(QStringLiteral("https://tellico-project.org/wp-content/uploads/96-tellico.png"));
+  Tellico::ImageFactory::requestImageById(u.url());
+  Tellico::ImageFactory::requestImageById(u.url());
+  Tellico::ImageFactory::requestImageById(u.url());
+
+  QVERIFY(spy.wait(10000));
+  QVERIFY(!spy.wait(1000));
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("ecaf5185c4016881aaabb4933211d5d6.png"));
+
+  // a later request uses the image already in memory
+  spy.clear();
+  Tellico::ImageFactory::requestImageById(u.url());
+  QVERIFY(spy.wait(1000));
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("ecaf5185c4016881aaabb4933211d5d6.png"));
+}
+
+void ImageJobTest::testFactoryRequestQueue() {
+  // the downloads are replayed from local files, with a delay so they overlap
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const Tellico::NetworkReplay::Mode mode = Tellico::NetworkReplay::mode();
+  const QString directory = Tellico::NetworkReplay::directory();
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, dir.path());
+  Tellico::NetworkReplay::setLatency(100);
+
+  Tellico::ImageFactory::clean(false);
+  QSignalSpy spy(Tellico::ImageFactory::self(), &Tellico::ImageFactory::imageAvailable);
+
+  // the first request has no recorded response, so it fails and has to free its slot
+  Tellico::ImageFactory::requestImageById(QStringLiteral("http://host0.example.com/missing.jpg"));
+  const QString imageFile = QFINDTESTDATA("data/img1.jpg");
+  const int hostCount = 5;
+  const int imagesPerHost = 5;
+  for(int host = 0; host < hostCount; ++host) {
+    for(int i = 0; i < imagesPerHost; ++i) {
+      const QUrl u(QStringLiteral("http://host%1.example.com/image%2.jpg").arg(host).arg(i));
+      const QString fileName = Tellico::NetworkReplay::responseFile("GET", u);
+      QVERIFY(QDir().mkpath(QFileInfo(fileName).absolutePath()));
+      QVERIFY(QFile::copy(imageFile, fileName));
+      // every url is only downloaded once
+      Tellico::ImageFactory::requestImageById(u.url());
+      Tellico::ImageFactory::requestImageById(u.url());
+    }
+  }
+  // only a few downloads run at the same time, in total and for each host
+  QCOMPARE(Tellico::ImageFactory::self()->runningDownloadCount(), 16);
+  QCOMPARE(Tellico::ImageFactory::self()->runningDownloadCount(QStringLiteral("host0.example.com")), 4);
+
+  QTRY_COMPARE_WITH_TIMEOUT(spy.count(), hostCount * imagesPerHost, 10000);
+  QVERIFY(!spy.wait(500));
+  QCOMPARE(spy.count(), hostCount * imagesPerHost);
+  QCOMPARE(Tellico::ImageFactory::self()->runningDownloadCount(), 0);
+  QVERIFY(Tellico::ImageFactory::self()->hasNullImage(QStringLiteral("http://host0.example.com/missing.jpg")));
+
+  Tellico::NetworkReplay::setLatency(0);
+  Tellico::NetworkReplay::setMode(mode, directory);
+}
+
+void ImageJobTest::testFactoryCleanQueue() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const Tellico::NetworkReplay::Mode mode = Tellico::NetworkReplay::mode();
+  const QString directory = Tellico::NetworkReplay::directory();
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, dir.path());
+  Tellico::NetworkReplay::setLatency(200);
+
+  Tellico::ImageFactory::clean(false);
+  QSignalSpy spy(Tellico::ImageFactory::self(), &Tellico::ImageFactory::imageAvailable);
+
+  const QString imageFile = QFINDTESTDATA("data/img1.jpg");
+  const QString imageId = Tellico::Data::Image(imageFile).id();
+  QList<QUrl> urls;
+  for(int i = 0; i < 10; ++i) {
+    const QUrl u(QStringLiteral("http://host.example.com/image%1.jpg").arg(i));
+    const QString fileName = Tellico::NetworkReplay::responseFile("GET", u);
+    QVERIFY(QDir().mkpath(QFileInfo(fileName).absolutePath()));
+    QVERIFY(QFile::copy(imageFile, fileName));
+    Tellico::ImageFactory::requestImageById(u.url());
+    urls += u;
+  }
+  QCOMPARE(Tellico::ImageFactory::self()->runningDownloadCount(), 4);
+
+  // closing the document drops the waiting downloads, and the running ones are not kept
+  Tellico::ImageFactory::clean(false);
+  QVERIFY(!spy.wait(1000));
+  QCOMPARE(spy.count(), 0);
+  QCOMPARE(Tellico::ImageFactory::self()->runningDownloadCount(), 0);
+  QVERIFY(!Tellico::ImageFactory::self()->hasImageInMemory(imageId));
+
+  // the same url can be requested again for the next document
+  Tellico::ImageFactory::requestImageById(urls.first().url());
+  QVERIFY(spy.wait(2000));
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.at(0).at(0).toString(), imageId);
+
+  Tellico::NetworkReplay::setLatency(0);
+  Tellico::NetworkReplay::setMode(mode, directory);
+}
@@ -51,6 +51,9 @@ private Q_SLOTS:
   void testFactoryRequestLocalInvalid();
   void testFactoryRequestNetwork();
   void testFactoryRequestNetworkLinkOnly();
+  void testFactoryRequestNetworkDuplicates();
+  void testFactoryRequestQueue();
+  void testFactoryCleanQueue();
 
 Q_SIGNALS:
   void exitLoop();
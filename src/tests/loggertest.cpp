@@ -0,0 +1,134 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#undef QT_NO_CAST_FROM_ASCII
+
+#include "loggertest.h"
+
+#include "../core/logger.h"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+QTEST_GUILESS_MAIN( LoggerTest )
+
+void LoggerTest::cleanup() {
+  Tellico::Logger::self()->setLogFile(QString());
+  Tellico::Logger::self()->setFormat(Tellico::Logger::Text);
+}
+
+void LoggerTest::testThreads() {
+  QTemporaryDir dir;
+  const QString logFile = dir.filePath(QStringLiteral("log.txt"));
+  Tellico::Logger* logger = Tellico::Logger::self();
+  logger->setLogFile(logFile);
+  QCOMPARE(logger->logFile(), logFile);
+
+  // more messages than the ring buffer holds, from several threads at once
+  const int threadCount = 4;
+  const int messageCount = 5000;
+  QList<QThread*> threads;
+  for(int i = 0; i < threadCount; ++i) {
+    threads += QThread::create([logger, i, messageCount]() {
+      for(int j = 0; j < messageCount; ++j) {
+        logger->log(QStringLiteral("thread %1 message %2").arg(i).arg(j));
+      }
+    });
+    threads.last()->start();
+  }
+  for(auto thread : std::as_const(threads)) {
+    QVERIFY(thread->wait());
+    delete thread;
+  }
+  logger->flush();
+
+  QFile file(logFile);
+  QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+  const QStringList lines = QString::fromUtf8(file.readAll()).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+  QCOMPARE(lines.count(), threadCount * messageCount);
+  // the messages from each thread stay in order
+  QStringList thread0;
+  for(const auto& line : lines) {
+    if(line.startsWith(QLatin1String("thread 0 "))) {
+      thread0 += line;
+    }
+  }
+  QCOMPARE(thread0.count(), messageCount);
+  QCOMPARE(thread0.first(), QStringLiteral("thread 0 message 0"));
+  QCOMPARE(thread0.last(), QStringLiteral("thread 0 message %1").arg(messageCount-1));
+}
+
+void LoggerTest::testJson() {
+  QTemporaryDir dir;
+  const QString logFile = dir.filePath(QStringLiteral("log.json"));
+  Tellico::Logger* logger = Tellico::Logger::self();
+  logger->setFormat(Tellico::Logger::JsonLines);
+  logger->setLogFile(logFile);
+  QCOMPARE(logger->format(), Tellico::Logger::JsonLines);
+
+  qInfo() << "json message";
+  logger->flush();
+
+  QFile file(logFile);
+  QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+  const QByteArray line = file.readLine().trimmed();
+  QJsonParseError error;
+  const QJsonObject obj = QJsonDocument::fromJson(line, &error).object();
+  QCOMPARE(error.error, QJsonParseError::NoError);
+  QCOMPARE(obj.value(QLatin1String("message")).toString(), QStringLiteral("json message"));
+  QCOMPARE(obj.value(QLatin1String("level")).toString(), QStringLiteral("info"));
+  QVERIFY(!obj.value(QLatin1String("time")).toString().isEmpty());
+  QVERIFY(!obj.value(QLatin1String("thread")).toString().isEmpty());
+}
+
+void LoggerTest::testSwitchFormat() {
+  QTemporaryDir dir;
+  const QString logFile = dir.filePath(QStringLiteral("log.txt"));
+  Tellico::Logger* logger = Tellico::Logger::self();
+  logger->setLogFile(logFile);
+
+  // messages logged before the switch are written as text, the ones after as JSON
+  const int messageCount = 100;
+  for(int i = 0; i < messageCount; ++i) {
+    logger->log(QStringLiteral("text message %1").arg(i));
+  }
+  logger->setFormat(Tellico::Logger::JsonLines);
+  logger->log(QStringLiteral("json message"));
+  logger->flush();
+
+  QFile file(logFile);
+  QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+  const QStringList lines = QString::fromUtf8(file.readAll()).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+  QCOMPARE(lines.count(), messageCount + 1);
+  for(int i = 0; i < messageCount; ++i) {
+    QCOMPARE(lines.at(i), QStringLiteral("text message %1").arg(i));
+  }
+  QJsonParseError error;
+  const QJsonObject obj = QJsonDocument::fromJson(lines.last().toUtf8(), &error).object();
+  QCOMPARE(error.error, QJsonParseError::NoError);
+  QCOMPARE(obj.value(QLatin1String("message")).toString(), QStringLiteral("json message"));
+}
@@ -48,10 +48,6 @@ void MarcTest::initTestCase() {
 }
 
 void MarcTest::testMarc() {
-  const QString marcdump = QStandardPaths::findExecutable(QStringLiteral("yaz-marcdump"));
-  if(marcdump.isEmpty()) {
-    QSKIP("This test requires yaz-marcdump", SkipAll);
-  }
   QUrl url = QUrl::fromLocalFile(QFINDTESTDATA("data/test.mrc"));
   Tellico::Import::MarcImporter importer(url);
   importer.setCharacterSet(QStringLiteral("iso-8859-1"));
@@ -71,6 +67,56 @@ void MarcTest::testMarc() {
   QCOMPARE(entry->field("author"), QStringLiteral("Jansson, Tove"));
   QCOMPARE(entry->field("pub_year"), QStringLiteral("1998"));
   QCOMPARE(entry->field("isbn"), QStringLiteral("951-500880-8"));
+  QCOMPARE(entry->field("publisher"), QStringLiteral("Schildt"));
+  QCOMPARE(entry->field("edition"), QStringLiteral("7. uppl."));
+  QCOMPARE(entry->field("language"), QStringLiteral("Swedish"));
+  QCOMPARE(entry->field("address"), QStringLiteral("Helsingfors"));
+  QCOMPARE(entry->field("series"), QStringLiteral("Mumin-biblioteket"));
+  QCOMPARE(entry->field("comments"), QStringLiteral("166, [4] s. : ill. ; 21 cm<br/><br/>Tove Jansson<br/><br/>"
+                                                    "Originaluppl. 1962<br/><br/>"));
+}
+
+void MarcTest::testMarcDump() {
+  const QString marcdump = QStandardPaths::findExecutable(QStringLiteral("yaz-marcdump"));
+  if(marcdump.isEmpty()) {
+    QSKIP("This test requires yaz-marcdump", SkipAll);
+  }
+  QUrl url = QUrl::fromLocalFile(QFINDTESTDATA("data/test.mrc"));
+  Tellico::Import::MarcImporter importer(url);
+  // MARC-8 can't be read natively, so the importer uses yaz-marcdump
+  importer.setCharacterSet(QStringLiteral("MARC-8"));
+
+  Tellico::Data::CollPtr coll = importer.collection();
+
+  QVERIFY(coll);
+  QCOMPARE(coll->entryCount(), 1);
+  // since the importer uses MODS as an intermediate format, the title reflects that
+  QCOMPARE(coll->title(), QStringLiteral("MODS Import"));
+}
+
+void MarcTest::testMarcXml() {
+  QUrl url = QUrl::fromLocalFile(QFINDTESTDATA("data/dnb-marcxml.xml"));
+  Tellico::Import::MarcImporter importer(url);
+
+  Tellico::Data::CollPtr coll = importer.collection();
+
+  QVERIFY(coll);
+  QCOMPARE(coll->type(), Tellico::Data::Collection::Book);
+  // the SRU record elements are skipped
+  QCOMPARE(coll->entryCount(), 25);
+
+  Tellico::Data::EntryPtr entry = coll->entryById(1);
+  QVERIFY(entry);
+  QCOMPARE(entry->field("title"), QStringLiteral("Die staubsaugende Schreckschraube"));
+  QCOMPARE(entry->field("subtitle"), QString::fromUtf8("und andere Storys vom Schöpfer der Scheibenwelt"));
+  QCOMPARE(entry->field("author"), QStringLiteral("Pratchett, Terry"));
+  QCOMPARE(entry->field("publisher"), QStringLiteral("Piper"));
+  QCOMPARE(entry->field("address"), QString::fromUtf8("München"));
+  QCOMPARE(entry->field("pub_year"), QStringLiteral("2018"));
+  QCOMPARE(entry->field("dewey"), QStringLiteral("K"));
+  // the last ISBN in the record is used
+  QCOMPARE(entry->field("isbn"), QStringLiteral("3-492-28157-5"));
+  QCOMPARE(entry->field("language"), QStringLiteral("German; English"));
 }
 
 void MarcTest::testWidget() {
@@ -37,6 +37,8 @@
 
 #include <QTest>
 #include <QDomDocument>
+#include <QTemporaryFile>
+#include <QDir>
 
 QTEST_APPLESS_MAIN( ModsTest )
 
@@ -107,3 +109,30 @@ void ModsTest::testLocaleEncoding() {
   QVERIFY(Tellico::localeEncodingName() != QByteArray("Locale"));
   QVERIFY(dom.toString().contains(Tellico::localeEncodingName()));
 }
+
+// the XSLT result tree is normally read directly, but a stylesheet which disables output
+// escaping has to have its output parsed as text
+void ModsTest::testUnescapedOutput() {
+  const QByteArray xslt(
+    "<xsl:stylesheet xmlns:xsl=\"http://www.w3.org/1999/XSL/Transform\" version=\"1.0\">"
+    "  <xsl:output method=\"xml\" encoding=\"UTF-8\"/>"
+    "  <xsl:template match=\"/\">"
+    "    <xsl:text disable-output-escaping=\"yes\">&lt;tellico xmlns=\"http://periapsis.org/tellico/\" syntaxVersion=\"11\"&gt;"
+    "&lt;collection title=\"Unescaped\" type=\"2\"&gt;&lt;fields&gt;&lt;field name=\"_default\"/&gt;&lt;/fields&gt;"
+    "&lt;entry&gt;&lt;title&gt;Unescaped Title&lt;/title&gt;&lt;/entry&gt;&lt;/collection&gt;&lt;/tellico&gt;</xsl:text>"
+    "  </xsl:template>"
+    "</xsl:stylesheet>");
+  QTemporaryFile xsltFile(QDir::tempPath() + QStringLiteral("/modstest_XXXXXX.xsl"));
+  QVERIFY(xsltFile.open());
+  xsltFile.write(xslt);
+  xsltFile.close();
+
+  Tellico::Import::XSLTImporter importer(QStringLiteral("<a/>"));
+  importer.setXSLTURL(QUrl::fromLocalFile(xsltFile.fileName()));
+
+  Tellico::Data::CollPtr coll = importer.collection();
+  QVERIFY(coll);
+  QCOMPARE(coll->title(), QStringLiteral("Unescaped"));
+  QCOMPARE(coll->entryCount(), 1);
+  QCOMPARE(coll->entries().at(0)->title(), QStringLiteral("Unescaped Title"));
+}
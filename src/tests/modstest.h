@@ -35,6 +35,7 @@ private Q_SLOTS:
   void testBook();
   void testDNBMARCXML();
   void testLocaleEncoding();
+  void testUnescapedOutput();
 };
 
 #endif
@@ -0,0 +1,143 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#undef QT_NO_CAST_FROM_ASCII
+
+#include "networkreplaytest.h"
+
+#include "../core/networkreplay.h"
+
+#include <QTest>
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+
+QTEST_GUILESS_MAIN( NetworkReplayTest )
+
+namespace {
+  void writeResponse(const QString& fileName, const QByteArray& data) {
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(data);
+  }
+}
+
+void NetworkReplayTest::initTestCase() {
+  QVERIFY(m_dir.isValid());
+}
+
+void NetworkReplayTest::cleanup() {
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Off);
+  Tellico::NetworkReplay::setLatency(0);
+  Tellico::NetworkReplay::setBandwidth(0);
+}
+
+void NetworkReplayTest::testResponseFile() {
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, m_dir.path());
+  const QString file1 = Tellico::NetworkReplay::responseFile("GET", QUrl(QStringLiteral("https://example.com/search?q=title&apikey=1234")));
+  const QString file2 = Tellico::NetworkReplay::responseFile("GET", QUrl(QStringLiteral("https://example.com/search?q=title&apikey=5678")));
+  const QString file3 = Tellico::NetworkReplay::responseFile("GET", QUrl(QStringLiteral("https://example.com/search?q=title")));
+  // the api key is not part of the match
+  QCOMPARE(file1, file2);
+  QCOMPARE(file1, file3);
+  QVERIFY(file1.startsWith(m_dir.path() + QStringLiteral("/example.com/")));
+
+  const QString file4 = Tellico::NetworkReplay::responseFile("GET", QUrl(QStringLiteral("https://example.com/search?q=other")));
+  QVERIFY(file1 != file4);
+  // the method and the posted data are part of the match
+  const QString file5 = Tellico::NetworkReplay::responseFile("POST", QUrl(QStringLiteral("https://example.com/search?q=title")));
+  const QString file6 = Tellico::NetworkReplay::responseFile("POST", QUrl(QStringLiteral("https://example.com/search?q=title")), "{}");
+  QVERIFY(file1 != file5);
+  QVERIFY(file5 != file6);
+}
+
+void NetworkReplayTest::testReplay() {
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, m_dir.path());
+  const QUrl url(QStringLiteral("https://example.com/isbn/0789312239?key=private"));
+  writeResponse(Tellico::NetworkReplay::responseFile("GET", url), "<?xml version=\"1.0\"?><result/>");
+
+  KIO::StoredTransferJob* job = Tellico::NetworkReplay::storedGet(url);
+  QVERIFY(job->exec());
+  QCOMPARE(job->data(), QByteArray("<?xml version=\"1.0\"?><result/>"));
+
+  const QByteArray payload("{\"query\":\"title\"}");
+  writeResponse(Tellico::NetworkReplay::responseFile("POST", url, payload), "{\"results\":[]}");
+  job = Tellico::NetworkReplay::storedHttpPost(payload, url);
+  QVERIFY(job->exec());
+  QCOMPARE(job->data(), QByteArray("{\"results\":[]}"));
+}
+
+void NetworkReplayTest::testRecord() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Record, dir.path());
+  // a data url goes through KIO like any other request, without a network
+  const QUrl url(QStringLiteral("data:text/plain,recorded%20response"));
+  KIO::StoredTransferJob* job = Tellico::NetworkReplay::storedGet(url);
+  QVERIFY(job->exec());
+  QCOMPARE(job->data(), QByteArray("recorded response"));
+
+  const QString fileName = Tellico::NetworkReplay::responseFile("GET", url);
+  QVERIFY(fileName.startsWith(dir.path()));
+  QVERIFY(QFile::exists(fileName));
+  QVERIFY(QFile::exists(fileName.left(fileName.size() - 4) + QStringLiteral("json")));
+
+  // the recorded response is played back
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, dir.path());
+  job = Tellico::NetworkReplay::storedGet(url);
+  QVERIFY(job->exec());
+  QCOMPARE(job->data(), QByteArray("recorded response"));
+
+  // a failed request is not recorded
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Record, dir.path());
+  const QUrl badUrl(QStringLiteral("tellico-no-such-protocol://example.com/missing"));
+  job = Tellico::NetworkReplay::storedGet(badUrl);
+  QVERIFY(!job->exec());
+  QVERIFY(!QFile::exists(Tellico::NetworkReplay::responseFile("GET", badUrl)));
+}
+
+void NetworkReplayTest::testMissing() {
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, m_dir.path());
+  // a request which was never recorded fails instead of going to the network
+  KIO::StoredTransferJob* job = Tellico::NetworkReplay::storedGet(QUrl(QStringLiteral("https://example.com/missing")));
+  QVERIFY(!job->exec());
+  QVERIFY(job->error() != 0);
+}
+
+void NetworkReplayTest::testLatency() {
+  Tellico::NetworkReplay::setMode(Tellico::NetworkReplay::Replay, m_dir.path());
+  const QUrl url(QStringLiteral("https://example.com/slow"));
+  // 20 kilobytes at 100 kilobytes per second takes 200 milliseconds
+  writeResponse(Tellico::NetworkReplay::responseFile("GET", url), QByteArray(20 * 1024, 'x'));
+  Tellico::NetworkReplay::setLatency(100);
+  Tellico::NetworkReplay::setBandwidth(100);
+
+  QElapsedTimer timer;
+  timer.start();
+  KIO::StoredTransferJob* job = Tellico::NetworkReplay::storedGet(url);
+  QVERIFY(job->exec());
+  QVERIFY(timer.elapsed() >= 300);
+  QCOMPARE(job->data().size(), 20 * 1024);
+}
@@ -0,0 +1,223 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "syntheticcollection.h"
+
+#include "../collection.h"
+#include "../collectionfactory.h"
+#include "../entry.h"
+#include "../field.h"
+#include "../fieldformat.h"
+#include "../images/imagefactory.h"
+
+#include <QImage>
+#include <QDate>
+#include <QColor>
+
+#include <cmath>
+
+namespace {
+  static const int SYNTHETIC_WORD_COUNT = 2000;
+  static const int SYNTHETIC_PEOPLE_COUNT = 5000;
+  static const int SYNTHETIC_IMAGE_COUNT = 200;
+  // percent of the optional fields which are left empty
+  static const int SYNTHETIC_EMPTY_PERCENT = 25;
+  static const char* const SYNTHETIC_SYLLABLES[] = {
+    "an", "bel", "cor", "da", "el", "fan", "gor", "hil", "is", "jun", "ka", "lo", "mar", "nor",
+    "o", "pel", "qua", "ros", "sen", "tur", "u", "val", "wen", "xi", "yor", "zan"
+  };
+  static const int SYNTHETIC_SYLLABLE_COUNT = sizeof(SYNTHETIC_SYLLABLES) / sizeof(SYNTHETIC_SYLLABLES[0]);
+}
+
+SyntheticCollection::SyntheticCollection(quint32 seed_) : m_random(seed_), m_serial(0) {
+  auto makeWord = [this](int syllables) {
+    QString word;
+    for(int i = 0; i < syllables; ++i) {
+      word += QLatin1String(SYNTHETIC_SYLLABLES[m_random.bounded(SYNTHETIC_SYLLABLE_COUNT)]);
+    }
+    return word;
+  };
+  for(int i = 0; i < SYNTHETIC_WORD_COUNT; ++i) {
+    m_words += makeWord(1 + m_random.bounded(3));
+  }
+  for(int i = 0; i < SYNTHETIC_PEOPLE_COUNT; ++i) {
+    QString first = makeWord(2);
+    QString last = makeWord(2 + m_random.bounded(2));
+    first[0] = first.at(0).toUpper();
+    last[0] = last.at(0).toUpper();
+    m_people += first + QLatin1Char(' ') + last;
+  }
+}
+
+Tellico::Data::CollPtr SyntheticCollection::create(int type_, int entryCount_, bool withImages_) {
+  Tellico::Data::CollPtr coll = Tellico::CollectionFactory::collection(type_, true);
+  if(!coll) {
+    return coll;
+  }
+  coll->setTitle(QStringLiteral("Synthetic %1 Collection").arg(Tellico::CollectionFactory::typeName(type_)));
+  coll->addEntries(createEntries(coll, entryCount_, withImages_));
+  return coll;
+}
+
+Tellico::Data::EntryList SyntheticCollection::createEntries(Tellico::Data::CollPtr coll_, int entryCount_, bool withImages_) {
+  Tellico::Data::FieldList fields;
+  for(const auto& field : coll_->fields()) {
+    // the id and dates are set by the collection, derived values can't be set
+    if(!field->hasFlag(Tellico::Data::Field::Derived) && !field->hasFlag(Tellico::Data::Field::NoEdit)) {
+      fields += field;
+    }
+  }
+  Tellico::Data::EntryList entries;
+  entries.reserve(entryCount_);
+  for(int i = 0; i < entryCount_; ++i) {
+    Tellico::Data::EntryPtr entry(new Tellico::Data::Entry(coll_));
+    for(const auto& field : std::as_const(fields)) {
+      const QString text = value(field, withImages_);
+      if(!text.isEmpty()) {
+        entry->loadField(field, text);
+      }
+    }
+    entries += entry;
+  }
+  return entries;
+}
+
+QString SyntheticCollection::value(Tellico::Data::FieldPtr field_, bool withImages_) {
+  using Tellico::Data::Field;
+  if(field_->type() == Field::Image) {
+    return withImages_ && chance(70) ? image() : QString();
+  }
+  if(field_->name() == QLatin1String("title")) {
+    // titles repeat sometimes, but most are unique
+    ++m_serial;
+    return chance(90) ? words(1 + m_random.bounded(4)) + QLatin1Char(' ') + QString::number(m_serial)
+                      : words(1 + m_random.bounded(3));
+  }
+  if(chance(SYNTHETIC_EMPTY_PERCENT)) {
+    return QString();
+  }
+  if(field_->type() == Field::Table) {
+    const int columns = qMax(1, field_->property(QStringLiteral("columns")).toInt());
+    QStringList rows;
+    const int rowCount = 1 + m_random.bounded(4);
+    for(int i = 0; i < rowCount; ++i) {
+      QStringList values;
+      for(int j = 0; j < columns; ++j) {
+        values += j == 0 ? words(1 + m_random.bounded(3)) : pick(m_people);
+      }
+      rows += values.join(Tellico::FieldFormat::columnDelimiterString());
+    }
+    return rows.join(Tellico::FieldFormat::rowDelimiterString());
+  }
+  if(field_->hasFlag(Field::AllowMultiple) && field_->type() != Field::Choice) {
+    // most have a single value, some have a few
+    const int count = chance(70) ? 1 : 2 + m_random.bounded(3);
+    QStringList values;
+    for(int i = 0; i < count; ++i) {
+      values += singleValue(field_);
+    }
+    values.removeDuplicates();
+    return values.join(Tellico::FieldFormat::delimiterString());
+  }
+  return singleValue(field_);
+}
+
+QString SyntheticCollection::singleValue(Tellico::Data::FieldPtr field_) {
+  using Tellico::Data::Field;
+  switch(field_->type()) {
+    case Field::Para:
+      {
+        QStringList sentences;
+        const int count = 1 + m_random.bounded(6);
+        for(int i = 0; i < count; ++i) {
+          QString sentence = words(5 + m_random.bounded(15));
+          sentence[0] = sentence.at(0).toUpper();
+          sentences += sentence + QLatin1Char('.');
+        }
+        return sentences.join(QLatin1Char(' '));
+      }
+    case Field::Choice:
+      return field_->allowed().isEmpty() ? QString() : pick(field_->allowed());
+    case Field::Bool:
+      return chance(30) ? QStringLiteral("true") : QString();
+    case Field::Number:
+      if(field_->name().contains(QLatin1String("year"))) {
+        // more recent years are more common
+        return QString::number(2025 - static_cast<int>(std::pow(m_random.generateDouble(), 2) * 125));
+      }
+      return QString::number(1 + static_cast<int>(std::pow(m_random.generateDouble(), 3) * 1000));
+    case Field::URL:
+      return QStringLiteral("https://example.com/%1/%2").arg(words(1)).arg(m_random.bounded(100000));
+    case Field::Date:
+      return QDate(1950, 1, 1).addDays(m_random.bounded(27000)).toString(Qt::ISODate);
+    case Field::Rating:
+      {
+        const int min = field_->property(QStringLiteral("minimum")).toInt();
+        const int max = qMax(min, field_->property(QStringLiteral("maximum")).toInt());
+        return QString::number(min + m_random.bounded(max - min + 1));
+      }
+    default:
+      break;
+  }
+  if(field_->formatType() == Tellico::FieldFormat::FormatName) {
+    return pick(m_people);
+  }
+  if(field_->formatType() == Tellico::FieldFormat::FormatTitle) {
+    return words(1 + m_random.bounded(4));
+  }
+  return words(1 + m_random.bounded(2));
+}
+
+// skewed towards the start of the list, so a few values are very common
+QString SyntheticCollection::pick(const QStringList& values_) {
+  const int index = static_cast<int>(std::pow(m_random.generateDouble(), 3) * values_.size());
+  return values_.at(qBound(0, index, static_cast<int>(values_.size()) - 1));
+}
+
+QString SyntheticCollection::words(int count_) {
+  QStringList list;
+  for(int i = 0; i < count_; ++i) {
+    list += pick(m_words);
+  }
+  return list.join(QLatin1Char(' '));
+}
+
+QString SyntheticCollection::image() {
+  if(m_imageIds.size() < SYNTHETIC_IMAGE_COUNT) {
+    QImage img(120, 160, QImage::Format_RGB32);
+    img.fill(QColor::fromHsv(m_random.bounded(360), 128 + m_random.bounded(128), 128 + m_random.bounded(128)));
+    for(int y = 0; y < img.height(); y += 8) {
+      for(int x = 0; x < img.width(); ++x) {
+        img.setPixel(x, y, m_random.generate() | 0xFF000000);
+      }
+    }
+    m_imageIds += Tellico::ImageFactory::addImage(img, QStringLiteral("PNG"));
+    return m_imageIds.last();
+  }
+  return m_imageIds.at(m_random.bounded(m_imageIds.size()));
+}
+
+bool SyntheticCollection::chance(int percent_) {
+  return m_random.bounded(100) < percent_;
+}
@@ -0,0 +1,73 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SYNTHETICCOLLECTION_H
+#define SYNTHETICCOLLECTION_H
+
+#include "../datavectors.h"
+
+#include <QRandomGenerator>
+#include <QStringList>
+
+/**
+ * Creates collections of any size with made up values, for benchmarks.
+ *
+ * The same seed always creates the same collection. The values are not uniform, a few
+ * people, publishers, and genres are used much more often than the rest, like in a real
+ * collection, and some of the fields are left empty.
+ */
+class SyntheticCollection {
+public:
+  explicit SyntheticCollection(quint32 seed = 1);
+
+  /**
+   * Creates a collection with the default fields of the type.
+   *
+   * @param type The collection type
+   * @param entryCount The number of entries
+   * @param withImages Whether the image fields get values. A limited set of images is shared
+   * by the entries, and the images are added to the image factory
+   */
+  Tellico::Data::CollPtr create(int type, int entryCount, bool withImages = false);
+  /**
+   * Creates more entries in an existing collection, using the same values
+   */
+  Tellico::Data::EntryList createEntries(Tellico::Data::CollPtr coll, int entryCount, bool withImages = false);
+
+private:
+  QString value(Tellico::Data::FieldPtr field, bool withImages);
+  QString singleValue(Tellico::Data::FieldPtr field);
+  QString pick(const QStringList& values);
+  QString words(int count);
+  QString image();
+  bool chance(int percent);
+
+  QRandomGenerator m_random;
+  int m_serial;
+  QStringList m_words;
+  QStringList m_people;
+  QStringList m_imageIds;
+};
+
+#endif
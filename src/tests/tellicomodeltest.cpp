@@ -187,6 +187,46 @@ void TellicoModelTest::testFilterModel() {
   filterModel.invalidate(filterModel.index(0, 0));
   QCOMPARE(filter, filterModel.filter(filterModel.index(0, 0)));
   QVERIFY(filterModel.indexContainsEntry(filterModel.index(0, 0), entry1));
+  QCOMPARE(filterModel.rowCount(filterModel.index(0, 0)), 1);
+
+  // only the changed entries get checked against the filter
+  Tellico::Data::EntryPtr entry2(new Tellico::Data::Entry(c));
+  entry2->setField(QStringLiteral("title"), QStringLiteral("Empire Strikes Back"));
+  c->addEntries(entry2);
+  filterModel.addEntries(Tellico::Data::EntryList() << entry2);
+  QVERIFY(!filterModel.indexContainsEntry(filterModel.index(0, 0), entry2));
+  QCOMPARE(filterModel.rowCount(filterModel.index(0, 0)), 1);
+
+  entry2->setField(QStringLiteral("title"), QStringLiteral("Star Wars"));
+  filterModel.modifyEntries(Tellico::Data::EntryList() << entry2);
+  QVERIFY(filterModel.indexContainsEntry(filterModel.index(0, 0), entry2));
+  QCOMPARE(filterModel.rowCount(filterModel.index(0, 0)), 2);
+
+  entry1->setField(QStringLiteral("title"), QStringLiteral("Return of the Jedi"));
+  filterModel.modifyEntries(Tellico::Data::EntryList() << entry1);
+  QVERIFY(!filterModel.indexContainsEntry(filterModel.index(0, 0), entry1));
+  QCOMPARE(filterModel.rowCount(filterModel.index(0, 0)), 1);
+
+  c->removeEntries(Tellico::Data::EntryList() << entry2);
+  filterModel.removeEntries(Tellico::Data::EntryList() << entry2);
+  QVERIFY(!filterModel.indexContainsEntry(filterModel.index(0, 0), entry2));
+  QCOMPARE(filterModel.rowCount(filterModel.index(0, 0)), 0);
+
+  // contiguous rows are removed together
+  Tellico::Data::EntryList entries;
+  for(int i = 0; i < 3; ++i) {
+    Tellico::Data::EntryPtr entry(new Tellico::Data::Entry(c));
+    entry->setField(QStringLiteral("title"), QStringLiteral("Star Wars"));
+    entries += entry;
+  }
+  c->addEntries(entries);
+  filterModel.addEntries(entries);
+  QCOMPARE(filterModel.rowCount(filterModel.index(0, 0)), 3);
+  QSignalSpy removedSpy(&filterModel, &QAbstractItemModel::rowsRemoved);
+  c->removeEntries(entries);
+  filterModel.removeEntries(entries);
+  QCOMPARE(removedSpy.count(), 1);
+  QCOMPARE(filterModel.rowCount(filterModel.index(0, 0)), 0);
 }
 
 void TellicoModelTest::testGroupModel() {
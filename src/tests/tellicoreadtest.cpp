@@ -26,6 +26,7 @@
 #include "tellicoreadtest.h"
 
 #include "../translators/tellicoimporter.h"
+#include "../translators/tellicosnapshot.h"
 #include "../collections/bookcollection.h"
 #include "../collections/bibtexcollection.h"
 #include "../collections/coincollection.h"
@@ -51,6 +52,8 @@
 #include <QStringEncoder>
 #include <QStandardPaths>
 #include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QDataStream>
 
 QTEST_GUILESS_MAIN( TellicoReadTest )
 
@@ -742,3 +745,67 @@ void TellicoReadTest::testRemote() {
   Tellico::ImageFactory::removeImage(image, true);
   QVERIFY(!QFile::exists(imageFileName));
 }
+
+void TellicoReadTest::testSnapshot() {
+  // copy the file so its modification time can be changed
+  QTemporaryDir dir;
+  const QString fileName = dir.path() + QSL("/bibtex-format11.tc");
+  QVERIFY(QFile::copy(QFINDTESTDATA("data/bibtex-format11.tc"), fileName));
+  QUrl url = QUrl::fromLocalFile(fileName);
+  QVERIFY(!Tellico::Import::TellicoSnapshot::read(url));
+
+  Tellico::Import::TellicoImporter importer(url);
+  importer.setUseSnapshot(true);
+  Tellico::Data::CollPtr coll1 = importer.collection();
+  QVERIFY(coll1);
+  QVERIFY(QFile::exists(Tellico::Import::TellicoSnapshot::snapshotFile(url)));
+
+  Tellico::Data::CollPtr coll2 = Tellico::Import::TellicoSnapshot::read(url);
+  QVERIFY(coll2);
+  QCOMPARE(coll2->type(), coll1->type());
+  QCOMPARE(coll2->title(), coll1->title());
+  QCOMPARE(coll2->fields().count(), coll1->fields().count());
+  QCOMPARE(coll2->entryCount(), coll1->entryCount());
+  QCOMPARE(coll2->filters().count(), coll1->filters().count());
+  QCOMPARE(coll2->borrowers().count(), coll1->borrowers().count());
+  foreach(Tellico::Data::FieldPtr field1, coll1->fields()) {
+    Tellico::Data::FieldPtr field2 = coll2->fieldByName(field1->name());
+    QVERIFY(field2);
+    QCOMPARE(field2->title(), field1->title());
+    QCOMPARE(field2->category(), field1->category());
+    QCOMPARE(field2->type(), field1->type());
+    QCOMPARE(field2->flags(), field1->flags());
+    QCOMPARE(field2->propertyList(), field1->propertyList());
+  }
+  foreach(Tellico::Data::EntryPtr entry1, coll1->entries()) {
+    Tellico::Data::EntryPtr entry2 = coll2->entryById(entry1->id());
+    QVERIFY(entry2);
+    foreach(Tellico::Data::FieldPtr field, coll1->fields()) {
+      QCOMPARE(entry2->field(field->name()), entry1->field(field));
+    }
+  }
+  auto bibtex1 = static_cast<Tellico::Data::BibtexCollection*>(coll1.data());
+  auto bibtex2 = static_cast<Tellico::Data::BibtexCollection*>(coll2.data());
+  QCOMPARE(bibtex2->preamble(), bibtex1->preamble());
+  QCOMPARE(bibtex2->macroList(), bibtex1->macroList());
+
+  // once the file changes, the snapshot is out of date
+  QFile file(fileName);
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.setFileTime(QDateTime::currentDateTime().addDays(1), QFileDevice::FileModificationTime));
+  file.close();
+  QVERIFY(!Tellico::Import::TellicoSnapshot::read(url));
+
+  // a snapshot from an older version is removed the next time one is written
+  const QString oldSnapshot = QFileInfo(Tellico::Import::TellicoSnapshot::snapshotFile(url)).absolutePath()
+                            + QSL("/old.snapshot");
+  QFile oldFile(oldSnapshot);
+  QVERIFY(oldFile.open(QIODevice::WriteOnly));
+  QDataStream out(&oldFile);
+  out << quint32(0x54435350) << qint32(1);
+  oldFile.close();
+  QVERIFY(Tellico::Import::TellicoSnapshot::write(url, coll1));
+  QVERIFY(!QFile::exists(oldSnapshot));
+  QVERIFY(Tellico::Import::TellicoSnapshot::read(url));
+  Tellico::Import::TellicoSnapshot::remove(url);
+}
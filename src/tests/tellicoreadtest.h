@@ -63,6 +63,7 @@ private Q_SLOTS:
   void testEmoji();
   void testXmlWithJunk();
   void testRemote();
+  void testSnapshot();
 
 private:
   QList<Tellico::Data::CollPtr> m_collections;
@@ -0,0 +1,120 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#undef QT_NO_CAST_FROM_ASCII
+
+#include "tracertest.h"
+
+#include "../core/tracer.h"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+QTEST_GUILESS_MAIN( TracerTest )
+
+void TracerTest::testDisabled() {
+  QVERIFY(!Tellico::Tracer::isEnabled());
+  {
+    TRACE_ZONE("test", "zone");
+  }
+  // stopping without starting writes nothing
+  QVERIFY(!Tellico::Tracer::self()->stop());
+}
+
+void TracerTest::testTrace() {
+  QTemporaryDir dir;
+  const QString traceFile = dir.filePath(QStringLiteral("trace.json"));
+  Tellico::Tracer* tracer = Tellico::Tracer::self();
+  tracer->start(traceFile);
+  QVERIFY(Tellico::Tracer::isEnabled());
+  QCOMPARE(tracer->fileName(), traceFile);
+
+  {
+    Tellico::TraceZone zone("test", "outer");
+    zone.setArgument(QStringLiteral("argument"));
+    TRACE_ZONE("test", "inner");
+    QThread::msleep(2);
+  }
+  TRACE_COUNTER("test", "counter", 42);
+  // an async span can end on a different thread
+  tracer->asyncBegin("test", "span", 7);
+  QThread* thread = QThread::create([tracer]() {
+    TRACE_ZONE("test", "thread");
+    tracer->asyncEnd("test", "span", 7);
+  });
+  thread->setObjectName(QStringLiteral("worker"));
+  thread->start();
+  QVERIFY(thread->wait());
+  delete thread;
+
+  QVERIFY(tracer->stop());
+  QVERIFY(!Tellico::Tracer::isEnabled());
+  // events after stopping are not recorded
+  {
+    TRACE_ZONE("test", "ignored");
+  }
+
+  QFile file(traceFile);
+  QVERIFY(file.open(QIODevice::ReadOnly));
+  QJsonParseError error;
+  const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+  QCOMPARE(error.error, QJsonParseError::NoError);
+  const QJsonArray events = doc.object().value(QStringLiteral("traceEvents")).toArray();
+
+  QHash<QString, QJsonObject> eventsByName;
+  QStringList threadNames;
+  for(const auto& value : events) {
+    const QJsonObject obj = value.toObject();
+    const QString name = obj.value(QStringLiteral("name")).toString();
+    if(name == QLatin1String("thread_name")) {
+      threadNames += obj.value(QStringLiteral("args")).toObject().value(QStringLiteral("name")).toString();
+    } else if(obj.value(QStringLiteral("ph")).toString() != QLatin1String("M")) {
+      eventsByName.insert(name + obj.value(QStringLiteral("ph")).toString(), obj);
+    }
+  }
+  QVERIFY(threadNames.contains(QStringLiteral("worker")));
+  QCOMPARE(eventsByName.count(), 6);
+  QVERIFY(!eventsByName.contains(QStringLiteral("ignoredX")));
+
+  const QJsonObject outer = eventsByName.value(QStringLiteral("outerX"));
+  const QJsonObject inner = eventsByName.value(QStringLiteral("innerX"));
+  QCOMPARE(outer.value(QStringLiteral("cat")).toString(), QStringLiteral("test"));
+  QCOMPARE(outer.value(QStringLiteral("args")).toObject().value(QStringLiteral("arg")).toString(), QStringLiteral("argument"));
+  // the inner zone is inside the outer one, and the times are in microseconds
+  QVERIFY(inner.value(QStringLiteral("dur")).toDouble() >= 2000);
+  QVERIFY(outer.value(QStringLiteral("ts")).toDouble() <= inner.value(QStringLiteral("ts")).toDouble());
+  QVERIFY(outer.value(QStringLiteral("dur")).toDouble() >= inner.value(QStringLiteral("dur")).toDouble());
+
+  QCOMPARE(eventsByName.value(QStringLiteral("counterC")).value(QStringLiteral("args")).toObject().value(QStringLiteral("value")).toInt(), 42);
+
+  const QJsonObject begin = eventsByName.value(QStringLiteral("spanb"));
+  const QJsonObject end = eventsByName.value(QStringLiteral("spane"));
+  QCOMPARE(begin.value(QStringLiteral("id")).toString(), end.value(QStringLiteral("id")).toString());
+  QVERIFY(begin.value(QStringLiteral("tid")).toInt() != end.value(QStringLiteral("tid")).toInt());
+  QCOMPARE(eventsByName.value(QStringLiteral("threadX")).value(QStringLiteral("tid")).toInt(), end.value(QStringLiteral("tid")).toInt());
+}
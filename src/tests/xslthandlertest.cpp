@@ -0,0 +1,165 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#undef QT_NO_CAST_FROM_ASCII
+
+#include "xslthandlertest.h"
+
+#include "../translators/xslthandler.h"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDomDocument>
+#include <QDateTime>
+
+QTEST_GUILESS_MAIN( XSLTHandlerTest )
+
+namespace {
+  static const char* XSLT_TEMPLATE =
+    "<xsl:stylesheet xmlns:xsl=\"http://www.w3.org/1999/XSL/Transform\" version=\"1.0\">"
+    "<xsl:output method=\"text\"/>"
+    "<xsl:param name=\"prefix\" select=\"'none'\"/>"
+    "<xsl:template match=\"/\">%1:<xsl:value-of select=\"$prefix\"/>:<xsl:value-of select=\"/doc\"/></xsl:template>"
+    "</xsl:stylesheet>";
+
+  static const QString INPUT = QStringLiteral("<doc>text</doc>");
+
+  bool writeStylesheet(const QString& fileName_, const QString& version_) {
+    QFile file(fileName_);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      return false;
+    }
+    file.write(QString::fromLatin1(XSLT_TEMPLATE).arg(version_).toUtf8());
+    return true;
+  }
+}
+
+void XSLTHandlerTest::cleanup() {
+  Tellico::XSLTHandler::clearCache();
+}
+
+void XSLTHandlerTest::testParams() {
+  QTemporaryDir dir;
+  const QString xsltFile = dir.filePath(QStringLiteral("test.xsl"));
+  QVERIFY(writeStylesheet(xsltFile, QStringLiteral("v1")));
+
+  // both handlers use the same compiled stylesheet but have their own parameters
+  Tellico::XSLTHandler handler1(QFile::encodeName(xsltFile));
+  Tellico::XSLTHandler handler2(QUrl::fromLocalFile(xsltFile));
+  QVERIFY(handler1.isValid());
+  QVERIFY(handler2.isValid());
+  handler1.addStringParam("prefix", "one");
+  QCOMPARE(handler1.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:one:text"));
+  QCOMPARE(handler2.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:none:text"));
+  handler2.addStringParam("prefix", "two");
+  QCOMPARE(handler2.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:two:text"));
+  QCOMPARE(handler1.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:one:text"));
+}
+
+void XSLTHandlerTest::testModifiedFile() {
+  QTemporaryDir dir;
+  const QString xsltFile = dir.filePath(QStringLiteral("test.xsl"));
+  QVERIFY(writeStylesheet(xsltFile, QStringLiteral("v1")));
+  QFile file(xsltFile);
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(-60), QFileDevice::FileModificationTime));
+  file.close();
+
+  Tellico::XSLTHandler handler1(QFile::encodeName(xsltFile));
+  QCOMPARE(handler1.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:none:text"));
+
+  // a newer file is compiled again, the old handler keeps the old stylesheet
+  QVERIFY(writeStylesheet(xsltFile, QStringLiteral("v2")));
+  Tellico::XSLTHandler handler2(QFile::encodeName(xsltFile));
+  QCOMPARE(handler2.applyStylesheet(INPUT).trimmed(), QStringLiteral("v2:none:text"));
+  QCOMPARE(handler1.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:none:text"));
+}
+
+void XSLTHandlerTest::testModifiedImport() {
+  QTemporaryDir dir;
+  const QString importFile = dir.filePath(QStringLiteral("import.xsl"));
+  QVERIFY(writeStylesheet(importFile, QStringLiteral("v1")));
+  QFile file(importFile);
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(-60), QFileDevice::FileModificationTime));
+  file.close();
+
+  const QString xsltFile = dir.filePath(QStringLiteral("test.xsl"));
+  QFile mainFile(xsltFile);
+  QVERIFY(mainFile.open(QIODevice::WriteOnly));
+  mainFile.write("<xsl:stylesheet xmlns:xsl=\"http://www.w3.org/1999/XSL/Transform\" version=\"1.0\">"
+                 "<xsl:import href=\"import.xsl\"/>"
+                 "</xsl:stylesheet>");
+  mainFile.close();
+
+  Tellico::XSLTHandler handler1(QFile::encodeName(xsltFile));
+  QCOMPARE(handler1.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:none:text"));
+
+  // the top-level file is the same, but the imported one is newer
+  QVERIFY(writeStylesheet(importFile, QStringLiteral("v2")));
+  Tellico::XSLTHandler handler2(QFile::encodeName(xsltFile));
+  QCOMPARE(handler2.applyStylesheet(INPUT).trimmed(), QStringLiteral("v2:none:text"));
+}
+
+void XSLTHandlerTest::testDocument() {
+  QTemporaryDir dir;
+  const QString xsltFile = dir.filePath(QStringLiteral("test.xsl"));
+  QVERIFY(writeStylesheet(xsltFile, QStringLiteral("v1")));
+
+  QDomDocument dom1;
+  QVERIFY(dom1.setContent(QString::fromLatin1(XSLT_TEMPLATE).arg(QStringLiteral("dom1"))));
+  QDomDocument dom2;
+  QVERIFY(dom2.setContent(QString::fromLatin1(XSLT_TEMPLATE).arg(QStringLiteral("dom2"))));
+
+  // the same file name with different documents must not share a stylesheet
+  Tellico::XSLTHandler handler1(dom1, QFile::encodeName(xsltFile));
+  Tellico::XSLTHandler handler2(dom2, QFile::encodeName(xsltFile));
+  Tellico::XSLTHandler handler3(dom1, QFile::encodeName(xsltFile), true /*translate*/);
+  QCOMPARE(handler1.applyStylesheet(INPUT).trimmed(), QStringLiteral("dom1:none:text"));
+  QCOMPARE(handler2.applyStylesheet(INPUT).trimmed(), QStringLiteral("dom2:none:text"));
+  QCOMPARE(handler3.applyStylesheet(INPUT).trimmed(), QStringLiteral("dom1:none:text"));
+
+  handler1.setXSLTDoc(dom2, QFile::encodeName(xsltFile));
+  QCOMPARE(handler1.applyStylesheet(INPUT).trimmed(), QStringLiteral("dom2:none:text"));
+}
+
+void XSLTHandlerTest::testClearCache() {
+  QTemporaryDir dir;
+  const QString xsltFile = dir.filePath(QStringLiteral("test.xsl"));
+  QVERIFY(writeStylesheet(xsltFile, QStringLiteral("v1")));
+
+  auto handler1 = new Tellico::XSLTHandler(QFile::encodeName(xsltFile));
+  QVERIFY(handler1->isValid());
+  // the handler still works after the cache no longer holds its stylesheet
+  Tellico::XSLTHandler::clearCache();
+  QCOMPARE(handler1->applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:none:text"));
+  delete handler1;
+
+  // with no handlers left and an empty cache, everything starts over
+  Tellico::XSLTHandler::clearCache();
+  Tellico::XSLTHandler handler2(QFile::encodeName(xsltFile));
+  QVERIFY(handler2.isValid());
+  QCOMPARE(handler2.applyStylesheet(INPUT).trimmed(), QStringLiteral("v1:none:text"));
+}
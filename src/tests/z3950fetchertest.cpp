@@ -27,12 +27,17 @@
 #include "z3950fetchertest.h"
 
 #include "../fetch/z3950fetcher.h"
+#include "../fetch/z3950connection.h"
 #include "../collections/bookcollection.h"
 #include "../collectionfactory.h"
 #include "../entry.h"
 #include "../utils/datafileregistry.h"
 
 #include <QTest>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
 
 QTEST_GUILESS_MAIN( Z3950FetcherTest )
 
@@ -142,3 +147,64 @@ void Z3950FetcherTest::testPortugal() {
   QCOMPARE(entry->field(QStringLiteral("title")).toUtf8(), QString::fromUtf8("Memórias póstumas de Brás Cubas").toUtf8());
   QCOMPARE(entry->field(QStringLiteral("author")), QStringLiteral("Assis, Machado de"));
 }
+
+void Z3950FetcherTest::testConnectionPool() {
+  // yaz-ztest is the test server which comes with YAZ
+  const QString ztest = QStandardPaths::findExecutable(QStringLiteral("yaz-ztest"));
+  if(ztest.isEmpty()) {
+    QSKIP("This test requires yaz-ztest");
+  }
+  // find a free port for the server
+  QTcpServer portFinder;
+  QVERIFY(portFinder.listen(QHostAddress::LocalHost));
+  const quint16 port = portFinder.serverPort();
+  portFinder.close();
+
+  QProcess server;
+  server.start(ztest, {QStringLiteral("@:%1").arg(port)});
+  QVERIFY(server.waitForStarted());
+  // wait until the server is listening
+  auto serverListening = [port]() {
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    return socket.waitForConnected(100);
+  };
+  QTRY_VERIFY_WITH_TIMEOUT(serverListening(), 5000);
+  Tellico::Fetch::Z3950Connection::closeIdleConnections();
+
+  Tellico::Fetch::FetchRequest request(Tellico::Data::Collection::Book, Tellico::Fetch::Raw,
+                                       QStringLiteral("@attr 1=4 computer"));
+  Tellico::Fetch::Fetcher::Ptr fetcher1(new Tellico::Fetch::Z3950Fetcher(this,
+                                                                         QStringLiteral("localhost"),
+                                                                         port,
+                                                                         QStringLiteral("Default"),
+                                                                         QStringLiteral("usmarc")));
+  doFetch(fetcher1, request);
+  // the connection is kept open after the search
+  QCOMPARE(Tellico::Fetch::Z3950Connection::idleConnectionCount(), 1);
+
+  // a second fetcher for the same server reuses the open connection
+  Tellico::Fetch::Fetcher::Ptr fetcher2(new Tellico::Fetch::Z3950Fetcher(this,
+                                                                         QStringLiteral("localhost"),
+                                                                         port,
+                                                                         QStringLiteral("Default"),
+                                                                         QStringLiteral("usmarc")));
+  doFetch(fetcher2, request);
+  QCOMPARE(Tellico::Fetch::Z3950Connection::idleConnectionCount(), 1);
+
+  // the test server only has the Default database, so the search fails and
+  // the connection with the error is closed instead of going back to the pool
+  Tellico::Fetch::Fetcher::Ptr fetcher3(new Tellico::Fetch::Z3950Fetcher(this,
+                                                                         QStringLiteral("localhost"),
+                                                                         port,
+                                                                         QStringLiteral("Missing"),
+                                                                         QStringLiteral("usmarc")));
+  Tellico::Data::EntryList results = doFetch(fetcher3, request);
+  QVERIFY(results.isEmpty());
+  QCOMPARE(Tellico::Fetch::Z3950Connection::idleConnectionCount(), 1);
+
+  Tellico::Fetch::Z3950Connection::closeIdleConnections();
+  QCOMPARE(Tellico::Fetch::Z3950Connection::idleConnectionCount(), 0);
+  server.terminate();
+  server.waitForFinished();
+}
@@ -39,6 +39,7 @@ private Q_SLOTS:
   void testADS();
   void testBibsysIsbn();
   void testPortugal();
+  void testConnectionPool();
 };
 
 #endif
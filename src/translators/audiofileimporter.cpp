@@ -25,6 +25,7 @@
 #include <config.h>
 
 #include "audiofileimporter.h"
+#include "translators.h"
 #include "../collections/musiccollection.h"
 #include "../entry.h"
 #include "../field.h"
@@ -53,12 +54,19 @@
 #include <QGroupBox>
 #include <QCheckBox>
 #include <QDir>
+#include <QSet>
+#include <QMimeDatabase>
 #include <QTextStream>
+#include <QVector>
+#include <QAtomicInt>
 #include <QVBoxLayout>
 #include <QApplication>
 
 #ifdef HAVE_TAGLIB
 namespace {
+  // the number of files read by each worker thread at a time
+  static const int AUDIO_READ_BATCH_SIZE = 64;
+
   bool hasValue(const TagLib::PropertyMap& pmap, const char* key) {
     const TagLib::String keyString(key);
     return pmap.contains(keyString) && !pmap[keyString].isEmpty();
@@ -70,24 +78,80 @@ namespace {
             TStringToQString(pmap[keyString].front()).trimmed() :
             QString();
   }
+
+  // the file locations are in the first column of the file table
+  QStringList entryFiles(Tellico::Data::EntryPtr entry_) {
+    QStringList files;
+    const QStringList rows = Tellico::FieldFormat::splitTable(entry_->field(QStringLiteral("file")));
+    for(const QString& row : rows) {
+      const QString file = Tellico::FieldFormat::splitRow(row).value(0);
+      if(!file.isEmpty()) {
+        files += file;
+      }
+    }
+    return files;
+  }
+
+  // the modified date of the entry is only known to the day, so any file modified on that day
+  // or later is read again
+  bool isUnchanged(Tellico::Data::EntryPtr entry_, const QString& file_) {
+    const QDate mdate = QDate::fromString(entry_->field(QStringLiteral("mdate")), Qt::ISODate);
+    const QDate fileDate = QFileInfo(file_).lastModified().date();
+    return mdate.isValid() && fileDate.isValid() && fileDate < mdate;
+  }
 }
 #endif
 
 using Tellico::Import::AudioFileImporter;
 
+// the tags read from a single file, with everything needed to add the track to its album
+struct AudioFileImporter::TrackData {
+  bool isRead = false;
+  bool hasTitle = false;
+  QString album;
+  QString albumArtist;
+  QString artist;
+  QString title;
+  QString year;
+  QString genre;
+  QString label;
+  QString media;
+  QString comment;
+  int disc = 1;
+  int trackNum = 0;
+  int length = 0;
+  int bitrate = 0;
+};
+
 AudioFileImporter::AudioFileImporter(const QUrl& url_) : Tellico::Import::Importer(url_)
     , m_widget(nullptr)
     , m_recursive(nullptr)
     , m_addFilePath(nullptr)
     , m_addBitrate(nullptr)
     , m_cancelled(false)
+    , m_update(false)
     , m_audioOptions(0) {
 }
 
+AudioFileImporter::~AudioFileImporter() {
+  m_readerPool.clear();
+  m_readerPool.waitForDone();
+}
+
 bool AudioFileImporter::canImport(int type) const {
   return type == Data::Collection::Album;
 }
 
+bool AudioFileImporter::canUpdate() const {
+  // the existing entries can only be matched to the files when the file locations were included
+  Data::CollPtr c = currentCollection();
+  return c && c->type() == Data::Collection::Album && c->hasField(QStringLiteral("file"));
+}
+
+void AudioFileImporter::slotActionChanged(int action_) {
+  m_update = (action_ == Import::Update);
+}
+
 void AudioFileImporter::setRecursive(bool recursive_) {
   if(recursive_) {
     m_audioOptions |= Recursive;
@@ -164,6 +228,19 @@ Tellico::Data::CollPtr AudioFileImporter::collection() {
     return Data::CollPtr();
   }
 
+  QHash<QString, Data::EntryPtr> existingEntries;
+  UpdateResult result;
+  bool updating = false;
+  if(m_update && canUpdate()) {
+    updating = true;
+    foreach(Data::EntryPtr entry, currentCollection()->entries()) {
+      foreach(const QString& file, entryFiles(entry)) {
+        existingEntries.insert(file, entry);
+      }
+    }
+    files = filesToUpdate(files, existingEntries, result.missingEntries);
+  }
+
 //  myLog() << "audiofileimporter: total number of files:" << files.count();
   item.setTotalSteps(files.count());
 
@@ -178,7 +255,9 @@ Tellico::Data::CollPtr AudioFileImporter::collection() {
 
   m_coll = new Data::MusicCollection(true);
 
-  const bool addFile = m_audioOptions & AddFilePath;
+  // when updating, the file locations are needed to match the new entries the next time, too,
+  // but that doesn't change the option itself
+  const bool addFile = updating || (m_audioOptions & AddFilePath);
   const bool addBitrate = m_audioOptions & AddBitrate;
 
   Data::FieldPtr f;
@@ -204,28 +283,47 @@ Tellico::Data::CollPtr AudioFileImporter::collection() {
   QStringList directoryFiles;
   const uint stepSize = qMax(1, files.count() / 100);
 
+  // the tags are read by the worker threads, in batches, and each result goes in the same
+  // position as the file so the albums are built in the same order as the files are listed
+  QVector<TrackData> tracks(files.count());
+  TrackData* trackData = tracks.data();
+  QAtomicInt tracksRead;
+  for(int i = 0; i < files.count(); i += AUDIO_READ_BATCH_SIZE) {
+    const int last = qMin(i + AUDIO_READ_BATCH_SIZE, files.count());
+    m_readerPool.start([this, &files, trackData, &tracksRead, i, last]() {
+      for(int k = i; k < last; ++k) {
+        readTrack(files.at(k), trackData[k]);
+        tracksRead.ref();
+      }
+    });
+  }
+  while(!m_readerPool.waitForDone(100)) {
+    if(showProgress) {
+      ProgressManager::self()->setProgress(this, tracksRead.loadRelaxed());
+      qApp->processEvents();
+    }
+  }
+
   bool changeTrackTitle = true;
   uint j = 0;
-  for(QStringList::ConstIterator it = files.constBegin(); !m_cancelled && it != files.constEnd(); ++it, ++j) {
-    TagLib::FileRef f(QFile::encodeName(*it).data());
-    if(f.isNull() || !f.tag() || !f.file()) {
-      if((*it).endsWith(QLatin1String("/.directory"))) {
-        directoryFiles += *it;
+  for(int i = 0; !m_cancelled && i < files.count(); ++i, ++j) {
+    const QString& filePath = files.at(i);
+    const TrackData& trackInfo = tracks.at(i);
+    if(!trackInfo.isRead) {
+      if(filePath.endsWith(QLatin1String("/.directory"))) {
+        directoryFiles += filePath;
         if(showProgress) ProgressManager::self()->setTotalSteps(this, files.count() + directoryFiles.count());
       }
       continue;
     }
 
-    TagLib::PropertyMap pmap = f.file()->properties();
-    pmap.removeEmpty();
-    TagLib::Tag* tag = f.tag();
-    QString album = TStringToQString(tag->album()).trimmed();
+    const QString& album = trackInfo.album;
     if(album.isEmpty()) {
       // can't do anything since tellico entries are by album
-      myWarning() << "Skipping: no album listed for " << *it;
+      myWarning() << "Skipping: no album listed for " << filePath;
       continue;
     }
-    int disc = discNumber(f);
+    const int disc = trackInfo.disc;
     if(disc > 1 && !m_coll->hasField(QStringLiteral("track%1").arg(disc))) {
       Data::FieldPtr f2(new Data::Field(QStringLiteral("track%1").arg(disc),
                                         i18n("Tracks (Disc %1)", disc),
@@ -255,38 +353,7 @@ Tellico::Data::CollPtr AudioFileImporter::collection() {
     "<album title>" if not.
 */
     QString albumKey = album.toLower();
-/*
-    For MP3 files, get the Album Artist from the ID3v2 TPE2 frame.
-    See http://www.id3.org/id3v2.4.0-frames for a description of this frame.
-    Although this is not standard in ID3, using a specific frame for album
-    artist is a solution to the problem of tagging albums that feature
-    various artists but still have an identified Album Artist, such as
-    Remix and DJ albums. Example:
-    Album title: Some Title; Album artist: Some DJ;
-                 Track 1: Some Track Title - Some Artist(s);
-                 Track 2: Some Other Track Title - Some Other Artist(s), etc.
-    We read the Album Artist from the TPE2 frame to be compatible with
-    Amarok as the most popular music player by KDE, but also Apple (iTunes),
-    Microsoft (Windows Media Player) and others which use this frame to
-    read/write the album artist too.
-    See Amarok source file src/collectionscanner/CollectionScanner.cpp,
-    method AttributeHash CollectionScanner::readTags(...).
-*/
-    // TODO: find another way for non-MP3 files
-    QString albumArtist;
-/*  As mpeg implementation on TagLib uses a Tag class that's not defined on the headers,
-    we have to cast the files, not the tags!
-*/
-    TagLib::MPEG::File* mpegFile = dynamic_cast<TagLib::MPEG::File*>(f.file());
-    if(mpegFile && mpegFile->ID3v2Tag() && !mpegFile->ID3v2Tag()->frameListMap()["TPE2"].isEmpty()) {
-      albumArtist = TStringToQString(mpegFile->ID3v2Tag()->frameListMap()["TPE2"].front()->toString()).trimmed();
-    }
-    if(albumArtist.isEmpty()) {
-      albumArtist = tagValue(pmap, "ALBUMARTIST");
-    }
-    if(albumArtist.isEmpty()) {
-      albumArtist = tagValue(pmap, "ALBUMARTISTSORT");
-    }
+    const QString& albumArtist = trackInfo.albumArtist;
     if(!albumArtist.isEmpty()) {
       albumKey += FieldFormat::columnDelimiterString() + albumArtist.toLower();
     }
@@ -299,13 +366,7 @@ Tellico::Data::CollPtr AudioFileImporter::collection() {
     }
     // album entries use the album name as the title
     entry->setField(title, album);
-    QString a = TStringToQString(tag->artist()).trimmed();
-    if(a.isEmpty()) {
-      a = tagValue(pmap, "ArtistSort");
-    }
-    if(a.isEmpty()) {
-      a = tagValue(pmap, "Artists");
-    }
+    const QString& a = trackInfo.artist;
     // If no album artist identified, we use track artist as album artist, or "(Various)" if tracks have various artists.
     if(!albumArtist.isEmpty()) {
       entry->setField(artist, albumArtist);
@@ -317,123 +378,95 @@ Tellico::Data::CollPtr AudioFileImporter::collection() {
         entry->setField(artist, a);
       }
     }
-    if(tag->year() > 0) {
-      entry->setField(year, QString::number(tag->year()));
-    } else if(hasValue(pmap, "OriginalYear")) {
-      entry->setField(year, TStringToQString(pmap["OriginalYear"].front()));
+    if(!trackInfo.year.isEmpty()) {
+      entry->setField(year, trackInfo.year);
     }
-
-    if(!tag->genre().isEmpty()) {
-      entry->setField(genre, TStringToQString(tag->genre()).trimmed());
+    if(!trackInfo.genre.isEmpty()) {
+      entry->setField(genre, trackInfo.genre);
     }
-    if(hasValue(pmap, "Label")) {
-      entry->setField(label, TStringToQString(pmap["Label"].front()));
+    if(!trackInfo.label.isEmpty()) {
+      entry->setField(label, trackInfo.label);
     }
-    if(hasValue(pmap, "Media")) {
-      const QString media = TStringToQString(pmap["Media"].front());
-      if(media == QLatin1String("CD")) {
+    if(!trackInfo.media.isEmpty()) {
+      if(trackInfo.media == QLatin1String("CD")) {
         entry->setField(QLatin1String("medium"), i18n("Compact Disc"));
       } else {
-        entry->setField(QLatin1String("medium"), media);
+        entry->setField(QLatin1String("medium"), trackInfo.media);
       }
     }
 
-    QFileInfo fi(*it);
+    QFileInfo fi(filePath);
     const QString dirName = fi.dir().canonicalPath();
     if(!directoryAlbumHash.contains(dirName)) {
       directoryAlbumHash.insert(dirName, albumKey);
     }
 
-    if(!tag->title().isEmpty()) {
-      int trackNum = tag->track();
-      if(trackNum <= 0) { // try to figure out track number from file name
-        const QString fileName = fi.baseName();
-        QString numString;
-        int i = 0;
-        const int len = fileName.length();
-        while(i < len && fileName[i].isNumber()) {
-          i++;
-        }
-        if(i == 0) { // does not start with a number
-          i = len - 1;
-          while(i >= 0 && fileName[i].isNumber()) {
-            i--;
-          }
-          // file name ends with a number
-          if(i != len - 1) {
-            numString = fileName.mid(i + 1);
-          }
-        } else {
-          numString = fileName.mid(0, i);
-        }
-        bool ok;
-        int number = numString.toInt(&ok);
-        if(ok) {
-          trackNum = number;
-        }
-      }
+    if(trackInfo.hasTitle) {
+      const int trackNum = trackInfo.trackNum;
       if(trackNum > 0) {
-        TagLib::AudioProperties* audioProps = f.audioProperties();
-        Q_ASSERT(audioProps);
-        QString t = TStringToQString(tag->title()).trimmed();
+        QString t = trackInfo.title;
         t += FieldFormat::columnDelimiterString() + a;
-        int len = audioProps->lengthInSeconds();
-        if(len == 0) len = audioProps->lengthInMilliseconds() / 1000;
-        if(len > 0) {
-          t += FieldFormat::columnDelimiterString() + Tellico::minutes(len);
+        if(trackInfo.length > 0) {
+          t += FieldFormat::columnDelimiterString() + Tellico::minutes(trackInfo.length);
         }
         QString realTrack = disc > 1 ? track + QString::number(disc) : track;
         entry->setField(realTrack, insertValue(entry->field(realTrack), t, trackNum));
         if(addFile) {
-          QString fileValue = *it;
+          QString fileValue = filePath;
           if(addBitrate) {
-            // for Vorbis, prefer the nominal bitrate (which is bytes/sec, where bitrate() is kb/s)
-            TagLib::Vorbis::Properties* vorbisProps = dynamic_cast<TagLib::Vorbis::Properties*>(audioProps);
-            const int bitrate = vorbisProps ? vorbisProps->bitrateNominal()/1000 : audioProps->bitrate();
-            fileValue += FieldFormat::columnDelimiterString() + QString::number(bitrate);
+            fileValue += FieldFormat::columnDelimiterString() + QString::number(trackInfo.bitrate);
           }
           entry->setField(file, insertValue(entry->field(file), fileValue, trackNum));
         }
       } else {
-        myDebug() << *it << " contains no track number and track number cannot be determined, so the track is not imported.";
+        myDebug() << filePath << " contains no track number and track number cannot be determined, so the track is not imported.";
       }
     } else {
-      myDebug() << *it << " has an empty title, so the track is not imported.";
+      myDebug() << filePath << " has an empty title, so the track is not imported.";
     }
-    if(!tag->comment().stripWhiteSpace().isEmpty()) {
+    if(!trackInfo.comment.isEmpty()) {
       QString c = entry->field(comments);
       if(!c.isEmpty()) {
         c += QLatin1String("<br/>");
       }
-      if(!tag->title().isEmpty()) {
-        c += QLatin1String("<em>") + TStringToQString(tag->title()).trimmed() + QLatin1String("</em> - ");
+      if(trackInfo.hasTitle) {
+        c += QLatin1String("<em>") + trackInfo.title + QLatin1String("</em> - ");
       }
-      c += TStringToQString(tag->comment().stripWhiteSpace());
+      c += trackInfo.comment;
       entry->setField(comments, c);
     }
 
     if(!exists) {
       entriesToAdd << entry;
     }
-    if(showProgress && j%stepSize == 0) {
-      ProgressManager::self()->setProgress(this, j);
-      qApp->processEvents();
-    }
-
-/*    myDebug() << "-- TAG --";
-    myDebug() << "title   - \"" << TStringToQString(tag->title())   << "\"";
-    myDebug() << "artist  - \"" << TStringToQString(tag->artist())  << "\"";
-    myDebug() << "album   - \"" << TStringToQString(tag->album())   << "\"";
-    myDebug() << "year    - \"" << tag->year()                      << "\"";
-    myDebug() << "comment - \"" << TStringToQString(tag->comment()) << "\"";
-    myDebug() << "track   - \"" << tag->track()                     << "\"";
-    myDebug() << "genre   - \"" << TStringToQString(tag->genre())   << "\"";*/
   }
 
   if(m_cancelled) {
     m_coll = Data::CollPtr();
     return m_coll;
   }
+  if(!existingEntries.isEmpty()) {
+    // the rebuilt albums replace the existing entries which had any of the same files
+    QSet<Data::ID> updatedIds;
+    for(auto it = entriesToAdd.begin(); it != entriesToAdd.end(); ) {
+      Data::EntryPtr existingEntry;
+      foreach(const QString& file, entryFiles(*it)) {
+        existingEntry = existingEntries.value(file);
+        if(existingEntry) {
+          break;
+        }
+      }
+      if(existingEntry && !updatedIds.contains(existingEntry->id())) {
+        updatedIds.insert(existingEntry->id());
+        result.modifiedEntries += qMakePair(existingEntry, *it);
+        it = entriesToAdd.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  setUpdateResult(result);
+
 //  myLog() << "++ Adding" << entriesToAdd.count() << "entries";
   m_coll->addEntries(entriesToAdd);
 
@@ -480,6 +513,206 @@ Tellico::Data::CollPtr AudioFileImporter::collection() {
 #endif
 }
 
+#ifdef HAVE_TAGLIB
+// this is called from the worker threads, so it only touches the file and the track data
+void AudioFileImporter::readTrack(const QString& file_, TrackData& track_) const {
+  TagLib::FileRef f(QFile::encodeName(file_).data());
+  if(f.isNull() || !f.tag() || !f.file()) {
+    return;
+  }
+  track_.isRead = true;
+
+  TagLib::PropertyMap pmap = f.file()->properties();
+  pmap.removeEmpty();
+  TagLib::Tag* tag = f.tag();
+  track_.album = TStringToQString(tag->album()).trimmed();
+  if(track_.album.isEmpty()) {
+    return;
+  }
+  track_.disc = discNumber(f);
+/*
+    For MP3 files, get the Album Artist from the ID3v2 TPE2 frame.
+    See http://www.id3.org/id3v2.4.0-frames for a description of this frame.
+    Although this is not standard in ID3, using a specific frame for album
+    artist is a solution to the problem of tagging albums that feature
+    various artists but still have an identified Album Artist, such as
+    Remix and DJ albums. Example:
+    Album title: Some Title; Album artist: Some DJ;
+                 Track 1: Some Track Title - Some Artist(s);
+                 Track 2: Some Other Track Title - Some Other Artist(s), etc.
+    We read the Album Artist from the TPE2 frame to be compatible with
+    Amarok as the most popular music player by KDE, but also Apple (iTunes),
+    Microsoft (Windows Media Player) and others which use this frame to
+    read/write the album artist too.
+    See Amarok source file src/collectionscanner/CollectionScanner.cpp,
+    method AttributeHash CollectionScanner::readTags(...).
+*/
+  // TODO: find another way for non-MP3 files
+/*  As mpeg implementation on TagLib uses a Tag class that's not defined on the headers,
+    we have to cast the files, not the tags!
+*/
+  TagLib::MPEG::File* mpegFile = dynamic_cast<TagLib::MPEG::File*>(f.file());
+  if(mpegFile && mpegFile->ID3v2Tag() && !mpegFile->ID3v2Tag()->frameListMap()["TPE2"].isEmpty()) {
+    track_.albumArtist = TStringToQString(mpegFile->ID3v2Tag()->frameListMap()["TPE2"].front()->toString()).trimmed();
+  }
+  if(track_.albumArtist.isEmpty()) {
+    track_.albumArtist = tagValue(pmap, "ALBUMARTIST");
+  }
+  if(track_.albumArtist.isEmpty()) {
+    track_.albumArtist = tagValue(pmap, "ALBUMARTISTSORT");
+  }
+
+  track_.artist = TStringToQString(tag->artist()).trimmed();
+  if(track_.artist.isEmpty()) {
+    track_.artist = tagValue(pmap, "ArtistSort");
+  }
+  if(track_.artist.isEmpty()) {
+    track_.artist = tagValue(pmap, "Artists");
+  }
+  if(tag->year() > 0) {
+    track_.year = QString::number(tag->year());
+  } else if(hasValue(pmap, "OriginalYear")) {
+    track_.year = TStringToQString(pmap["OriginalYear"].front());
+  }
+  if(!tag->genre().isEmpty()) {
+    track_.genre = TStringToQString(tag->genre()).trimmed();
+  }
+  if(hasValue(pmap, "Label")) {
+    track_.label = TStringToQString(pmap["Label"].front());
+  }
+  if(hasValue(pmap, "Media")) {
+    track_.media = TStringToQString(pmap["Media"].front());
+  }
+
+  track_.hasTitle = !tag->title().isEmpty();
+  track_.title = TStringToQString(tag->title()).trimmed();
+  if(track_.hasTitle) {
+    int trackNum = tag->track();
+    if(trackNum <= 0) { // try to figure out track number from file name
+      const QString fileName = QFileInfo(file_).baseName();
+      QString numString;
+      int i = 0;
+      const int len = fileName.length();
+      while(i < len && fileName[i].isNumber()) {
+        i++;
+      }
+      if(i == 0) { // does not start with a number
+        i = len - 1;
+        while(i >= 0 && fileName[i].isNumber()) {
+          i--;
+        }
+        // file name ends with a number
+        if(i != len - 1) {
+          numString = fileName.mid(i + 1);
+        }
+      } else {
+        numString = fileName.mid(0, i);
+      }
+      bool ok;
+      int number = numString.toInt(&ok);
+      if(ok) {
+        trackNum = number;
+      }
+    }
+    track_.trackNum = trackNum;
+    if(trackNum > 0) {
+      TagLib::AudioProperties* audioProps = f.audioProperties();
+      Q_ASSERT(audioProps);
+      track_.length = audioProps->lengthInSeconds();
+      if(track_.length == 0) track_.length = audioProps->lengthInMilliseconds() / 1000;
+      // for Vorbis, prefer the nominal bitrate (which is bytes/sec, where bitrate() is kb/s)
+      TagLib::Vorbis::Properties* vorbisProps = dynamic_cast<TagLib::Vorbis::Properties*>(audioProps);
+      track_.bitrate = vorbisProps ? vorbisProps->bitrateNominal()/1000 : audioProps->bitrate();
+    }
+  }
+  if(!tag->comment().stripWhiteSpace().isEmpty()) {
+    track_.comment = TStringToQString(tag->comment().stripWhiteSpace());
+  }
+}
+
+// Only the folders with new or modified audio files are read again, along with any other folders
+// with tracks from the same albums, so that the albums are complete
+QStringList AudioFileImporter::filesToUpdate(const QStringList& files_,
+                                             const QHash<QString, Data::EntryPtr>& existingEntries_,
+                                             Data::EntryList& missingEntries_) const {
+  QMimeDatabase db;
+  QSet<QString> listedFiles;
+  QHash<QString, QStringList> filesByDir;
+  QSet<QString> updateDirs;
+  for(const QString& file : files_) {
+    listedFiles.insert(file);
+    filesByDir[QFileInfo(file).path()] += file;
+    if(!db.mimeTypeForFile(file, QMimeDatabase::MatchExtension).name().startsWith(QLatin1String("audio/"))) {
+      continue;
+    }
+    Data::EntryPtr entry = existingEntries_.value(file);
+    if(!entry || !isUnchanged(entry, file)) {
+      updateDirs.insert(QFileInfo(file).path());
+    }
+  }
+
+  const QString rootDir = QFileInfo(url().toLocalFile()).absoluteFilePath() + QLatin1Char('/');
+  const bool recursive = m_audioOptions & Recursive;
+  QHash<Data::ID, QStringList> filesById;
+  QSet<Data::ID> missingIds;
+  foreach(Data::EntryPtr entry, existingEntries_) {
+    if(filesById.contains(entry->id()) || missingIds.contains(entry->id())) {
+      continue;
+    }
+    const QStringList albumFiles = entryFiles(entry);
+    QStringList remainingFiles;
+    bool isListed = true;
+    foreach(const QString& file, albumFiles) {
+      // files outside of the imported folder are never missing
+      isListed = isListed && file.startsWith(rootDir) &&
+                 (recursive || file.indexOf(QLatin1Char('/'), rootDir.length()) == -1);
+      if(listedFiles.contains(file)) {
+        remainingFiles += file;
+      }
+    }
+    if(remainingFiles.isEmpty()) {
+      if(isListed) {
+        missingIds.insert(entry->id());
+        missingEntries_ += entry;
+      }
+      continue;
+    }
+    if(remainingFiles.count() < albumFiles.count()) {
+      // some tracks were removed so the album has to be read again
+      updateDirs.insert(QFileInfo(remainingFiles.first()).path());
+    }
+    filesById.insert(entry->id(), remainingFiles);
+  }
+
+  // keep adding the folders of any other tracks from the albums in the updated folders
+  QStringList dirQueue(updateDirs.constBegin(), updateDirs.constEnd());
+  while(!dirQueue.isEmpty()) {
+    const QString dir = dirQueue.takeFirst();
+    foreach(const QString& file, filesByDir.value(dir)) {
+      Data::EntryPtr entry = existingEntries_.value(file);
+      if(!entry) {
+        continue;
+      }
+      foreach(const QString& albumFile, filesById.value(entry->id())) {
+        const QString albumDir = QFileInfo(albumFile).path();
+        if(!updateDirs.contains(albumDir)) {
+          updateDirs.insert(albumDir);
+          dirQueue += albumDir;
+        }
+      }
+    }
+  }
+
+  QStringList files;
+  for(const QString& file : files_) {
+    if(updateDirs.contains(QFileInfo(file).path())) {
+      files += file;
+    }
+  }
+  return files;
+}
+#endif
+
 QWidget* AudioFileImporter::widget(QWidget* parent_) {
   if(m_widget) {
     return m_widget;
@@ -532,6 +765,7 @@ QString AudioFileImporter::insertValue(const QString& str_, const QString& value
 
 void AudioFileImporter::slotCancel() {
   m_cancelled = true;
+  m_readerPool.clear();
 }
 
 void AudioFileImporter::slotAddFileToggled(bool on_) {
@@ -30,6 +30,9 @@ class QCheckBox;
 #include "importer.h"
 #include "../datavectors.h"
 
+#include <QHash>
+#include <QThreadPool>
+
 namespace TagLib {
   class FileRef;
 }
@@ -40,6 +43,12 @@ namespace Tellico {
 /**
  * The AudioFileImporter class takes care of importing audio files.
  *
+ * The tags are read from the files by a pool of worker threads, and the albums are built
+ * from the results afterwards, in the same order as the files are listed.
+ *
+ * When updating the current collection, only the albums with new, modified, or removed
+ * tracks are read again. The existing entries are matched by the file locations.
+ *
  * @author Robby Stephenson
  */
 class AudioFileImporter : public Importer {
@@ -55,6 +64,7 @@ public:
   /**
    */
   AudioFileImporter(const QUrl& url);
+  ~AudioFileImporter();
 
   /**
    */
@@ -63,19 +73,27 @@ public:
    */
   virtual QWidget* widget(QWidget* parent) override;
   virtual bool canImport(int type) const override;
+  virtual bool canUpdate() const override;
 
   void setRecursive(bool recursive);
   void setAddFilePath(bool addFilePath);
   void setAddBitrate(bool addBitrate);
 
 public Q_SLOTS:
+  void slotActionChanged(int action) override;
   void slotCancel() override;
   void slotAddFileToggled(bool on);
 
 private:
+  struct TrackData;
+
   static QString insertValue(const QString& str, const QString& value, int pos);
 
   int discNumber(const TagLib::FileRef& file) const;
+  void readTrack(const QString& file, TrackData& track) const;
+  QStringList filesToUpdate(const QStringList& files,
+                            const QHash<QString, Data::EntryPtr>& existingEntries,
+                            Data::EntryList& missingEntries) const;
 
   Data::CollPtr m_coll;
   QWidget* m_widget;
@@ -83,7 +101,9 @@ private:
   QCheckBox* m_addFilePath;
   QCheckBox* m_addBitrate;
   bool m_cancelled;
+  bool m_update;
   int m_audioOptions;
+  QThreadPool m_readerPool;
 };
 
   } // end namespace
@@ -52,8 +52,31 @@ void bt_cleanup() {}
 void bt_initialize() {}
 #endif
 
+namespace {
+  static const int BIBTEX_BATCH_SIZE = 1000;
+}
+
 int BibtexImporter::s_initCount = 0;
 
+// a single node from the bibtex text, copied from the btparse AST so it can be
+// converted by the worker threads after the node is freed
+struct BibtexImporter::BibtexRecord {
+  struct Value {
+    QByteArray text;
+    bool isMacro;
+  };
+  struct Field {
+    QString name;
+    QList<Value> values;
+    QString value;
+  };
+  int metaType = 0;
+  QString entryType;
+  QString key;
+  QString text; // the preamble text or the macro name
+  QList<Field> fields;
+};
+
 BibtexImporter::BibtexImporter(const QList<QUrl>& urls_) : Importer(urls_)
     , m_widget(nullptr), m_readUTF8(nullptr), m_readLocale(nullptr), m_cancelled(false) {
   init();
@@ -65,6 +88,8 @@ BibtexImporter::BibtexImporter(const QString& text_) : Importer(text_)
 }
 
 BibtexImporter::~BibtexImporter() {
+  m_convertPool.clear();
+  m_convertPool.waitForDone();
   --s_initCount;
   if(s_initCount == 0) {
     bt_cleanup();
@@ -144,18 +169,15 @@ Tellico::Data::CollPtr BibtexImporter::readCollection(const QString& text, int u
   Data::CollPtr ptr(new Data::BibtexCollection(true));
   Data::BibtexCollection* c = static_cast<Data::BibtexCollection*>(ptr.data());
 
-  parseText(text); // populates m_nodes
-  if(m_cancelled) {
-    return Data::CollPtr();
-  }
+  m_macros.clear();
+  // for regular nodes (entries), do NOT convert numbers to strings, do NOT expand macros
+  bt_set_stringopts(BTE_REGULAR, 0);
+  bt_set_stringopts(BTE_MACRODEF, 0);
+//  bt_set_stringopts(BTE_PREAMBLE, BTO_CONVERT | BTO_EXPAND);
 
-  if(m_nodes.isEmpty()) {
-    return Data::CollPtr();
-  }
+  // the translation maps have to be loaded before any of the worker threads convert text
+  BibtexHandler::loadTranslationMaps();
 
-  QString str;
-  const uint count = m_nodes.count();
-  const uint stepSize = qMax(s_stepSize, count/100);
   const bool showProgress = options() & ImportProgress;
 
   Data::CollPtr currentColl = currentCollection();
@@ -163,172 +185,232 @@ Tellico::Data::CollPtr BibtexImporter::readCollection(const QString& text, int u
     currentColl = ptr;
   }
 
-  uint j = 0;
-  for(int i = 0; !m_cancelled && i < m_nodes.count(); ++i, ++j) {
-    AST* node = m_nodes[i];
-    // if we're parsing a macro string, comment or preamble, skip it for now
-    if(bt_entry_metatype(node) == BTE_PREAMBLE) {
-      char* preamble = bt_get_text(node);
-      if(preamble) {
-        c->setPreamble(QString::fromUtf8(preamble));
-      }
+  // btparse is not thread-safe, so the text is parsed in batches on this thread and only
+  // the text conversion of the field values is done by the worker threads
+  QList<BibtexRecord> records;
+  QStringList macroNames;
+  bool foundNodes = false;
+  int pos = 0;
+  int line = 1;
+  while(!m_cancelled && pos < text.length()) {
+    records.clear();
+    parseText(text, pos, line, records);
+    if(records.isEmpty()) {
       continue;
     }
-
-    if(bt_entry_metatype(node) == BTE_MACRODEF) {
-      char* macro;
-      (void) bt_next_field(node, nullptr, &macro);
-      // FIXME: replace macros within macro definitions!
-      // lookup lowercase macro in map
-      c->addMacro(m_macros[QString::fromUtf8(macro)], QString::fromUtf8(bt_macro_text(macro, nullptr, 0)));
-      continue;
+    foundNodes = true;
+
+    BibtexRecord* recordData = records.data();
+    const int recordCount = records.count();
+    const int batchSize = qMax(1, recordCount / qMax(1, m_convertPool.maxThreadCount()));
+    for(int i = 0; i < recordCount; i += batchSize) {
+      const int last = qMin(i + batchSize, recordCount);
+      m_convertPool.start([recordData, i, last]() {
+        for(int k = i; k < last; ++k) {
+          convertRecord(recordData[k]);
+        }
+      });
     }
-
-    if(bt_entry_metatype(node) == BTE_COMMENT) {
-      continue;
+    m_convertPool.waitForDone();
+    if(m_cancelled) {
+      break;
     }
 
-    // now we're parsing a regular entry
-    Data::EntryPtr entry(new Data::Entry(ptr));
-
-    str = QString::fromUtf8(bt_entry_type(node));
-//    myDebug() << "entry type: " << str;
-    // text is automatically put into lower-case by btparse
-    Data::BibtexCollection::setFieldValue(entry, QStringLiteral("entry-type"), str, currentColl);
-
-    str = QString::fromUtf8(bt_entry_key(node));
-//    myDebug() << "entry key: " << str;
-    Data::BibtexCollection::setFieldValue(entry, QStringLiteral("key"), str, currentColl);
-
-    static const QRegularExpression andRx(QLatin1String("\\sand\\s"));
-    char* name;
-    AST* field = nullptr;
-    while((field = bt_next_field(node, field, &name))) {
-//      myDebug() << "\tfound: " << name;
-//      str = QLatin1String(bt_get_text(field));
-      str.clear();
-      AST* value = nullptr;
-      bt_nodetype type;
-      char* svalue;
-      bool end_macro = false;
-      while((value = bt_next_value(field, value, &type, &svalue))) {
-        switch(type) {
-          case BTAST_STRING:
-          case BTAST_NUMBER:
-            str += BibtexHandler::importText(svalue).simplified();
-            end_macro = false;
-            break;
-          case BTAST_MACRO:
-            str += QString::fromUtf8(svalue) + QLatin1Char('#');
-            end_macro = true;
-            break;
-          default:
-            break;
-        }
+    Data::EntryList entries;
+    for(const auto& record : std::as_const(records)) {
+      switch(record.metaType) {
+        case BTE_PREAMBLE:
+          if(!record.text.isNull()) {
+            c->setPreamble(record.text);
+          }
+          continue;
+        case BTE_MACRODEF:
+          // the macro text is read once the whole file is parsed
+          macroNames += record.text;
+          continue;
+        case BTE_COMMENT:
+          continue;
+        default:
+          break;
       }
-      if(end_macro) {
-        // remove last character '#'
-        str.truncate(str.length() - 1);
-      }
-      QString fieldName = QString::fromUtf8(name);
-      if(fieldName == QLatin1String("author") || fieldName == QLatin1String("editor")) {
-        str.replace(andRx,FieldFormat::delimiterString());
-      }
-      // there's a 'key' field different from the citation key
-      // https://nwalsh.com/tex/texhelp/bibtx-37.html
-      // TODO account for this later
-      if(fieldName == QLatin1String("key")) {
-        myLog() << "skipping bibtex 'key' field for" << str;
-      } else {
-        Data::BibtexCollection::setFieldValue(entry, fieldName, str, currentColl);
+
+      // now we're parsing a regular entry
+      Data::EntryPtr entry(new Data::Entry(ptr));
+      // text is automatically put into lower-case by btparse
+      Data::BibtexCollection::setFieldValue(entry, QStringLiteral("entry-type"), record.entryType, currentColl);
+      Data::BibtexCollection::setFieldValue(entry, QStringLiteral("key"), record.key, currentColl);
+      for(const auto& field : record.fields) {
+        // there's a 'key' field different from the citation key
+        // https://nwalsh.com/tex/texhelp/bibtx-37.html
+        // TODO account for this later
+        if(field.name == QLatin1String("key")) {
+          myLog() << "skipping bibtex 'key' field for" << field.value;
+        } else {
+          Data::BibtexCollection::setFieldValue(entry, field.name, field.value, currentColl);
+        }
       }
+      entries += entry;
     }
+    ptr->addEntries(entries);
 
-    ptr->addEntries(entry);
-
-    if(showProgress && j%stepSize == 0) {
-      Q_EMIT signalProgress(this, urlCount*100 + 100*j/count);
+    if(showProgress) {
+      Q_EMIT signalProgress(this, urlCount*100 + static_cast<int>(100LL*pos/text.length()));
       qApp->processEvents();
     }
   }
 
-  if(m_cancelled) {
-    ptr = nullptr;
+  if(foundNodes) {
+    // clean up some structures
+    bt_parse_entry_s(nullptr, nullptr, 1, 0, nullptr);
   }
 
-  // clean-up
-  foreach(AST* node, m_nodes) {
-    bt_free_ast(node);
+  if(m_cancelled || !foundNodes) {
+    return Data::CollPtr();
+  }
+
+  // the macro definitions are only read at the end, so a macro that is
+  // defined more than once gets the last value in the file
+  foreach(const QString& macro, macroNames) {
+    // FIXME: replace macros within macro definitions!
+    // lookup lowercase macro in map
+    QByteArray macroName = macro.toUtf8();
+    c->addMacro(m_macros[macro], QString::fromUtf8(bt_macro_text(macroName.data(), nullptr, 0)));
   }
 
   return ptr;
 #else
+  Q_UNUSED(text);
+  Q_UNUSED(urlCount);
   return Data::CollPtr();
 #endif // ENABLE_BTPARSE
 }
 
-void BibtexImporter::parseText(const QString& text) {
+void BibtexImporter::parseText(const QString& text, int& pos, int& line, QList<BibtexRecord>& records) {
 #ifdef ENABLE_BTPARSE
-  m_nodes.clear();
-  m_macros.clear();
-
   ushort bt_options = 0; // ushort is defined in btparse.h
   boolean ok; // boolean is defined in btparse.h as an int
 
-  // for regular nodes (entries), do NOT convert numbers to strings, do NOT expand macros
-  bt_set_stringopts(BTE_REGULAR, 0);
-  bt_set_stringopts(BTE_MACRODEF, 0);
-//  bt_set_stringopts(BTE_PREAMBLE, BTO_CONVERT | BTO_EXPAND);
-
-  QString entry;
-  static const QRegularExpression rx(QLatin1String("[{}]"));
   static const QRegularExpression macroName(QLatin1String("@string\\s*\\{\\s*(.*?)="), QRegularExpression::CaseInsensitiveOption);
+  QByteArray filename = QFile::encodeName(url().fileName());
 
-  int line = 1;
-  bool needsCleanup = false;
+  const int length = text.length();
   int brace = 0;
-  int startpos = 0;
-  QRegularExpressionMatch m = rx.match(text);
-  int pos = m.capturedStart();
-  while(pos > 0 && !m_cancelled) {
-    if(text[pos] == QLatin1Char('{')) {
+  int startpos = pos;
+  for( ; pos < length && !m_cancelled; ++pos) {
+    const QChar ch = text.at(pos);
+    if(ch == QLatin1Char('{')) {
       ++brace;
-    } else if(text[pos] == QLatin1Char('}') && brace > 0) {
-      --brace;
+      continue;
+    } else if(ch == QLatin1Char('}')) {
+      if(brace > 0) {
+        --brace;
+      }
+    } else {
+      continue;
     }
-    if(brace == 0) {
-      entry = text.mid(startpos, pos-startpos+1);
-      // All the downstream text processing on the AST node will assume utf-8
-      QByteArray entryText = entry.toUtf8();
-      QByteArray filename = QFile::encodeName(url().fileName());
-      AST* node = bt_parse_entry_s(entryText.data(),
-                                   filename.data(),
-                                   line, bt_options, &ok);
-      if(ok && node) {
-        QRegularExpressionMatch macroMatch = macroName.match(entry);
-        if(bt_entry_metatype(node) == BTE_MACRODEF && macroMatch.hasMatch()) {
-          char* macro;
-          (void) bt_next_field(node, nullptr, &macro);
-          m_macros.insert(QString::fromUtf8(macro), macroMatch.captured(1).trimmed());
+    if(brace > 0) {
+      continue;
+    }
+    const QString entry = text.mid(startpos, pos-startpos+1);
+    // All the downstream text processing on the AST node will assume utf-8
+    QByteArray entryText = entry.toUtf8();
+    AST* node = bt_parse_entry_s(entryText.data(),
+                                 filename.data(),
+                                 line, bt_options, &ok);
+    startpos = pos+1;
+    line += entry.count(QLatin1Char('\n'));
+    if(!ok || !node) {
+      continue;
+    }
+
+    // everything needed is copied out of the node so it can be freed right away
+    BibtexRecord record;
+    record.metaType = bt_entry_metatype(node);
+    if(record.metaType == BTE_PREAMBLE) {
+      char* preamble = bt_get_text(node);
+      if(preamble) {
+        record.text = QString::fromUtf8(preamble);
+      }
+    } else if(record.metaType == BTE_MACRODEF) {
+      char* macro;
+      (void) bt_next_field(node, nullptr, &macro);
+      record.text = QString::fromUtf8(macro);
+      QRegularExpressionMatch macroMatch = macroName.match(entry);
+      if(macroMatch.hasMatch()) {
+        m_macros.insert(record.text, macroMatch.captured(1).trimmed());
+      }
+    } else if(record.metaType != BTE_COMMENT) {
+      record.entryType = QString::fromUtf8(bt_entry_type(node));
+      record.key = QString::fromUtf8(bt_entry_key(node));
+      char* name;
+      AST* field = nullptr;
+      while((field = bt_next_field(node, field, &name))) {
+        BibtexRecord::Field recordField;
+        recordField.name = QString::fromUtf8(name);
+        AST* value = nullptr;
+        bt_nodetype type;
+        char* svalue;
+        while((value = bt_next_value(field, value, &type, &svalue))) {
+          switch(type) {
+            case BTAST_STRING:
+            case BTAST_NUMBER:
+              recordField.values += BibtexRecord::Value{QByteArray(svalue), false};
+              break;
+            case BTAST_MACRO:
+              recordField.values += BibtexRecord::Value{QByteArray(svalue), true};
+              break;
+            default:
+              break;
+          }
         }
-        m_nodes.append(node);
-        needsCleanup = true;
+        record.fields += recordField;
       }
-      startpos = pos+1;
-      line += entry.count(QLatin1Char('\n'));
     }
-    m = rx.match(text, pos+1);
-    pos = m.capturedStart();
-  }
-  if(needsCleanup) {
-    // clean up some structures
-    bt_parse_entry_s(nullptr, nullptr, 1, 0, nullptr);
+    bt_free_ast(node);
+    records += record;
+
+    if(records.count() >= BIBTEX_BATCH_SIZE) {
+      ++pos;
+      return;
+    }
   }
+#else
+  Q_UNUSED(text);
+  Q_UNUSED(line);
+  Q_UNUSED(records);
+  pos = text.length();
 #endif // ENABLE_BTPARSE
 }
 
+void BibtexImporter::convertRecord(BibtexRecord& record_) {
+  static const QRegularExpression andRx(QLatin1String("\\sand\\s"));
+  for(auto& field : record_.fields) {
+    QString str;
+    bool end_macro = false;
+    for(auto& value : field.values) {
+      if(value.isMacro) {
+        str += QString::fromUtf8(value.text) + QLatin1Char('#');
+        end_macro = true;
+      } else {
+        str += BibtexHandler::importText(value.text.data()).simplified();
+        end_macro = false;
+      }
+    }
+    if(end_macro) {
+      // remove last character '#'
+      str.truncate(str.length() - 1);
+    }
+    if(field.name == QLatin1String("author") || field.name == QLatin1String("editor")) {
+      str.replace(andRx, FieldFormat::delimiterString());
+    }
+    field.value = str;
+    field.values.clear();
+  }
+}
+
 void BibtexImporter::slotCancel() {
   m_cancelled = true;
+  m_convertPool.clear();
 }
 
 QWidget* BibtexImporter::widget(QWidget* parent_) {
@@ -46,6 +46,7 @@ class AST;
 
 #include <QList>
 #include <QHash>
+#include <QThreadPool>
 
 class QRadioButton;
 
@@ -91,12 +92,19 @@ public Q_SLOTS:
   void slotCancel() override;
 
 private:
+  struct BibtexRecord;
+
   void init();
   Data::CollPtr readCollection(const QString& text, int n);
-  void parseText(const QString& text);
+  /**
+   * Parses the text, starting at a position, until a batch of records is read or the
+   * text is finished. The position and line number are updated for the next batch.
+   */
+  void parseText(const QString& text, int& pos, int& line, QList<BibtexRecord>& records);
   void appendCollection(Data::CollPtr newColl);
 
-  QList<AST*> m_nodes;
+  static void convertRecord(BibtexRecord& record);
+
   QHash<QString, QString> m_macros;
 
   Data::CollPtr m_coll;
@@ -104,6 +112,7 @@ private:
   QRadioButton* m_readUTF8;
   QRadioButton* m_readLocale;
   bool m_cancelled : 1;
+  QThreadPool m_convertPool;
 
   static int s_initCount;
 };
@@ -54,9 +54,14 @@
 #include <QButtonGroup>
 #include <QApplication>
 
+namespace {
+  // the number of entries added to the collection at a time
+  static const int CSV_BATCH_SIZE = 1000;
+}
+
 using Tellico::Import::CSVImporter;
 
-CSVImporter::CSVImporter(const QUrl& url_) : Tellico::Import::TextImporter(url_),
+CSVImporter::CSVImporter(const QUrl& url_) : Tellico::Import::Importer(url_),
     m_collType(-1),
     m_existingCollection(nullptr),
     m_firstRowHeader(false),
@@ -78,13 +83,16 @@ CSVImporter::CSVImporter(const QUrl& url_) : Tellico::Import::TextImporter(url_)
     m_setColumnBtn(nullptr),
     m_hasAssignedFields(false),
     m_isLibraryThing(false),
-    m_parser(new CSVParser(text())) {
+    m_parser(new CSVParser(QString())),
+    m_fileRef(nullptr) {
   m_parser->setDelimiter(m_delimiter);
 }
 
 CSVImporter::~CSVImporter() {
   delete m_parser;
   m_parser = nullptr;
+  delete m_fileRef;
+  m_fileRef = nullptr;
 }
 
 Tellico::Data::CollPtr CSVImporter::collection() {
@@ -112,69 +120,107 @@ Tellico::Data::CollPtr CSVImporter::collection() {
     return Data::CollPtr();
   }
 
-  m_parser->reset(text());
+  if(!resetParser()) {
+    return Data::CollPtr();
+  }
 
   // if the first row are headers, skip it
   if(m_firstRowHeader) {
     m_parser->skipLine();
   }
 
-  const uint numChars = text().size();
-  const uint stepSize = qMax(s_stepSize, numChars/100);
+  QIODevice* device = m_fileRef ? m_fileRef->file() : nullptr;
+  const qint64 total = qMax(qint64(1), device ? device->size() : qint64(text().size()));
   const bool showProgress = options() & ImportProgress;
 
   // do we need to replace column or row delimiters
   const bool replaceColDelimiter = (!m_colDelimiter.isEmpty() && m_colDelimiter != FieldFormat::columnDelimiterString());
   const bool replaceRowDelimiter = (!m_rowDelimiter.isEmpty() && m_rowDelimiter != FieldFormat::rowDelimiterString());
 
-  uint j = 0;
+  // resolve the field for each imported column once, rather than for every value
+  enum SpecialCase { NoSpecialCase, LibraryThingIsbn, LibraryThingKeyword, LibraryThingDate };
+  struct ImportColumn {
+    int column;
+    QString fieldName;
+    Data::FieldPtr field;
+    bool replaceDelimiters;
+    SpecialCase specialCase;
+  };
+  QList<ImportColumn> importColumns;
+  for(int i = 0; i < m_fieldsToImport.size() && i < m_columnsToImport.size(); ++i) {
+    const QString& fieldName = m_fieldsToImport.at(i);
+    Data::FieldPtr field = m_coll->fieldByName(fieldName);
+    if(!field) {
+      myDebug() << "No field in collection named" << fieldName;
+      continue;
+    }
+    ImportColumn col;
+    col.column = m_columnsToImport.at(i);
+    col.fieldName = fieldName;
+    col.field = field;
+    // only replace delimiters for tables
+    // see https://forum.kde.org/viewtopic.php?f=200&t=142712
+    col.replaceDelimiters = field->type() == Data::Field::Table;
+    col.specialCase = NoSpecialCase;
+    if(m_isLibraryThing) {
+      if(fieldName == QLatin1String("isbn")) {
+        col.specialCase = LibraryThingIsbn;
+      } else if(fieldName == QLatin1String("keyword")) {
+        col.specialCase = LibraryThingKeyword;
+      } else if(fieldName == QLatin1String("cdate")) {
+        col.specialCase = LibraryThingDate;
+      }
+    }
+    importColumns += col;
+  }
+
+  Data::EntryList batch;
+  batch.reserve(CSV_BATCH_SIZE);
+  QStringList values;
+  qint64 j = 0;
+  uint rowCount = 0;
   while(!m_cancelled && m_parser->hasNext()) {
     bool empty = true;
     Data::EntryPtr entry(new Data::Entry(m_coll));
-    QStringList values = m_parser->nextTokens();
-    for(int i = 0; i < m_fieldsToImport.size(); ++i) {
-      if(m_columnsToImport.at(i) >= values.size()) {
+    m_parser->nextTokens(values);
+    for(const auto& col : std::as_const(importColumns)) {
+      if(col.column >= values.size()) {
         break;
       }
-      const QString currentFieldName = m_fieldsToImport.at(i);
-      if(!m_coll->hasField(currentFieldName)) {
-        myDebug() << "No field in collection named" << currentFieldName;
-        continue;
-      }
-      QString value = values[m_columnsToImport.at(i)].trimmed();
-      const auto fieldType = m_coll->fieldByName(currentFieldName)->type();
-      // only replace delimiters for tables
-      // see https://forum.kde.org/viewtopic.php?f=200&t=142712
-      if(replaceColDelimiter && fieldType == Data::Field::Table) {
+      QString value = values.at(col.column).trimmed();
+      if(replaceColDelimiter && col.replaceDelimiters) {
         value.replace(m_colDelimiter, FieldFormat::columnDelimiterString());
       }
-      if(replaceRowDelimiter && fieldType == Data::Field::Table) {
+      if(replaceRowDelimiter && col.replaceDelimiters) {
         value.replace(m_rowDelimiter, FieldFormat::rowDelimiterString());
       }
-      if(m_isLibraryThing) {
-        // special cases for LibraryThing import
-        if(currentFieldName == QLatin1String("isbn")) {
+      // special cases for LibraryThing import
+      switch(col.specialCase) {
+        case LibraryThingIsbn:
           // ISBN values are enclosed by brackets
           value.remove(QLatin1Char('[')).remove(QLatin1Char(']'));
-        } else if(currentFieldName == QLatin1String("keyword")) {
+          break;
+        case LibraryThingKeyword:
           // LT values are comma-separated
           value.replace(QLatin1String(","), FieldFormat::delimiterString());
-        } else if(currentFieldName == QLatin1String("cdate")) {
+          break;
+        case LibraryThingDate:
           // only want date, not time. 10 characters since it's zero-padded
           value.truncate(10);
-        }
+          break;
+        case NoSpecialCase:
+          break;
       }
-      bool success = entry->setField(currentFieldName, value);
+      bool success = entry->setField(col.fieldName, value);
       // we might need to add a new allowed value
       // assume that if the user is importing the value, it should be allowed
-      if(!success && fieldType == Data::Field::Choice) {
-        Data::FieldPtr f = m_coll->fieldByName(currentFieldName);
+      if(!success && col.field->type() == Data::Field::Choice) {
         StringSet allow;
-        allow.add(f->allowed());
+        allow.add(col.field->allowed());
         allow.add(value);
-        f->setAllowed(allow.values());
-        m_coll->modifyField(f);
-        success = entry->setField(currentFieldName, value);
+        col.field->setAllowed(allow.values());
+        m_coll->modifyField(col.field);
+        success = entry->setField(col.fieldName, value);
       }
       if(empty && success) {
         empty = false;
@@ -182,14 +228,24 @@ Tellico::Data::CollPtr CSVImporter::collection() {
       j += value.size();
     }
     if(!empty) {
-      m_coll->addEntries(entry);
+      batch += entry;
+      if(batch.size() >= CSV_BATCH_SIZE) {
+        m_coll->addEntries(batch);
+        batch.clear();
+      }
     }
 
-    if(showProgress && j%stepSize == 0) {
-      Q_EMIT signalProgress(this, 100*j/numChars);
+    if(showProgress && ++rowCount % s_stepSize == 0) {
+      const qint64 pos = device ? device->pos() : j;
+      Q_EMIT signalProgress(this, 100*qMin(pos, total)/total);
       qApp->processEvents();
     }
   }
+  if(!batch.isEmpty()) {
+    m_coll->addEntries(batch);
+  }
+
+  closeFile();
 
   {
     KConfigGroup config(KSharedConfig::openConfig(), QStringLiteral("ImportOptions - CSV"));
@@ -419,18 +475,52 @@ void CSVImporter::setRowDelimiter(const QString& delimiter_) {
   m_rowDelimiter = delimiter_;
 }
 
+bool CSVImporter::resetParser() {
+  // any text set directly is used instead of the file
+  if(!text().isEmpty() || !url().isValid()) {
+    closeFile();
+    m_parser->reset(text());
+    return true;
+  }
+  // the file stays open while the table gets filled again for every option change, so that
+  // a remote file is only downloaded once. Reading it again just starts back at the beginning
+  if(m_fileRef && !m_fileRef->file()->seek(0)) {
+    closeFile();
+  }
+  if(!m_fileRef) {
+    m_fileRef = FileHandler::fileRef(url());
+    if(!m_fileRef->isValid() || !m_fileRef->open()) {
+      delete m_fileRef;
+      m_fileRef = nullptr;
+      return false;
+    }
+  }
+  m_parser->reset(m_fileRef->file());
+  return true;
+}
+
+void CSVImporter::closeFile() {
+  // the parser can not keep reading from a closed file
+  m_parser->reset(QString());
+  delete m_fileRef;
+  m_fileRef = nullptr;
+}
+
 void CSVImporter::fillTable() {
   if(!m_table) {
     return;
   }
 
-  m_parser->reset(text());
+  if(!resetParser()) {
+    return;
+  }
   // not skipping first row since the updateHeader() call depends on it
 
   int maxCols = 0;
   int row = 0;
+  QStringList values;
   for( ; m_parser->hasNext() && row < m_table->rowCount(); ++row) {
-    QStringList values = m_parser->nextTokens();
+    m_parser->nextTokens(values);
     if(static_cast<int>(values.count()) > m_table->columnCount()) {
       m_table->setColumnCount(values.count());
       m_colSpinBox->setMaximum(values.count());
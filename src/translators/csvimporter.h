@@ -25,8 +25,9 @@
 #ifndef TELLICO_CSVIMPORTER_H
 #define TELLICO_CSVIMPORTER_H
 
-#include "textimporter.h"
+#include "importer.h"
 #include "../datavectors.h"
+#include "../core/filehandler.h"
 
 class CSVImporterWidget;
 
@@ -48,9 +49,11 @@ namespace Tellico {
   namespace Import {
 
 /**
+ * The file is read in chunks as it is parsed, rather than being loaded into memory all at once.
+ *
  * @author Robby Stephenson
  */
-class CSVImporter : public TextImporter {
+class CSVImporter : public Importer {
 Q_OBJECT
 
 friend class ::CsvTest;
@@ -97,6 +100,8 @@ private Q_SLOTS:
 
 private:
   void fillTable();
+  bool resetParser();
+  void closeFile();
   void updateHeader();
   void createCollection();
   void updateFieldCombo();
@@ -130,6 +135,7 @@ private:
   bool m_isLibraryThing;
 
   CSVParser* m_parser;
+  FileHandler::FileRef* m_fileRef;
 };
 
   } // end namespace
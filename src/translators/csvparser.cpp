@@ -26,6 +26,8 @@
 
 #include <QTextStream>
 #include <QStringList>
+#include <QStringDecoder>
+#include <QIODevice>
 
 #include <config.h>
 
@@ -37,6 +39,11 @@ extern "C" {
 #endif
 }
 
+namespace {
+  // the size of each block of data read from a device
+  static const qint64 CSV_CHUNK_SIZE = 64 * 1024;
+}
+
 typedef int(*SpaceFunc)(char);
 
 static void writeToken(void* buffer, size_t len, void* data);
@@ -44,12 +51,14 @@ static void writeRow(int buffer, void* data);
 static int isSpace(unsigned char c);
 static int isSpaceOrTab(unsigned char c);
 static int isTab(unsigned char c);
+static QString tokenString(const char* buffer, size_t len);
 
 using Tellico::CSVParser;
 
 class CSVParser::Private {
 public:
-  Private() : stream(nullptr), done(false) {
+  Private() : stream(nullptr), done(false), device(nullptr), rowCount(0), nextRow(0)
+      , rowStarted(false), atStart(true), atEnd(true) {
     csv_init(&parser, 0);
   }
   ~Private() {
@@ -57,17 +66,99 @@ public:
     delete stream;
   }
 
+  bool readRows();
+  static void appendToken(void* buffer, size_t len, void* data);
+  static void appendRow(int c, void* data);
+
   struct csv_parser parser;
   QString str;
   QTextStream* stream;
   QStringList tokens;
   bool done;
+
+  // when reading from a device, a single chunk may hold several rows, which are kept
+  // until requested. The lists are reused for later rows rather than being reallocated
+  QIODevice* device;
+  QStringDecoder decoder;
+  QByteArray buffer;
+  QList<QStringList> rows;
+  int rowCount;
+  int nextRow;
+  bool rowStarted;
+  bool atStart;
+  bool atEnd;
 };
 
+bool CSVParser::Private::readRows() {
+  if(nextRow >= rowCount) {
+    // every complete row has been read, so move any partial row to the front
+    if(rowCount > 0 && rowCount < rows.size()) {
+      rows[0].swap(rows[rowCount]);
+    }
+    rowCount = 0;
+    nextRow = 0;
+  }
+  while(nextRow >= rowCount && !atEnd) {
+    buffer.resize(CSV_CHUNK_SIZE);
+    const qint64 len = device->read(buffer.data(), CSV_CHUNK_SIZE);
+    if(len <= 0) {
+      csv_fini(&parser, &appendToken, &appendRow, this);
+      atEnd = true;
+      break;
+    }
+    buffer.truncate(len);
+    if(atStart) {
+      atStart = false;
+      // the text importers assume UTF-8 unless there is a byte order mark for something else
+      const auto encoding = QStringConverter::encodingForData(buffer);
+      if(encoding && *encoding != QStringConverter::Utf8) {
+        decoder = QStringDecoder(*encoding);
+      } else if(buffer.startsWith("\xEF\xBB\xBF")) {
+        buffer.remove(0, 3);
+      }
+    }
+    if(decoder.isValid()) {
+      buffer = QString(decoder.decode(buffer)).toUtf8();
+    }
+    csv_parse(&parser, buffer.constData(), buffer.size(), &appendToken, &appendRow, this);
+  }
+  return nextRow < rowCount;
+}
+
+void CSVParser::Private::appendToken(void* buffer_, size_t len_, void* data_) {
+  Private* p = static_cast<Private*>(data_);
+  if(p->rows.size() <= p->rowCount) {
+    p->rows.resize(p->rowCount + 1);
+  }
+  QStringList& row = p->rows[p->rowCount];
+  if(!p->rowStarted) {
+    row.clear();
+    p->rowStarted = true;
+  }
+  row += tokenString(static_cast<const char*>(buffer_), len_);
+}
+
+void CSVParser::Private::appendRow(int c_, void* data_) {
+  Q_UNUSED(c_);
+  Private* p = static_cast<Private*>(data_);
+  if(p->rows.size() <= p->rowCount) {
+    p->rows.resize(p->rowCount + 1);
+  }
+  if(!p->rowStarted) {
+    p->rows[p->rowCount].clear();
+  }
+  p->rowStarted = false;
+  ++p->rowCount;
+}
+
 CSVParser::CSVParser(QString str) : d(new Private()) {
   reset(str);
 }
 
+CSVParser::CSVParser(QIODevice* device) : d(new Private()) {
+  reset(device);
+}
+
 CSVParser::~CSVParser() {
   delete d;
 }
@@ -84,13 +175,38 @@ void CSVParser::reset(QString str) {
   delete d->stream;
   d->str = str;
   d->stream = new QTextStream(&d->str);
+  d->device = nullptr;
+}
+
+void CSVParser::reset(QIODevice* device) {
+  delete d->stream;
+  d->stream = nullptr;
+  d->str.clear();
+  // discard anything left over from the previous data
+  csv_fini(&d->parser, nullptr, nullptr, nullptr);
+  d->device = device;
+  d->decoder = QStringDecoder();
+  d->rowCount = 0;
+  d->nextRow = 0;
+  d->rowStarted = false;
+  d->atStart = true;
+  d->atEnd = !device;
 }
 
 bool CSVParser::hasNext() const {
+  if(d->device || !d->stream) {
+    return d->nextRow < d->rowCount || d->readRows();
+  }
   return !d->stream->atEnd();
 }
 
 void CSVParser::skipLine() {
+  if(d->device || !d->stream) {
+    if(hasNext()) {
+      ++d->nextRow;
+    }
+    return;
+  }
   d->stream->readLine();
 }
 
@@ -103,6 +219,22 @@ void CSVParser::setRowDone(bool b) {
 }
 
 QStringList CSVParser::nextTokens() {
+  QStringList tokens;
+  nextTokens(tokens);
+  return tokens;
+}
+
+void CSVParser::nextTokens(QStringList& tokens) {
+  if(d->device || !d->stream) {
+    if(hasNext()) {
+      // the list which is swapped out gets reused for a later row
+      tokens.swap(d->rows[d->nextRow]);
+      ++d->nextRow;
+    } else {
+      tokens.clear();
+    }
+    return;
+  }
   d->tokens.clear();
   d->done = false;
   while(hasNext() && !d->done) {
@@ -110,12 +242,12 @@ QStringList CSVParser::nextTokens() {
     csv_parse(&d->parser, line.constData(), line.length(), &writeToken, &writeRow, this);
   }
   csv_fini(&d->parser, &writeToken, &writeRow, this);
-  return d->tokens;
+  tokens.swap(d->tokens);
 }
 
 static void writeToken(void* buffer, size_t len, void* data) {
   CSVParser* p = static_cast<CSVParser*>(data);
-  p->addToken(QString::fromUtf8((char *)buffer, len));
+  p->addToken(tokenString(static_cast<const char*>(buffer), len));
 }
 
 static void writeRow(int c, void* data) {
@@ -138,3 +270,26 @@ static int isTab(unsigned char c) {
   if (c == CSV_TAB) return 1;
   return 0;
 }
+
+static QString tokenString(const char* buffer, size_t len) {
+  if(!buffer) {
+    return QString();
+  }
+  // C0 control characters, other than whitespace, are not allowed in the XML data file
+  // in UTF-8, those bytes are never part of a multi-byte character
+  for(size_t i = 0; i < len; ++i) {
+    const uchar c = buffer[i];
+    if(c < 0x20 && c != '\t' && c != '\n' && c != '\r') {
+      QByteArray cleaned;
+      cleaned.reserve(len);
+      for(size_t j = 0; j < len; ++j) {
+        const uchar c2 = buffer[j];
+        if(c2 > 0x1F || c2 == '\t' || c2 == '\n' || c2 == '\r') {
+          cleaned += buffer[j];
+        }
+      }
+      return QString::fromUtf8(cleaned);
+    }
+  }
+  return QString::fromUtf8(buffer, len);
+}
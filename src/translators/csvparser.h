@@ -26,23 +26,39 @@
 #define TELLICO_CSVPARSER_H
 
 #include <QString>
+#include <QStringList>
+
+class QIODevice;
 
 namespace Tellico {
 
 class CSVParser {
 public:
   CSVParser(QString str);
+  /**
+   * Reads the CSV data from a device in chunks, rather than needing the whole text at once.
+   * The device is not owned by the parser and must stay open while parsing.
+   */
+  CSVParser(QIODevice* device);
   ~CSVParser();
 
   void setDelimiter(const QString& s);
   void reset(QString str);
+  void reset(QIODevice* device);
   bool hasNext() const;
+  /**
+   * Skips the next line of text, or the next row when reading from a device.
+   */
   void skipLine();
 
   void addToken(const QString& t);
   void setRowDone(bool b);
 
   QStringList nextTokens();
+  /**
+   * Reads the next row into an existing list so that its memory may be reused for each row.
+   */
+  void nextTokens(QStringList& tokens);
 
 private:
   class Private;
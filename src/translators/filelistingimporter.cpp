@@ -25,6 +25,7 @@
 #include <config.h>
 
 #include "filelistingimporter.h"
+#include "translators.h"
 #include "filereader.h"
 #include "filereaderbook.h"
 #include "filereadervideo.h"
@@ -35,11 +36,13 @@
 #include "../gui/collectiontypecombo.h"
 #include "../utils/guiproxy.h"
 #include "../progressmanager.h"
+#include "../core/netaccess.h"
 #include "../tellico_debug.h"
 
 #include <KLocalizedString>
 #include <KJobWidgets>
 #include <KIO/ListJob>
+#include <KIO/Global>
 
 #include <QDate>
 #include <QDir>
@@ -51,10 +54,34 @@
 #include <QVBoxLayout>
 #include <QApplication>
 
+namespace {
+  static const int FILE_PREVIEW_SIZE = 128;
+  // the number of files in each file preview job
+  static const int FILE_PREVIEW_BATCH_SIZE = 50;
+
+  // the modified date of the entry is only known to the day, so any file modified on that day
+  // or later is read again. A file catalog also has the size of the file.
+  bool isUnchanged(Tellico::Data::EntryPtr entry_, const KFileItem& item_) {
+    const QDate mdate = QDate::fromString(entry_->field(QStringLiteral("mdate")), Qt::ISODate);
+    const QDate fileDate = item_.time(KFileItem::ModificationTime).date();
+    if(!mdate.isValid() || !fileDate.isValid() || fileDate >= mdate) {
+      return false;
+    }
+    const QString size = entry_->field(QStringLiteral("size"));
+    return size.isEmpty() || size == KIO::convertSize(item_.size());
+  }
+}
+
 using Tellico::Import::FileListingImporter;
 
 FileListingImporter::FileListingImporter(const QUrl& url_) : Importer(url_), m_collType(Data::Collection::File), m_coll(nullptr)
-    , m_widget(nullptr), m_collCombo(nullptr), m_recursive(nullptr), m_filePreview(nullptr), m_job(nullptr), m_useFilePreview(false), m_cancelled(false) {
+    , m_widget(nullptr), m_collCombo(nullptr), m_recursive(nullptr), m_filePreview(nullptr), m_job(nullptr), m_useFilePreview(false), m_cancelled(false)
+    , m_update(false), m_filesQueued(0) {
+}
+
+FileListingImporter::~FileListingImporter() {
+  m_readerPool.clear();
+  m_readerPool.waitForDone();
 }
 
 bool FileListingImporter::canImport(int type) const {
@@ -73,11 +100,54 @@ Tellico::Data::CollPtr FileListingImporter::collection() {
   connect(&item, &Tellico::ProgressItem::signalCancelled, this, &FileListingImporter::slotCancel);
   ProgressItem::Done done(this);
 
+  if(m_widget) {
+    m_useFilePreview = m_filePreview->isChecked();
+    m_collType = m_collCombo->currentType();
+  }
+
+  // the reader is needed before listing so the files can be read as soon as they are found
+  Data::CollPtr coll;
+  switch(m_collType) {
+    case(Data::Collection::Book):
+      coll = new Data::BookCollection(true);
+      m_reader.reset(new FileReaderBook(url()));
+      break;
+
+    case(Data::Collection::Video):
+      coll = new Data::VideoCollection(true);
+      m_reader.reset(new FileReaderVideo(url()));
+      break;
+
+    case(Data::Collection::File):
+      coll = new Data::FileCatalog(true);
+      m_reader.reset(new FileReaderFile(url()));
+      break;
+  }
+  if(!m_reader) return Data::CollPtr();
+  m_reader->setUseFilePreview(m_useFilePreview);
+  m_files.clear();
+  m_filesQueued = 0;
+  m_filesRead = 0;
+
+  const QString urlField = QStringLiteral("url");
+  m_existingEntries.clear();
+  m_listedUrls.clear();
+  Data::CollPtr currColl = currentCollection();
+  if(m_update && currColl && currColl->type() == m_collType) {
+    foreach(Data::EntryPtr entry, currColl->entries()) {
+      const QString u = entry->field(urlField);
+      if(!u.isEmpty()) {
+        m_existingEntries.insert(u, entry);
+      }
+    }
+  }
+
   // the importer might be running without a gui/widget
   KIO::JobFlags flags = KIO::DefaultFlags;
   if(!m_widget) flags |= KIO::HideProgressInfo;
   const auto includeHidden = KIO::ListJob::ListFlags{};
-  m_job = (m_widget && m_recursive->isChecked())
+  const bool recursive = m_widget && m_recursive->isChecked();
+  m_job = recursive
           ? KIO::listRecursive(url(), flags, includeHidden)
           : KIO::listDir(url(), flags, includeHidden);
   KJobWidgets::setWindow(m_job, GUI::Proxy::widget());
@@ -86,52 +156,57 @@ Tellico::Data::CollPtr FileListingImporter::collection() {
 
   if(!m_job->exec() || m_cancelled) {
     myDebug() << "did not run job:" << m_job->errorString();
+    m_readerPool.clear();
+    m_readerPool.waitForDone();
     return Data::CollPtr();
   }
 
-  if(m_widget) {
-    m_useFilePreview = m_filePreview->isChecked();
-    m_collType = m_collCombo->currentType();
-  }
-
-  const uint stepSize = qMax(1, m_files.count()/100);
   const bool showProgress = options() & ImportProgress;
-  item.setTotalSteps(m_files.count());
+  // reading the files counts as one step each, and so does populating the entries
+  item.setTotalSteps(m_filesQueued + m_files.count());
 
-  std::unique_ptr<AbstractFileReader> reader;
-  switch(m_collType) {
-    case(Data::Collection::Book):
-      m_coll = new Data::BookCollection(true);
-      reader.reset(new FileReaderBook(url()));
-      break;
-
-    case(Data::Collection::Video):
-      m_coll = new Data::VideoCollection(true);
-      reader.reset(new FileReaderVideo(url()));
-      break;
-
-    case(Data::Collection::File):
-      m_coll = new Data::FileCatalog(true);
-      reader.reset(new FileReaderFile(url()));
-      break;
+  // wait for the worker threads to finish reading
+  while(!m_readerPool.waitForDone(100)) {
+    if(showProgress) {
+      ProgressManager::self()->setProgress(this, m_filesRead.loadRelaxed());
+      qApp->processEvents();
+    }
   }
-  if(!reader) return Data::CollPtr();
-  reader->setUseFilePreview(m_useFilePreview);
 
+  const uint stepSize = qMax(1, m_files.count()/100);
+  m_coll = coll;
   Data::EntryList entries;
+  UpdateResult result;
   uint j = 0;
-  foreach(const KFileItem& item, m_files) {
+  for(int i = 0; i < m_files.count(); ++i) {
     if(m_cancelled) {
       break;
     }
 
+    // generate the previews for a batch of files with a single job
+    if(m_useFilePreview && i % FILE_PREVIEW_BATCH_SIZE == 0) {
+      KFileItemList previewItems;
+      for(int k = i; k < qMin(i + FILE_PREVIEW_BATCH_SIZE, m_files.count()); ++k) {
+        if(m_reader->canRead(m_files.at(k))) {
+          previewItems += m_files.at(k);
+        }
+      }
+      m_reader->addFilePreviews(NetAccess::filePreviews(previewItems, FILE_PREVIEW_SIZE));
+    }
+
+    const KFileItem& fileItem = m_files.at(i);
     Data::EntryPtr entry(new Data::Entry(m_coll));
-    if(reader->populate(entry, item)) {
-      entries += entry;
+    if(m_reader->populate(entry, fileItem)) {
+      Data::EntryPtr existingEntry = m_existingEntries.value(fileItem.url().url());
+      if(existingEntry) {
+        result.modifiedEntries += qMakePair(existingEntry, entry);
+      } else {
+        entries += entry;
+      }
     }
 
     if(showProgress && j%stepSize == 0) {
-      ProgressManager::self()->setProgress(this, j);
+      ProgressManager::self()->setProgress(this, m_filesQueued + j);
       qApp->processEvents();
     }
     ++j;
@@ -143,6 +218,13 @@ Tellico::Data::CollPtr FileListingImporter::collection() {
     return m_coll;
   }
 
+  for(auto it = m_existingEntries.constBegin(); it != m_existingEntries.constEnd(); ++it) {
+    if(!m_listedUrls.contains(it.key()) && isInListing(it.key(), recursive)) {
+      result.missingEntries += it.value();
+    }
+  }
+  setUpdateResult(result);
+
   return m_coll;
 }
 
@@ -195,16 +277,47 @@ void FileListingImporter::slotEntries(KIO::Job* job_, const KIO::UDSEntryList& l
     return;
   }
 
+  AbstractFileReader* reader = m_reader.get();
   for(KIO::UDSEntryList::ConstIterator it = list_.begin(); it != list_.end(); ++it) {
     KFileItem item(*it, url(), false, true);
     if(item.isFile()) {
+      if(!m_existingEntries.isEmpty()) {
+        const QString u = item.url().url();
+        m_listedUrls.insert(u);
+        Data::EntryPtr existingEntry = m_existingEntries.value(u);
+        if(existingEntry && isUnchanged(existingEntry, item)) {
+          continue;
+        }
+      }
       m_files.append(item);
+      // nothing else touches the item until the pool is done, so the worker can share it
+      if(reader && reader->canRead(item)) {
+        ++m_filesQueued;
+        m_readerPool.start([this, reader, item]() {
+          reader->readFile(item);
+          m_filesRead.ref();
+        });
+      }
     }
   }
 }
 
+void FileListingImporter::slotActionChanged(int action_) {
+  m_update = (action_ == Import::Update);
+}
+
+// entries for files outside of the listed folder are never missing
+bool FileListingImporter::isInListing(const QString& url_, bool recursive_) const {
+  const QString dirUrl = url().adjusted(QUrl::StripTrailingSlash).url() + QLatin1Char('/');
+  if(!url_.startsWith(dirUrl)) {
+    return false;
+  }
+  return recursive_ || url_.indexOf(QLatin1Char('/'), dirUrl.length()) == -1;
+}
+
 void FileListingImporter::slotCancel() {
   m_cancelled = true;
+  m_readerPool.clear();
   if(m_job) {
     m_job->kill();
   }
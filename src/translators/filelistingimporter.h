@@ -31,6 +31,12 @@
 #include <KFileItem>
 
 #include <QPointer>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+#include <QAtomicInt>
+
+#include <memory>
 
 class QCheckBox;
 namespace KIO {
@@ -38,12 +44,19 @@ namespace KIO {
 }
 
 namespace Tellico {
+  class AbstractFileReader;
   namespace GUI {
     class CollectionTypeCombo;
   }
   namespace Import {
 
 /**
+ * The metadata for each file is read by a pool of worker threads as soon as the file is listed.
+ * The entries are populated once the listing is finished.
+ *
+ * When updating the current collection, only the files which are new or have been modified
+ * since their entries were last changed are read.
+ *
  * @author Robby Stephenson
  */
 class FileListingImporter : public Importer {
@@ -51,6 +64,7 @@ Q_OBJECT
 
 public:
   FileListingImporter(const QUrl& url);
+  ~FileListingImporter();
 
   /**
    * @return A pointer to a @ref Data::Collection, or 0 if none can be created.
@@ -60,11 +74,13 @@ public:
    */
   virtual QWidget* widget(QWidget* parent) override;
   virtual bool canImport(int type) const override;
+  virtual bool canUpdate() const override { return true; }
 
   void setUseFilePreview(bool b) { m_useFilePreview = b; }
   void setCollectionType(int type_) { m_collType = type_; }
 
 public Q_SLOTS:
+  void slotActionChanged(int action) override;
   void slotCancel() override;
 
 private Q_SLOTS:
@@ -72,6 +88,7 @@ private Q_SLOTS:
 
 private:
   QString volumeName() const;
+  bool isInListing(const QString& url, bool recursive) const;
 
   int m_collType;
   Data::CollPtr m_coll;
@@ -84,6 +101,17 @@ private:
   KFileItemList m_files;
   bool m_useFilePreview;
   bool m_cancelled;
+  bool m_update;
+
+  // for an update, the existing entries are found by the url of their file
+  QHash<QString, Data::EntryPtr> m_existingEntries;
+  QSet<QString> m_listedUrls;
+
+  std::unique_ptr<AbstractFileReader> m_reader;
+  // the pool has to be destroyed before the reader it uses
+  QThreadPool m_readerPool;
+  int m_filesQueued;
+  QAtomicInt m_filesRead;
 };
 
   } // end namespace
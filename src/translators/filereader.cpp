@@ -44,15 +44,55 @@ namespace {
   static const int FILE_PREVIEW_SIZE = 128;
 }
 
+using Tellico::AbstractFileReader;
 using Tellico::FileReaderMetaData;
 using Tellico::FileReaderFile;
 
+QPixmap AbstractFileReader::filePreview(const KFileItem& item_, int size_) {
+  // a null preview means that generating it already failed
+  auto it = m_previews.find(item_.url());
+  if(it != m_previews.end()) {
+    const QPixmap pixmap = it.value();
+    m_previews.erase(it);
+    return pixmap;
+  }
+  return NetAccess::filePreview(item_, size_);
+}
+
+void FileReaderMetaData::readFile(const KFileItem& item_) {
+#ifdef HAVE_KFILEMETADATA
+  const auto props = extractProperties(item_);
+  QMutexLocker lock(&m_propertiesMutex);
+  m_properties.insert(item_.url(), props);
+#else
+  Q_UNUSED(item_);
+#endif
+}
+
 #ifdef HAVE_KFILEMETADATA
 KFileMetaData::PropertyMultiMap FileReaderMetaData::properties(const KFileItem& item_) {
+  {
+    QMutexLocker lock(&m_propertiesMutex);
+    auto it = m_properties.find(item_.url());
+    if(it != m_properties.end()) {
+      const auto props = it.value();
+      m_properties.erase(it);
+      return props;
+    }
+  }
+  return extractProperties(item_);
+}
+
+KFileMetaData::PropertyMultiMap FileReaderMetaData::extractProperties(const KFileItem& item_) {
   KFileMetaData::SimpleExtractionResult result(item_.url().toLocalFile(),
                                                item_.mimetype(),
                                                KFileMetaData::ExtractionResult::ExtractMetaData);
-  QList<KFileMetaData::Extractor*> exList = m_extractors.fetchExtractors(item_.mimetype());
+  QList<KFileMetaData::Extractor*> exList;
+  {
+    // the collection loads the extractor plugins the first time they are needed
+    QMutexLocker lock(&m_extractorsMutex);
+    exList = m_extractors.fetchExtractors(item_.mimetype());
+  }
   foreach(KFileMetaData::Extractor* ex, exList) {
 // initializing exempi can cause a crash in Exiv for files with XMP data
 // crude workaround is to avoid using the exivextractor and the only apparent way is to
@@ -63,6 +103,16 @@ KFileMetaData::PropertyMultiMap FileReaderMetaData::properties(const KFileItem&
 #else
     if(true) {
 #endif
+      std::shared_ptr<QMutex> exMutex;
+      {
+        QMutexLocker lock(&m_extractorsMutex);
+        exMutex = m_extractorLocks[ex];
+        if(!exMutex) {
+          exMutex = std::make_shared<QMutex>();
+          m_extractorLocks.insert(ex, exMutex);
+        }
+      }
+      QMutexLocker exLock(exMutex.get());
       ex->extract(&result);
     }
   }
@@ -158,7 +208,7 @@ bool FileReaderFile::populate(Data::EntryPtr entry, const KFileItem& item) {
 
   QPixmap pixmap;
   if(useFilePreview()) {
-    pixmap = Tellico::NetAccess::filePreview(item, FILE_PREVIEW_SIZE);
+    pixmap = filePreview(item, FILE_PREVIEW_SIZE);
   }
   if(pixmap.isNull()) {
     if(d->iconImageId.contains(item.iconName())) {
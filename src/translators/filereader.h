@@ -35,6 +35,9 @@
 #endif
 
 #include <QUrl>
+#include <QHash>
+#include <QMutex>
+#include <QPixmap>
 
 #include <memory>
 
@@ -51,23 +54,53 @@ public:
   void setUseFilePreview(bool filePreview) { m_useFilePreview = filePreview; }
   bool useFilePreview() const { return m_useFilePreview; }
 
+  /**
+   * Returns whether an entry might be populated from the file, usually based on the mime type.
+   */
+  virtual bool canRead(const KFileItem& fileItem) const { Q_UNUSED(fileItem); return true; }
+  /**
+   * Reads the slow parts of the file, like the embedded metadata, so populate() does not have to.
+   * This gets called from worker threads, so it must not touch the collection, images, or pixmaps.
+   * Reading and parsing the file itself is safe to do in parallel, but anything using a shared
+   * plugin, like the KFileMetaData extractors, has to be serialized.
+   */
+  virtual void readFile(const KFileItem& fileItem) { Q_UNUSED(fileItem); }
   virtual bool populate(Data::EntryPtr entry, const KFileItem& fileItem) = 0;
+  /**
+   * Adds file previews which were generated all together, rather than one at a time.
+   */
+  void addFilePreviews(const QHash<QUrl, QPixmap>& previews) { m_previews.insert(previews); }
+
+protected:
+  QPixmap filePreview(const KFileItem& fileItem, int size);
 
 private:
   QUrl m_url;
   bool m_useFilePreview;
+  QHash<QUrl, QPixmap> m_previews;
 };
 
 class FileReaderMetaData : public AbstractFileReader {
 public:
   FileReaderMetaData(const QUrl& u) : AbstractFileReader(u) {}
 
+  virtual void readFile(const KFileItem& fileItem) override;
   virtual bool populate(Data::EntryPtr entry, const KFileItem& fileItem) override = 0;
 
 protected:
 #ifdef HAVE_KFILEMETADATA
   KFileMetaData::PropertyMultiMap properties(const KFileItem& item);
   KFileMetaData::ExtractorCollection m_extractors;
+
+private:
+  KFileMetaData::PropertyMultiMap extractProperties(const KFileItem& item);
+  // the extractors are plugins which are not known to be reentrant, so each one only
+  // extracts a single file at a time, though different extractors can run in parallel
+  QMutex m_extractorsMutex;
+  QHash<KFileMetaData::Extractor*, std::shared_ptr<QMutex> > m_extractorLocks;
+  QMutex m_propertiesMutex;
+  // properties which were read ahead of time in readFile()
+  QHash<QUrl, KFileMetaData::PropertyMultiMap> m_properties;
 #endif
 };
 
@@ -42,6 +42,181 @@
 
 namespace {
   static const int FILE_PREVIEW_SIZE = 128;
+
+  // everything read from an epub file, which can be done without touching the entry
+  struct EpubData {
+    EpubData() : isValid(false) {}
+    bool isValid;
+    QList<QPair<QString, QString> > fields;
+    QByteArray cover;
+    QString coverFormat;
+  };
+
+  EpubData readEpubData(const QString& fileName_) {
+    EpubData data;
+    KZip zip(fileName_);
+    if(!zip.open(QIODevice::ReadOnly)) {
+      myDebug() << "can't open zip";
+      return data;
+    }
+
+    const KArchiveDirectory* topDir = zip.directory();
+    const KArchiveEntry* container = topDir->entry(QStringLiteral("META-INF/container.xml"));
+    if(!container || !container->isFile()) {
+      myDebug() << "no container node";
+      return data;
+    }
+
+    const QByteArray containerData = static_cast<const KArchiveFile*>(container)->data();
+    QDomDocument dom;
+  #if (QT_VERSION < QT_VERSION_CHECK(6, 5, 0))
+    if(!dom.setContent(containerData, false /* namespace processing */)) {
+  #else
+    if(!dom.setContent(containerData, QDomDocument::ParseOption::Default)) {
+  #endif
+      return data;
+    }
+    QDomNode n = dom.documentElement().namedItem(QLatin1String("rootfiles"))
+                                      .namedItem(QLatin1String("rootfile"));
+    const auto rootPath = n.toElement().attribute(QLatin1String("full-path"));
+    const KArchiveEntry* rootFile = topDir->entry(rootPath);
+    if(!rootFile || !rootFile->isFile()) {
+      myDebug() << "no root file";
+      return data;
+    }
+    const QByteArray rootData = static_cast<const KArchiveFile*>(rootFile)->data();
+  #if (QT_VERSION < QT_VERSION_CHECK(6, 5, 0))
+    if(!dom.setContent(rootData, true /* namespace processing */)) {
+  #else
+    if(!dom.setContent(rootData, QDomDocument::ParseOption::UseNamespaceProcessing)) {
+  #endif
+      myDebug() << "bad root data";
+      return data;
+    }
+
+    auto metaNode = dom.documentElement().namedItem(QLatin1String("metadata")).toElement();
+    if(metaNode.isNull() || metaNode.namespaceURI() != Tellico::XML::nsOpenPackageFormat) {
+      myDebug() << "bad namespace:" << metaNode.namespaceURI();
+      return data;
+    }
+
+    // index from document position into author ID
+    QMap<int, QString> authorPositions;
+    //  index from author ID to author name. Could have multiple empty ids so use MultiHash
+    QHash<QString, QString> authorNames;
+    QString coverRef;
+    QStringList publishers, genres;
+    auto childs = metaNode.childNodes();
+    for(int i = 0; i < childs.count(); ++i) {
+      auto child = childs.at(i);
+      if(!child.isElement()) continue;
+      if(child.namespaceURI() != Tellico::XML::nsDublinCore &&
+         child.namespaceURI() != Tellico::XML::nsOpenPackageFormat) continue;
+      const auto elemText = child.toElement().text();
+      if(child.localName() == QLatin1String("title")) {
+        data.fields += qMakePair(QStringLiteral("title"), elemText);
+      } else if(child.localName() == QLatin1String("creator")) {
+        auto elem = child.toElement();
+        auto opfRole = elem.attributeNS(Tellico::XML::nsOpenPackageFormat, QLatin1String("role"));
+        if(!opfRole.isEmpty() && opfRole != QLatin1String("aut")) {
+          continue;
+        }
+        auto id = elem.attribute(QLatin1String("id"));
+        if(id.isEmpty()) id = QLatin1Char('_') + QString::number(authorPositions.size());
+        authorPositions.insert(authorPositions.size(), id);
+        authorNames.insert(id, elemText);
+      } else if(child.localName() == QLatin1String("publisher")) {
+        publishers += elemText;
+      } else if(child.localName() == QLatin1String("subject")) {
+        // subjects as genre instead of keywords
+        genres += elemText;
+      } else if(child.localName() == QLatin1String("date")) {
+        data.fields += qMakePair(QStringLiteral("pub_year"), elemText.left(4));
+      } else if(child.localName() == QLatin1String("description")) {
+        data.fields += qMakePair(QStringLiteral("plot"), elemText);
+      } else if(child.localName() == QLatin1String("identifier")) {
+        QString isbn;
+        if(elemText.startsWith(QLatin1String("urn:isbn:"), Qt::CaseInsensitive)) {
+          isbn = elemText.mid(9);
+        } else {
+          auto elem = child.toElement();
+          if(elem.attributeNS(Tellico::XML::nsOpenPackageFormat, QLatin1String("scheme")) == QLatin1String("ISBN") ||
+             elem.attributeNS(Tellico::XML::nsOpenPackageFormat, QLatin1String("id")) == QLatin1String("ISBN")) {
+            isbn = elemText;
+          }
+        }
+        if(!isbn.isEmpty()) {
+          data.fields += qMakePair(QStringLiteral("isbn"), isbn);
+        }
+      } else if(child.localName() == QLatin1String("meta")) {
+        auto elem = child.toElement();
+        auto refines = elem.attribute(QLatin1String("refines"));
+        if(refines.startsWith(QLatin1Char('#'))) refines = refines.mid(1);
+        if(!refines.isEmpty() && authorNames.contains(refines)) {
+          // remove creators who are not authors
+          if(elem.attribute(QLatin1String("property")) == QLatin1String("role") &&
+             elem.text() != QLatin1String("aut")) {
+            authorNames.remove(refines);
+          }
+        } else if(elem.attribute(QLatin1String("name")) == QLatin1String("cover")) {
+          coverRef = elem.attribute(QLatin1String("content"));
+        }
+      }
+    }
+
+    if(!authorNames.isEmpty()) {
+      // there's probably a better way to do an "ordered hash" where I have a pos, key, and value
+      // and need to lookup by key but sort by pos. This brute force works well enough
+      QStringList authors;
+      for(auto i = authorPositions.cbegin(), end = authorPositions.cend(); i != end; ++i) {
+        const auto& authorId = authorPositions[i.key()];
+        if(authorNames.contains(authorId)) {
+           authors << authorNames[authorId];  // only the valid author names
+         }
+      }
+      data.fields += qMakePair(QStringLiteral("author"), authors.join(Tellico::FieldFormat::delimiterString()));
+    }
+    if(!publishers.isEmpty()) {
+      data.fields += qMakePair(QStringLiteral("publisher"), publishers.join(Tellico::FieldFormat::delimiterString()));
+    }
+    if(!genres.isEmpty()) {
+      data.fields += qMakePair(QStringLiteral("genre"), genres.join(Tellico::FieldFormat::delimiterString()));
+    }
+
+    if(!coverRef.isEmpty()) {
+      auto manifestNode = dom.documentElement().namedItem(QLatin1String("manifest")).toElement();
+      if(manifestNode.isElement() && manifestNode.namespaceURI() == Tellico::XML::nsOpenPackageFormat) {
+        auto items = manifestNode.toElement().elementsByTagNameNS(Tellico::XML::nsOpenPackageFormat,
+                                                                  QLatin1String("item"));
+        for(int i = 0; i < items.count(); ++i) {
+          auto item = items.at(i).toElement();
+          if(item.attribute(QLatin1String("id")) == coverRef) {
+            auto href = item.attribute(QLatin1String("href"));
+            const auto mediaType = item.attribute(QLatin1String("media-type"));
+            auto formats = QImageReader::imageFormatsForMimeType(mediaType.toLatin1());
+            if(formats.isEmpty()) {
+              myDebug() << "No image reader for" << mediaType;
+            } else {
+              // href is relative to rootPath
+              if(rootPath.contains(QLatin1Char('/'))) {
+                href = rootPath.section(QLatin1Char('/'), 0, -2) + QLatin1Char('/') + href;
+              }
+              const KArchiveEntry* coverEntry = topDir->entry(href);
+              if(coverEntry && coverEntry->isFile()) {
+                data.cover = static_cast<const KArchiveFile*>(coverEntry)->data();
+                data.coverFormat = QString::fromLatin1(formats.first());
+              }
+            }
+            break;
+          }
+        }
+      }
+    }
+
+    data.isValid = true;
+    return data;
+  }
+
 }
 
 using Tellico::FileReaderBook;
@@ -52,6 +227,9 @@ public:
 
   // cache the icon image ids to avoid repeated creation of Data::Image objects
   QHash<QString, QString> iconImageId;
+  QMutex epubMutex;
+  // epub files which were read ahead of time in readFile()
+  QHash<QUrl, EpubData> epubData;
 };
 
 FileReaderBook::FileReaderBook(const QUrl& url_) : FileReaderMetaData(url_), d(new Private) {
@@ -59,6 +237,24 @@ FileReaderBook::FileReaderBook(const QUrl& url_) : FileReaderMetaData(url_), d(n
 
 FileReaderBook::~FileReaderBook() = default;
 
+bool FileReaderBook::canRead(const KFileItem& item) const {
+  return item.mimetype() == QLatin1String("application/epub+zip") ||
+         item.mimetype() == QLatin1String("application/pdf") ||
+         item.mimetype() == QLatin1String("application/fb2+zip") ||
+         item.mimetype() == QLatin1String("application/fb2+xml") ||
+         item.mimetype() == QLatin1String("application/x-mobipocket-ebook");
+}
+
+void FileReaderBook::readFile(const KFileItem& item) {
+  if(item.mimetype() == QLatin1String("application/epub+zip")) {
+    const EpubData data = readEpubData(item.url().toLocalFile());
+    QMutexLocker lock(&d->epubMutex);
+    d->epubData.insert(item.url(), data);
+  } else if(canRead(item)) {
+    FileReaderMetaData::readFile(item);
+  }
+}
+
 bool FileReaderBook::populate(Data::EntryPtr entry, const KFileItem& item) {
   bool goodRead = false;
   // reads pdf and ebooks
@@ -93,166 +289,31 @@ bool FileReaderBook::populate(Data::EntryPtr entry, const KFileItem& item) {
 }
 
 bool FileReaderBook::readEpub(Data::EntryPtr entry, const KFileItem& item) {
-  KZip zip(item.url().toLocalFile());
-  if(!zip.open(QIODevice::ReadOnly)) {
-    myDebug() << "can't open zip";
-    return false;
+  EpubData data;
+  bool haveData = false;
+  {
+    QMutexLocker lock(&d->epubMutex);
+    auto it = d->epubData.find(item.url());
+    if(it != d->epubData.end()) {
+      data = it.value();
+      d->epubData.erase(it);
+      haveData = true;
+    }
   }
-
-  const KArchiveDirectory* topDir = zip.directory();
-  const KArchiveEntry* container = topDir->entry(QStringLiteral("META-INF/container.xml"));
-  if(!container || !container->isFile()) {
-    myDebug() << "no container node";
-    return false;
+  if(!haveData) {
+    data = readEpubData(item.url().toLocalFile());
   }
-
-  const QByteArray containerData = static_cast<const KArchiveFile*>(container)->data();
-  QDomDocument dom;
-#if (QT_VERSION < QT_VERSION_CHECK(6, 5, 0))
-  if(!dom.setContent(containerData, false /* namespace processing */)) {
-#else
-  if(!dom.setContent(containerData, QDomDocument::ParseOption::Default)) {
-#endif
-    return false;
-  }
-  QDomNode n = dom.documentElement().namedItem(QLatin1String("rootfiles"))
-                                    .namedItem(QLatin1String("rootfile"));
-  const auto rootPath = n.toElement().attribute(QLatin1String("full-path"));
-  const KArchiveEntry* rootFile = topDir->entry(rootPath);
-  if(!rootFile || !rootFile->isFile()) {
-    myDebug() << "no root file";
-    return false;
-  }
-  const QByteArray rootData = static_cast<const KArchiveFile*>(rootFile)->data();
-#if (QT_VERSION < QT_VERSION_CHECK(6, 5, 0))
-  if(!dom.setContent(rootData, true /* namespace processing */)) {
-#else
-  if(!dom.setContent(rootData, QDomDocument::ParseOption::UseNamespaceProcessing)) {
-#endif
-    myDebug() << "bad root data";
+  if(!data.isValid) {
     return false;
   }
 
-  auto metaNode = dom.documentElement().namedItem(QLatin1String("metadata")).toElement();
-  if(metaNode.isNull() || metaNode.namespaceURI() != XML::nsOpenPackageFormat) {
-    myDebug() << "bad namespace:" << metaNode.namespaceURI();
-    return false;
+  for(const auto& field : std::as_const(data.fields)) {
+    entry->setField(field.first, field.second);
   }
-
-  // index from document position into author ID
-  QMap<int, QString> authorPositions;
-  //  index from author ID to author name. Could have multiple empty ids so use MultiHash
-  QHash<QString, QString> authorNames;
-  QString coverRef;
-  QStringList publishers, genres;
-  auto childs = metaNode.childNodes();
-  for(int i = 0; i < childs.count(); ++i) {
-    auto child = childs.at(i);
-    if(!child.isElement()) continue;
-    if(child.namespaceURI() != XML::nsDublinCore &&
-       child.namespaceURI() != XML::nsOpenPackageFormat) continue;
-    const auto elemText = child.toElement().text();
-    if(child.localName() == QLatin1String("title")) {
-      entry->setField(QStringLiteral("title"), elemText);
-    } else if(child.localName() == QLatin1String("creator")) {
-      auto elem = child.toElement();
-      auto opfRole = elem.attributeNS(XML::nsOpenPackageFormat, QLatin1String("role"));
-      if(!opfRole.isEmpty() && opfRole != QLatin1String("aut")) {
-        continue;
-      }
-      auto id = elem.attribute(QLatin1String("id"));
-      if(id.isEmpty()) id = QLatin1Char('_') + QString::number(authorPositions.size());
-      authorPositions.insert(authorPositions.size(), id);
-      authorNames.insert(id, elemText);
-    } else if(child.localName() == QLatin1String("publisher")) {
-      publishers += elemText;
-    } else if(child.localName() == QLatin1String("subject")) {
-      // subjects as genre instead of keywords
-      genres += elemText;
-    } else if(child.localName() == QLatin1String("date")) {
-      entry->setField(QStringLiteral("pub_year"), elemText.left(4));
-    } else if(child.localName() == QLatin1String("description")) {
-      entry->setField(QStringLiteral("plot"), elemText);
-    } else if(child.localName() == QLatin1String("identifier")) {
-      QString isbn;
-      if(elemText.startsWith(QLatin1String("urn:isbn:"), Qt::CaseInsensitive)) {
-        isbn = elemText.mid(9);
-      } else {
-        auto elem = child.toElement();
-        if(elem.attributeNS(XML::nsOpenPackageFormat, QLatin1String("scheme")) == QLatin1String("ISBN") ||
-           elem.attributeNS(XML::nsOpenPackageFormat, QLatin1String("id")) == QLatin1String("ISBN")) {
-          isbn = elemText;
-        }
-      }
-      if(!isbn.isEmpty()) {
-        entry->setField(QStringLiteral("isbn"), isbn);
-      }
-    } else if(child.localName() == QLatin1String("meta")) {
-      auto elem = child.toElement();
-      auto refines = elem.attribute(QLatin1String("refines"));
-      if(refines.startsWith(QLatin1Char('#'))) refines = refines.mid(1);
-      if(!refines.isEmpty() && authorNames.contains(refines)) {
-        // remove creators who are not authors
-        if(elem.attribute(QLatin1String("property")) == QLatin1String("role") &&
-           elem.text() != QLatin1String("aut")) {
-          authorNames.remove(refines);
-        }
-      } else if(elem.attribute(QLatin1String("name")) == QLatin1String("cover")) {
-        coverRef = elem.attribute(QLatin1String("content"));
-      }
-    }
-  }
-
-  if(!authorNames.isEmpty()) {
-    // there's probably a better way to do an "ordered hash" where I have a pos, key, and value
-    // and need to lookup by key but sort by pos. This brute force works well enough
-    QStringList authors;
-    for(auto i = authorPositions.cbegin(), end = authorPositions.cend(); i != end; ++i) {
-      const auto& authorId = authorPositions[i.key()];
-      if(authorNames.contains(authorId)) {
-         authors << authorNames[authorId];  // only the valid author names
-       }
-    }
-    entry->setField(QStringLiteral("author"), authors.join(FieldFormat::delimiterString()));
-  }
-  if(!publishers.isEmpty()) {
-    entry->setField(QStringLiteral("publisher"), publishers.join(FieldFormat::delimiterString()));
-  }
-  if(!genres.isEmpty()) {
-    entry->setField(QStringLiteral("genre"), genres.join(FieldFormat::delimiterString()));
-  }
-
-  if(!coverRef.isEmpty()) {
-    auto manifestNode = dom.documentElement().namedItem(QLatin1String("manifest")).toElement();
-    if(manifestNode.isElement() && manifestNode.namespaceURI() == XML::nsOpenPackageFormat) {
-      auto items = manifestNode.toElement().elementsByTagNameNS(XML::nsOpenPackageFormat,
-                                                                QLatin1String("item"));
-      for(int i = 0; i < items.count(); ++i) {
-        auto item = items.at(i).toElement();
-        if(item.attribute(QLatin1String("id")) == coverRef) {
-          auto href = item.attribute(QLatin1String("href"));
-          const auto mediaType = item.attribute(QLatin1String("media-type"));
-          auto formats = QImageReader::imageFormatsForMimeType(mediaType.toLatin1());
-          if(formats.isEmpty()) {
-            myDebug() << "No image reader for" << mediaType;
-          } else {
-            // href is relative to rootPath
-            if(rootPath.contains(QLatin1Char('/'))) {
-              href = rootPath.section(QLatin1Char('/'), 0, -2) + QLatin1Char('/') + href;
-            }
-            const KArchiveEntry* coverEntry = topDir->entry(href);
-            if(coverEntry && coverEntry->isFile()) {
-              const QString id = ImageFactory::addImage(static_cast<const KArchiveFile*>(coverEntry)->data(),
-                                                        QString::fromLatin1(formats.first()));
-              entry->setField(QStringLiteral("cover"), id);
-            }
-          }
-          break;
-        }
-      }
-    }
+  if(!data.cover.isEmpty()) {
+    const QString id = ImageFactory::addImage(data.cover, data.coverFormat);
+    entry->setField(QStringLiteral("cover"), id);
   }
-
   return true;
 }
 
@@ -332,7 +393,7 @@ void FileReaderBook::setCover(Data::EntryPtr entry, const KFileItem& item) {
   const QString cover = QStringLiteral("cover");
   QPixmap pixmap;
   if(useFilePreview()) {
-    pixmap = Tellico::NetAccess::filePreview(item, FILE_PREVIEW_SIZE);
+    pixmap = filePreview(item, FILE_PREVIEW_SIZE);
   }
   if(pixmap.isNull()) {
     if(d->iconImageId.contains(item.iconName())) {
@@ -35,6 +35,8 @@ public:
   FileReaderBook(const QUrl& u);
   virtual ~FileReaderBook();
 
+  virtual bool canRead(const KFileItem& fileItem) const override;
+  virtual void readFile(const KFileItem& fileItem) override;
   virtual bool populate(Data::EntryPtr entry, const KFileItem& fileItem) override;
 
 private:
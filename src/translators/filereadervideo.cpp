@@ -37,10 +37,16 @@
 #include <QPixmap>
 #include <QIcon>
 #include <QFileInfo>
+#include <QFile>
 #include <QDomDocument>
 
 namespace {
   static const int FILE_PREVIEW_SIZE = 128;
+
+  QString nfoFileName(const KFileItem& item_) {
+    QFileInfo info(item_.localPath());
+    return info.path() + QLatin1Char('/') + info.completeBaseName() + QLatin1String(".nfo");
+  }
 }
 
 using Tellico::FileReaderVideo;
@@ -51,6 +57,9 @@ public:
 
   // cache the icon image ids to avoid repeated creation of Data::Image objects
   QHash<QString, QString> iconImageId;
+  QMutex nfoMutex;
+  // NFO files which were read ahead of time in readFile()
+  QHash<QString, QByteArray> nfoData;
 };
 
 FileReaderVideo::FileReaderVideo(const QUrl& url_) : FileReaderMetaData(url_), d(new Private) {
@@ -58,9 +67,26 @@ FileReaderVideo::FileReaderVideo(const QUrl& url_) : FileReaderMetaData(url_), d
 
 FileReaderVideo::~FileReaderVideo() = default;
 
-bool FileReaderVideo::populate(Data::EntryPtr entry, const KFileItem& item) {
+bool FileReaderVideo::canRead(const KFileItem& item) const {
   // reads video files
-  if(!item.mimetype().startsWith(QLatin1String("video"))) {
+  return item.mimetype().startsWith(QLatin1String("video"));
+}
+
+void FileReaderVideo::readFile(const KFileItem& item) {
+  if(!canRead(item)) {
+    return;
+  }
+  FileReaderMetaData::readFile(item);
+  QFile nfoFile(nfoFileName(item));
+  if(nfoFile.exists() && nfoFile.open(QIODevice::ReadOnly)) {
+    const QByteArray data = nfoFile.readAll();
+    QMutexLocker lock(&d->nfoMutex);
+    d->nfoData.insert(nfoFile.fileName(), data);
+  }
+}
+
+bool FileReaderVideo::populate(Data::EntryPtr entry, const KFileItem& item) {
+  if(!canRead(item)) {
     return false;
   }
   bool isEmpty = true;
@@ -115,7 +141,7 @@ bool FileReaderVideo::populate(Data::EntryPtr entry, const KFileItem& item) {
 
   // look for an NFO file
   QFileInfo info(item.localPath());
-  const QString nfoFile = info.path() + QLatin1Char('/') + info.completeBaseName() + QLatin1String(".nfo");
+  const QString nfoFile = nfoFileName(item);
   if(QFileInfo::exists(nfoFile)) {
     myLog() << "Reading" << nfoFile;
     isEmpty = !populateNfo(entry, nfoFile);
@@ -139,7 +165,7 @@ bool FileReaderVideo::populate(Data::EntryPtr entry, const KFileItem& item) {
   } else {
     QPixmap pixmap;
     if(useFilePreview()) {
-      pixmap = Tellico::NetAccess::filePreview(item, FILE_PREVIEW_SIZE);
+      pixmap = filePreview(item, FILE_PREVIEW_SIZE);
     }
     if(pixmap.isNull()) {
       if(d->iconImageId.contains(item.iconName())) {
@@ -164,8 +190,14 @@ bool FileReaderVideo::populate(Data::EntryPtr entry, const KFileItem& item) {
 }
 
 bool FileReaderVideo::populateNfo(Data::EntryPtr entry_, const QString& nfoFile_) {
-  const QUrl nfoUrl(QUrl::fromLocalFile(nfoFile_));
-  const auto nfoData = FileHandler::readDataFile(nfoUrl);
+  QByteArray nfoData;
+  {
+    QMutexLocker lock(&d->nfoMutex);
+    nfoData = d->nfoData.take(nfoFile_);
+  }
+  if(nfoData.isEmpty()) {
+    nfoData = FileHandler::readDataFile(QUrl::fromLocalFile(nfoFile_));
+  }
   if(nfoData.isEmpty()) return false;
 
   QDomDocument dom;
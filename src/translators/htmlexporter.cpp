@@ -295,6 +295,59 @@ QString HTMLExporter::text() {
   return allText;
 }
 
+bool HTMLExporter::writeEntryPages(QIODevice* device_, const QString& pageSeparator_, const QUrl& baseUrl_) {
+  const Data::EntryList allEntries = entries();
+  QTextStream ts(device_);
+  ts.setEncoding(QStringConverter::Utf8);
+
+  m_cancelled = false;
+  bool wroteHead = false;
+  QString htmlEnd;
+  foreach(Data::EntryPtr entry, allEntries) {
+    if(m_cancelled) {
+      break;
+    }
+    setEntries(Data::EntryList() << entry);
+    const QString page = text();
+    // the head of the first page is used for the whole document
+    int bodyStart = page.indexOf(QLatin1String("<body"), 0, Qt::CaseInsensitive);
+    if(bodyStart > -1) {
+      bodyStart = page.indexOf(QLatin1Char('>'), bodyStart);
+    }
+    const int bodyEnd = page.lastIndexOf(QLatin1String("</body"), -1, Qt::CaseInsensitive);
+    if(bodyStart < 0 || bodyEnd < bodyStart) {
+      myDebug() << "no body for entry" << entry->id();
+      continue;
+    }
+    ++bodyStart;
+    if(wroteHead) {
+      ts << pageSeparator_;
+    } else {
+      QString head = page.left(bodyStart);
+      if(!baseUrl_.isEmpty()) {
+        // relative links in the template are resolved against the base url, not the output file
+        int headStart = head.indexOf(QLatin1String("<head"), 0, Qt::CaseInsensitive);
+        if(headStart > -1) {
+          headStart = head.indexOf(QLatin1Char('>'), headStart);
+        }
+        if(headStart > -1) {
+          head.insert(headStart + 1, QLatin1String("<base href=\"") +
+                                     baseUrl_.toString(QUrl::FullyEncoded).toHtmlEscaped() +
+                                     QLatin1String("\"/>"));
+        }
+      }
+      ts << head;
+      htmlEnd = page.mid(bodyEnd);
+      wroteHead = true;
+    }
+    ts << QStringView(page).mid(bodyStart, bodyEnd - bodyStart);
+  }
+  ts << htmlEnd;
+  ts.flush();
+  setEntries(allEntries);
+  return wroteHead && ts.status() == QTextStream::Ok;
+}
+
 void HTMLExporter::setFormattingOptions(Tellico::Data::CollPtr coll) {
   QString file = Data::Document::self()->URL().fileName();
   if(file != TC_I18N1(Tellico::untitledFilename)) {
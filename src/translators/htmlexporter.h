@@ -85,6 +85,16 @@ public:
   void setCustomHtml(const QString& html_) { m_customHtml = html_; }
 
   QString text();
+  /**
+   * Writes a page for every entry into a single HTML document. Each entry is transformed on its
+   * own and only the body of its page is written, so the whole document is never held in memory.
+   *
+   * @param device The device for the UTF-8 output
+   * @param pageSeparator The HTML to put between the pages
+   * @param baseUrl The base url for relative links, if the document is not written next to the template
+   * @return true if at least one page was written
+   */
+  bool writeEntryPages(QIODevice* device, const QString& pageSeparator, const QUrl& baseUrl = QUrl());
 
 public Q_SLOTS:
   void slotCancel();
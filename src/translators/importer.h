@@ -31,6 +31,7 @@
 #include <QObject>
 #include <QString>
 #include <QUrl>
+#include <QPair>
 
 class QWidget;
 
@@ -41,6 +42,17 @@ namespace Tellico {
       ImportShowImageErrors = 1 << 1
     };
 
+/**
+ * The changes to the current collection found by an importer which is updating it
+ * from the same files which were originally imported.
+ */
+struct UpdateResult {
+  // the existing entries, each paired with an entry holding the values read from the changed files
+  QList<QPair<Data::EntryPtr, Data::EntryPtr> > modifiedEntries;
+  // the existing entries whose files no longer exist
+  Data::EntryList missingEntries;
+};
+
 /**
  * The top-level abstract class for importing other document formats into Tellico.
  *
@@ -112,6 +124,16 @@ public:
    * Sets a pointer to the existing collection in case importers need to use existing field information
    */
   void setCurrentCollection(Data::CollPtr coll) { m_currentCollection = coll; }
+  /**
+   * Returns whether the importer can update the current collection, reading only the files
+   * which are new or have changed since they were imported.
+   */
+  virtual bool canUpdate() const { return false; }
+  /**
+   * For an update, the collection only contains the entries for new files. The entries for
+   * modified or missing files are returned here.
+   */
+  const UpdateResult& updateResult() const { return m_updateResult; }
 
 public Q_SLOTS:
   /**
@@ -140,6 +162,7 @@ protected:
    * @param msg A string containing a warning or error.
    */
   void setStatusMessage(const QString& msg) { if(!msg.isEmpty()) m_statusMsg += msg + QLatin1Char(' '); }
+  void setUpdateResult(const UpdateResult& result) { m_updateResult = result; }
 
   static const uint s_stepSize;
 
@@ -149,6 +172,7 @@ private:
   QString m_text;
   QString m_statusMsg;
   Data::CollPtr m_currentCollection;
+  UpdateResult m_updateResult;
 };
 
   } // end namespace
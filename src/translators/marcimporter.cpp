@@ -23,9 +23,13 @@
  ***************************************************************************/
 
 #include "marcimporter.h"
+#include "marcreader.h"
 #include "../translators/xslthandler.h"
 #include "../translators/tellicoimporter.h"
 #include "../core/filehandler.h"
+#include "../collection.h"
+#include "../entry.h"
+#include "../field.h"
 #include "../utils/datafileregistry.h"
 #include "../tellico_debug.h"
 
@@ -35,12 +39,76 @@
 #include <KConfigGroup>
 
 #include <QProcess>
+#include <QFile>
+#include <QXmlStreamWriter>
+#include <QApplication>
 #include <QStandardPaths>
 #include <QGroupBox>
 #include <QVBoxLayout>
 #include <QFormLayout>
 
 using Tellico::Import::MarcImporter;
+using Tellico::Import::MarcField;
+using Tellico::Import::MarcRecord;
+using Tellico::Import::MarcReader;
+
+namespace {
+  // number of records to read before converting them and adding them to the collection
+  static const int MARC_BATCH_SIZE = 100;
+
+  // control characters other than whitespace are not valid in XML
+  QString xmlText(const QString& text_) {
+    QString text = text_;
+    for(int i = text.size()-1; i >= 0; --i) {
+      const ushort c = text.at(i).unicode();
+      if(c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D) {
+        text.remove(i, 1);
+      }
+    }
+    return text;
+  }
+
+  QString indicatorText(QChar ind_) {
+    return ind_.isNull() ? QStringLiteral(" ") : QString(ind_);
+  }
+
+  // the records are written as MARCXML, the same as yaz-marcdump output
+  QString marcXml(const QList<MarcRecord>& records_) {
+    QString xml;
+    QXmlStreamWriter w(&xml);
+    w.writeStartDocument();
+    w.writeDefaultNamespace(QStringLiteral("http://www.loc.gov/MARC21/slim"));
+    w.writeStartElement(QStringLiteral("collection"));
+    for(const MarcRecord& record : records_) {
+      w.writeStartElement(QStringLiteral("record"));
+      w.writeTextElement(QStringLiteral("leader"), xmlText(record.leader()));
+      for(const MarcField& field : record.fields()) {
+        if(field.isControlField()) {
+          w.writeStartElement(QStringLiteral("controlfield"));
+          w.writeAttribute(QStringLiteral("tag"), field.tag());
+          w.writeCharacters(xmlText(field.data()));
+          w.writeEndElement();
+          continue;
+        }
+        w.writeStartElement(QStringLiteral("datafield"));
+        w.writeAttribute(QStringLiteral("tag"), field.tag());
+        w.writeAttribute(QStringLiteral("ind1"), indicatorText(field.indicator1()));
+        w.writeAttribute(QStringLiteral("ind2"), indicatorText(field.indicator2()));
+        for(const auto& subfield : field.subfieldList()) {
+          w.writeStartElement(QStringLiteral("subfield"));
+          w.writeAttribute(QStringLiteral("code"), QString(subfield.first));
+          w.writeCharacters(xmlText(subfield.second));
+          w.writeEndElement();
+        }
+        w.writeEndElement();
+      }
+      w.writeEndElement();
+    }
+    w.writeEndElement();
+    w.writeEndDocument();
+    return xml;
+  }
+}
 
 MarcImporter::MarcImporter(const QUrl& url_) : Tellico::Import::Importer(url_)
     , m_coll(nullptr)
@@ -69,12 +137,6 @@ Tellico::Data::CollPtr MarcImporter::collection() {
     return m_coll;
   }
 
-  m_marcdump = QStandardPaths::findExecutable(QStringLiteral("yaz-marcdump"));
-  if(m_marcdump.isEmpty()) {
-    myDebug() << "Could not find yaz-marcdump executable";
-    return Data::CollPtr();
-  }
-
   if(urls().count() > 1) {
     myDebug() << "MarcImporter only importing first file";
   }
@@ -104,13 +166,112 @@ Tellico::Data::CollPtr MarcImporter::collection() {
   if(m_marcCharSet.isEmpty()) {
     m_marcCharSet = QStringLiteral("UTF-8");
   }
+
+  return readRecords(url);
+}
+
+// the records are read one at a time and converted in batches with the same stylesheets
+// used for the yaz-marcdump output, so the whole file is never in memory, nor all of the intermediate XML
+Tellico::Data::CollPtr MarcImporter::readRecords(const QUrl& url_) {
+  QFile file(url_.toLocalFile());
+  if(!file.open(QIODevice::ReadOnly)) {
+    myDebug() << "unable to open" << file.fileName();
+    setStatusMessage(i18n("Tellico was unable to read any data."));
+    return Data::CollPtr();
+  }
+
+  MarcReader reader(&file);
+  reader.setCharacterSet(m_marcCharSet);
+  if(!reader.canDecode()) {
+    // yaz knows more character sets than we do, MARC-8 in particular
+    myDebug() << "falling back to yaz-marcdump for" << m_marcCharSet;
+    file.close();
+    return readMarcDump(url_);
+  }
+
+  if(!initMARCHandler() || !initMODSHandler()) {
+    return Data::CollPtr();
+  }
+
+  const bool showProgress = options() & ImportProgress;
+  if(showProgress) {
+    Q_EMIT signalTotalSteps(this, file.size());
+  }
+
+  QList<MarcRecord> records;
+  MarcRecord record;
+  bool atEnd = false;
+  while(!m_cancelled && !atEnd) {
+    atEnd = !reader.readNext(record);
+    if(!atEnd) {
+      records += record;
+    }
+    if(records.count() >= MARC_BATCH_SIZE || (atEnd && !records.isEmpty())) {
+      addBatch(marcXml(records));
+      records.clear();
+      if(showProgress) {
+        Q_EMIT signalProgress(this, file.pos());
+        qApp->processEvents();
+      }
+    }
+  }
+
+  if(m_cancelled) {
+    m_coll = Data::CollPtr();
+    return m_coll;
+  }
+  // reading a non-MARC file results in an error right away
+  if(!m_coll || m_coll->entryCount() == 0) {
+    setStatusMessage(i18n("Tellico was unable to read any data."));
+    m_coll = Data::CollPtr();
+  }
+  return m_coll;
+}
+
+void MarcImporter::addBatch(const QString& marcxml_) {
+  const QString mods = m_MARCHandler->applyStylesheet(marcxml_);
+  const QString output = m_MODSHandler->applyStylesheet(mods);
+  Import::TellicoImporter imp(output);
+  imp.setOptions(imp.options() ^ Import::ImportProgress); // no progress needed
+  Data::CollPtr coll = imp.collection();
+  if(!coll) {
+    return;
+  }
+  if(!m_coll) {
+    m_coll = coll;
+    return;
+  }
+
+  // the stylesheet only adds the extra fields that a batch uses
+  foreach(Data::FieldPtr field, coll->fields()) {
+    Data::FieldPtr currField = m_coll->fieldByName(field->name());
+    if(!currField) {
+      m_coll->addField(Data::FieldPtr(new Data::Field(*field)));
+    } else if(field->hasFlag(Data::Field::AllowMultiple) && !currField->hasFlag(Data::Field::AllowMultiple)) {
+      currField->setFlags(currField->flags() | Data::Field::AllowMultiple);
+    }
+  }
+  Data::EntryList entries = coll->entries();
+  foreach(Data::EntryPtr entry, entries) {
+    entry->setCollection(m_coll);
+  }
+  m_coll->addEntries(entries);
+}
+
+Tellico::Data::CollPtr MarcImporter::readMarcDump(const QUrl& url_) {
+  m_marcdump = QStandardPaths::findExecutable(QStringLiteral("yaz-marcdump"));
+  if(m_marcdump.isEmpty()) {
+    myDebug() << "Could not find yaz-marcdump executable";
+    return Data::CollPtr();
+  }
+
   QStringList dumpArgs = { QStringLiteral("-f"),
                            m_marcCharSet,
                            QStringLiteral("-t"),
                            QStringLiteral("utf-8"),
                            QStringLiteral("-o"),
                            QStringLiteral("marcxml"),
-                           url.toLocalFile()
+                           url_.toLocalFile()
   };
   QProcess dumpProc;
   dumpProc.start(m_marcdump, dumpArgs);
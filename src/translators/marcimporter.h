@@ -62,6 +62,9 @@ public Q_SLOTS:
   void slotCancel() override;
 
 private:
+  Data::CollPtr readRecords(const QUrl& url);
+  Data::CollPtr readMarcDump(const QUrl& url);
+  void addBatch(const QString& marcxml);
   bool initMARCHandler();
   bool initMODSHandler();
 
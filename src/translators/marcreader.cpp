@@ -0,0 +1,244 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "marcreader.h"
+#include "../utils/iso5426converter.h"
+#include "../utils/iso6937converter.h"
+#include "../tellico_debug.h"
+
+#include <QIODevice>
+
+namespace {
+  static const int MARC_LEADER_LENGTH = 24;
+  static const int MARC_DIRECTORY_ENTRY_LENGTH = 12;
+  static const char MARC_RECORD_TERMINATOR = '\x1D';
+  static const char MARC_FIELD_TERMINATOR = '\x1E';
+  static const char MARC_SUBFIELD_DELIMITER = '\x1F';
+  static const char* MARC_XML_NAMESPACE = "http://www.loc.gov/MARC21/slim";
+}
+
+using Tellico::Import::MarcField;
+using Tellico::Import::MarcRecord;
+using Tellico::Import::MarcReader;
+
+void MarcRecord::clear() {
+  m_leader.clear();
+  m_fields.clear();
+}
+
+MarcReader::MarcReader(QIODevice* device_) : m_device(device_)
+    , m_charSet(Utf8)
+    , m_isXml(false)
+    , m_hasError(false) {
+  Q_ASSERT(m_device);
+  // an ISO 2709 record always starts with the five digit record length
+  // so anything starting with a bracket is assumed to be MARCXML
+  const QByteArray start = m_device->peek(1024).trimmed();
+  m_isXml = start.startsWith('<') || start.startsWith("\xEF\xBB\xBF<");
+  if(m_isXml) {
+    m_xml.setDevice(m_device);
+  }
+}
+
+void MarcReader::setCharacterSet(const QString& charSet_) {
+  QString charSet = charSet_.toLower();
+  charSet.remove(QLatin1Char('-')).remove(QLatin1Char(' ')).remove(QLatin1Char('_'));
+  if(charSet.isEmpty() || charSet == QLatin1String("utf8")) {
+    m_charSet = Utf8;
+  } else if(charSet == QLatin1String("iso5426")) {
+    m_charSet = Iso5426;
+  } else if(charSet == QLatin1String("iso6937")) {
+    m_charSet = Iso6937;
+  } else {
+    m_decoder = QStringDecoder(charSet_.toLatin1().constData());
+    m_charSet = m_decoder.isValid() ? Other : Unsupported;
+  }
+}
+
+bool MarcReader::canDecode() const {
+  return m_isXml || m_charSet != Unsupported;
+}
+
+bool MarcReader::readNext(Tellico::Import::MarcRecord& record_) {
+  record_.clear();
+  if(m_hasError) {
+    return false;
+  }
+  return m_isXml ? readXml(record_) : readIso2709(record_);
+}
+
+bool MarcReader::readIso2709(Tellico::Import::MarcRecord& record_) {
+  // skip any line breaks or padding between records
+  char c;
+  while(m_device->peek(&c, 1) == 1 &&
+        (c == '\n' || c == '\r' || c == ' ' || c == MARC_RECORD_TERMINATOR)) {
+    m_device->getChar(&c);
+  }
+
+  const QByteArray lengthData = m_device->peek(5);
+  if(lengthData.isEmpty()) {
+    // at the end
+    return false;
+  }
+  bool ok;
+  const int length = lengthData.toInt(&ok);
+  if(!ok || length <= MARC_LEADER_LENGTH) {
+    myDebug() << "invalid record length:" << lengthData;
+    m_hasError = true;
+    return false;
+  }
+
+  const QByteArray data = m_device->read(length);
+  if(data.size() < length) {
+    myDebug() << "truncated record";
+    m_hasError = true;
+    return false;
+  }
+
+  const int base = data.mid(12, 5).toInt(&ok);
+  if(!ok || base <= MARC_LEADER_LENGTH || base > length) {
+    myDebug() << "invalid base address of data:" << data.mid(12, 5);
+    m_hasError = true;
+    return false;
+  }
+  record_.setLeader(QString::fromLatin1(data.constData(), MARC_LEADER_LENGTH));
+  // MARC21 uses position 9 of the leader for the character coding scheme
+  const bool isUtf8 = data.at(9) == 'a';
+
+  for(int pos = MARC_LEADER_LENGTH; pos + MARC_DIRECTORY_ENTRY_LENGTH < base; pos += MARC_DIRECTORY_ENTRY_LENGTH) {
+    if(data.at(pos) == MARC_FIELD_TERMINATOR) {
+      break;
+    }
+    const QString tag = QString::fromLatin1(data.constData() + pos, 3);
+    bool ok1, ok2;
+    const int fieldLength = data.mid(pos + 3, 4).toInt(&ok1);
+    const int fieldStart = base + data.mid(pos + 7, 5).toInt(&ok2);
+    if(!ok1 || !ok2 || fieldStart + fieldLength > length) {
+      myDebug() << "invalid directory entry for" << tag;
+      continue;
+    }
+    QByteArray fieldData = data.mid(fieldStart, fieldLength);
+    if(fieldData.endsWith(MARC_FIELD_TERMINATOR)) {
+      fieldData.chop(1);
+    }
+
+    if(tag.startsWith(QLatin1String("00"))) {
+      record_.addField(MarcField(tag, decode(fieldData, isUtf8)));
+      continue;
+    }
+
+    MarcField field(tag, QString());
+    if(fieldData.size() > 1) {
+      field.setIndicators(QLatin1Char(fieldData.at(0)), QLatin1Char(fieldData.at(1)));
+    }
+    const QList<QByteArray> subfields = fieldData.mid(2).split(MARC_SUBFIELD_DELIMITER);
+    // anything before the first delimiter is not a subfield
+    for(int i = 1; i < subfields.size(); ++i) {
+      const QByteArray& subfield = subfields.at(i);
+      if(!subfield.isEmpty()) {
+        field.addSubfield(QLatin1Char(subfield.at(0)), decode(subfield.mid(1), isUtf8));
+      }
+    }
+    record_.addField(field);
+  }
+  return true;
+}
+
+bool MarcReader::readXml(Tellico::Import::MarcRecord& record_) {
+  // find the start of the next record, SRU responses wrap MARC records in their own record elements
+  while(!m_xml.atEnd()) {
+    m_xml.readNext();
+    if(m_xml.isStartElement() && m_xml.name() == QLatin1String("record") &&
+       (m_xml.namespaceUri().isEmpty() || m_xml.namespaceUri() == QLatin1String(MARC_XML_NAMESPACE))) {
+      break;
+    }
+  }
+  if(m_xml.atEnd()) {
+    if(m_xml.hasError()) {
+      myDebug() << "error reading MARCXML:" << m_xml.errorString();
+      m_hasError = true;
+    }
+    return false;
+  }
+
+  MarcField dataField;
+  bool inDataField = false;
+  while(!m_xml.atEnd()) {
+    m_xml.readNext();
+    if(m_xml.isStartElement()) {
+      const auto name = m_xml.name();
+      const auto attributes = m_xml.attributes();
+      if(name == QLatin1String("leader")) {
+        record_.setLeader(m_xml.readElementText());
+      } else if(name == QLatin1String("controlfield")) {
+        const QString tag = attributes.value(QLatin1String("tag")).toString();
+        record_.addField(MarcField(tag, m_xml.readElementText()));
+      } else if(name == QLatin1String("datafield")) {
+        dataField = MarcField(attributes.value(QLatin1String("tag")).toString(), QString());
+        const auto ind1 = attributes.value(QLatin1String("ind1"));
+        const auto ind2 = attributes.value(QLatin1String("ind2"));
+        dataField.setIndicators(ind1.isEmpty() ? QLatin1Char(' ') : ind1.at(0),
+                                ind2.isEmpty() ? QLatin1Char(' ') : ind2.at(0));
+        inDataField = true;
+      } else if(name == QLatin1String("subfield") && inDataField) {
+        const auto code = attributes.value(QLatin1String("code"));
+        const QString value = m_xml.readElementText();
+        if(!code.isEmpty()) {
+          dataField.addSubfield(code.at(0), value);
+        }
+      }
+    } else if(m_xml.isEndElement()) {
+      if(m_xml.name() == QLatin1String("datafield")) {
+        record_.addField(dataField);
+        inDataField = false;
+      } else if(m_xml.name() == QLatin1String("record")) {
+        return true;
+      }
+    }
+  }
+  if(m_xml.hasError()) {
+    myDebug() << "error reading MARCXML:" << m_xml.errorString();
+    m_hasError = true;
+  }
+  return false;
+}
+
+QString MarcReader::decode(const QByteArray& data_, bool isUtf8_) {
+  if(isUtf8_) {
+    return QString::fromUtf8(data_);
+  }
+  switch(m_charSet) {
+    case Utf8:
+      return QString::fromUtf8(data_);
+    case Iso5426:
+      return Iso5426Converter::toUtf8(data_);
+    case Iso6937:
+      return Iso6937Converter::toUtf8(data_);
+    case Other:
+      return m_decoder.decode(data_);
+    case Unsupported:
+      break;
+  }
+  return QString::fromLatin1(data_);
+}
@@ -0,0 +1,137 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TELLICO_MARCREADER_H
+#define TELLICO_MARCREADER_H
+
+#include <QString>
+#include <QList>
+#include <QPair>
+#include <QStringDecoder>
+#include <QXmlStreamReader>
+
+class QIODevice;
+
+namespace Tellico {
+  namespace Import {
+
+/**
+ * A single variable or control field from a MARC record.
+ */
+class MarcField {
+public:
+  MarcField() {}
+  MarcField(const QString& tag, const QString& data) : m_tag(tag), m_data(data) {}
+
+  QString tag() const { return m_tag; }
+  /**
+   * Control fields, with tags 001 through 009, have data but no subfields.
+   */
+  bool isControlField() const { return m_tag.startsWith(QLatin1String("00")); }
+  QString data() const { return m_data; }
+  QChar indicator1() const { return m_ind1; }
+  QChar indicator2() const { return m_ind2; }
+  void setIndicators(QChar ind1, QChar ind2) { m_ind1 = ind1; m_ind2 = ind2; }
+
+  void addSubfield(QChar code, const QString& value) { m_subfields.append(qMakePair(code, value)); }
+  /**
+   * Returns every subfield code and value, in the order of the record.
+   */
+  const QList<QPair<QChar, QString> >& subfieldList() const { return m_subfields; }
+
+private:
+  QString m_tag;
+  QString m_data;
+  QChar m_ind1;
+  QChar m_ind2;
+  QList<QPair<QChar, QString> > m_subfields;
+};
+
+/**
+ * A MARC record, with the leader and all of its fields.
+ */
+class MarcRecord {
+public:
+  MarcRecord() {}
+
+  QString leader() const { return m_leader; }
+  void setLeader(const QString& leader) { m_leader = leader; }
+
+  const QList<MarcField>& fields() const { return m_fields; }
+  void addField(const MarcField& field) { m_fields.append(field); }
+
+  void clear();
+
+private:
+  QString m_leader;
+  QList<MarcField> m_fields;
+};
+
+/**
+ * Reads MARC records one at a time from either an ISO 2709 file or a MARCXML file,
+ * so that a whole file never has to be held in memory.
+ *
+ * @author Robby Stephenson
+ */
+class MarcReader {
+public:
+  MarcReader(QIODevice* device);
+
+  /**
+   * Sets the character set for the ISO 2709 records which are not encoded in UTF-8.
+   * MARCXML files always use the encoding of the XML document.
+   */
+  void setCharacterSet(const QString& charSet);
+  /**
+   * Returns whether the records in the chosen character set can be decoded. MARC-8, in
+   * particular, is not supported.
+   */
+  bool canDecode() const;
+  /**
+   * Reads the next record from the device.
+   *
+   * @return false if there are no more records or if the data could not be read
+   */
+  bool readNext(MarcRecord& record);
+
+private:
+  Q_DISABLE_COPY(MarcReader)
+
+  enum CharSet { Utf8, Iso5426, Iso6937, Other, Unsupported };
+
+  bool readIso2709(MarcRecord& record);
+  bool readXml(MarcRecord& record);
+  QString decode(const QByteArray& data, bool isUtf8);
+
+  QIODevice* m_device;
+  QXmlStreamReader m_xml;
+  QStringDecoder m_decoder;
+  CharSet m_charSet;
+  bool m_isXml;
+  bool m_hasError;
+};
+
+  } // end namespace
+} // end namespace
+#endif
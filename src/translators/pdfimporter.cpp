@@ -43,12 +43,19 @@
 
 #include <KMessageBox>
 #include <KLocalizedString>
+#include <KFileItem>
 
 #include <QString>
 #include <QPixmap>
 #include <QApplication>
 #include <QFile>
-#include <QScopedPointer>
+#include <QVector>
+#include <QAtomicInt>
+#include <QRegularExpression>
+#include <QHash>
+
+#include <memory>
+#include <vector>
 
 #include <config.h>
 #ifdef HAVE_POPPLER
@@ -57,6 +64,85 @@
 
 namespace {
   static const int PDF_FILE_PREVIEW_SIZE = 196;
+  // the number of files in each file preview job
+  static const int PDF_FILE_PREVIEW_BATCH_SIZE = 50;
+
+  // everything read from a single file by a worker thread, before any entry is created
+  struct PDFData {
+    QUrl url;
+    QString fileName;
+    bool hasXMP = false;
+    // the XMP data, transformed to Tellico XML
+    QString xml;
+    bool hasInfo = false;
+    QString title;
+    QStringList authors;
+    QString keywords;
+    QString doi;
+    QString arxiv;
+  };
+
+  void readPDF(PDFData& pdf_, Tellico::XMPHandler& xmpHandler_, Tellico::XSLTHandler& xsltHandler_) {
+    const QString xmp = xmpHandler_.extractXMP(pdf_.fileName);
+    pdf_.hasXMP = !xmp.isEmpty();
+    if(pdf_.hasXMP) {
+      pdf_.xml = xsltHandler_.applyStylesheet(xmp);
+    }
+
+#ifdef HAVE_POPPLER
+    auto doc = Poppler::Document::load(pdf_.fileName);
+    if(!doc || doc->isLocked()) {
+      return;
+    }
+    pdf_.hasInfo = true;
+    pdf_.title = doc->info(QStringLiteral("Title")).simplified();
+    static const QRegularExpression authorRx(QLatin1String("\\s*(\\s+and\\s+|,|;)\\s*"));
+    pdf_.authors = doc->info(QStringLiteral("Author")).simplified().split(authorRx);
+    pdf_.keywords = doc->info(QStringLiteral("Keywords")).simplified();
+    if(pdf_.keywords.isEmpty()) {
+      pdf_.keywords = doc->info(QStringLiteral("Subject")).simplified();
+    }
+
+    // now parse the first page text and try to guess
+    auto page = doc->page(0);
+    if(!page) {
+      return;
+    }
+    // a null rectangle means get all text on page
+    const QString text = page->text(QRectF());
+    // borrowed from Referencer
+    static const QRegularExpression doiRx(QLatin1String("(?:"
+                                                        "(?:[Dd][Oo][Ii]:? *)"
+                                                        "|"
+                                                        "(?:[Dd]igital *[Oo]bject *[Ii]dentifier:? *)"
+                                                        ")"
+                                                        "("
+                                                        "[^\\.\\s]+"
+                                                        "\\."
+                                                        "[^\\/\\s]+"
+                                                        "\\/"
+                                                        "[^\\s]+"
+                                                        ")"));
+    QRegularExpressionMatch m = doiRx.match(text);
+    if(!m.hasMatch()) {
+      static const QRegularExpression doiUrlRx(QLatin1String("https?://(?:dx\\.)?doi\\.org/(10.\\d{4,9}/[-._;()/:a-zA-Z0-9]+)"));
+      m = doiUrlRx.match(text);
+    }
+    if(m.hasMatch()) {
+      pdf_.doi = m.captured(1);
+    }
+    static const QRegularExpression arxivRx(QLatin1String("arXiv:"
+                                                          "("
+                                                          "[^\\/\\s]+"
+                                                          "[\\/\\.]"
+                                                          "[^\\s]+"
+                                                          ")"));
+    m = arxivRx.match(text);
+    if(m.hasMatch()) {
+      pdf_.arxiv = m.captured(1);
+    }
+#endif
+  }
 }
 
 using Tellico::Import::PDFImporter;
@@ -67,6 +153,11 @@ PDFImporter::PDFImporter(const QUrl& url_) : Importer(url_), m_cancelled(false)
 PDFImporter::PDFImporter(const QList<QUrl>& urls_) : Importer(urls_), m_cancelled(false) {
 }
 
+PDFImporter::~PDFImporter() {
+  m_readerPool.clear();
+  m_readerPool.waitForDone();
+}
+
 bool PDFImporter::canImport(int type_) const {
   return type_ == Data::Collection::Book || type_ == Data::Collection::Bibtex;
 }
@@ -86,6 +177,7 @@ Tellico::Data::CollPtr PDFImporter::collection() {
 
   QUrl u = QUrl::fromLocalFile(xsltFile);
 
+  // the stylesheet is compiled once and shared by all the worker threads
   XSLTHandler xsltHandler(u);
   if(!xsltHandler.isValid()) {
     myWarning() << "invalid xslt in xmp2tellico.xsl";
@@ -102,209 +194,199 @@ Tellico::Data::CollPtr PDFImporter::collection() {
   bool hasDOI = false;
   bool hasArxiv = false;
 
-  uint j = 0;
-
-  Data::CollPtr coll;
+  // the files are handled in batches, so that only one batch of downloaded files,
+  // file previews, and XML is held at any one time
+  const QList<QUrl> list = urls();
   XMPHandler xmpHandler;
-  QList<QUrl> list = urls();
-  for(QList<QUrl>::Iterator it = list.begin(); it != list.end() && !m_cancelled; ++it, ++j) {
-    const QScopedPointer<FileHandler::FileRef> ref(FileHandler::fileRef(*it));
-    if(!ref->isValid()) {
-      continue;
+  QAtomicInt pdfsRead;
+  Data::CollPtr coll;
+  for(int batch = 0; batch < list.count() && !m_cancelled; batch += PDF_FILE_PREVIEW_BATCH_SIZE) {
+    // any remote files are downloaded first, in the main thread
+    std::vector<std::unique_ptr<FileHandler::FileRef>> refs;
+    QVector<PDFData> pdfs;
+    for(int k = batch; k < qMin(batch + PDF_FILE_PREVIEW_BATCH_SIZE, list.count()); ++k) {
+      const QUrl& pdfUrl = list.at(k);
+      std::unique_ptr<FileHandler::FileRef> ref(FileHandler::fileRef(pdfUrl));
+      if(!ref->isValid()) {
+        pdfsRead.ref();
+        continue;
+      }
+      PDFData pdf;
+      pdf.url = pdfUrl;
+      pdf.fileName = ref->fileName();
+      pdfs += pdf;
+      refs.push_back(std::move(ref));
     }
 
-    Data::CollPtr newColl;
-    Data::EntryPtr entry;
+    PDFData* pdfData = pdfs.data();
+    for(int i = 0; i < pdfs.count(); ++i) {
+      m_readerPool.start([&xmpHandler, &xsltHandler, pdfData, &pdfsRead, i]() {
+        readPDF(pdfData[i], xmpHandler, xsltHandler);
+        pdfsRead.ref();
+      });
+    }
 
-    QString xmp = xmpHandler.extractXMP(ref->fileName());
-    //  myDebug() << xmp;
-    if(xmp.isEmpty()) {
-      setStatusMessage(i18n("Tellico was unable to read any metadata from the PDF file."));
-    } else {
-      setStatusMessage(QString());
-#if 0
-      myWarning() << "Remove debug from pdfimporter.cpp";
-      QFile f(QString::fromLatin1("/tmp/test-xmp.xml"));
-      if(f.open(QIODevice::WriteOnly)) {
-        QTextStream t(&f);
-        t << xmp;
+    // the file previews are made in a separate process, so they are generated while the files are read
+    KFileItemList previewItems;
+    for(const PDFData& pdf : std::as_const(pdfs)) {
+      previewItems += KFileItem(QUrl::fromLocalFile(pdf.fileName));
+    }
+    const QHash<QUrl, QPixmap> previews = m_cancelled ? QHash<QUrl, QPixmap>()
+                                                      : NetAccess::filePreviews(previewItems, PDF_FILE_PREVIEW_SIZE);
+
+    while(!m_readerPool.waitForDone(100)) {
+      if(showProgress) {
+        ProgressManager::self()->setProgress(this, pdfsRead.loadRelaxed());
+        qApp->processEvents();
       }
-      f.close();
-#endif
-      Import::TellicoImporter importer(xsltHandler.applyStylesheet(xmp));
-      newColl = importer.collection();
-      if(!newColl || newColl->entryCount() == 0) {
-        myWarning() << "no collection found";
+    }
+    if(showProgress) {
+      ProgressManager::self()->setProgress(this, pdfsRead.loadRelaxed());
+      qApp->processEvents();
+    }
+
+    // the entries are all created in the main thread, in the same order as the files
+    Data::EntryList entries;
+    for(int i = 0; i < pdfs.count() && !m_cancelled; ++i) {
+      const PDFData& pdf = pdfs.at(i);
+      Data::CollPtr newColl;
+      Data::EntryPtr entry;
+
+      if(!pdf.hasXMP) {
         setStatusMessage(i18n("Tellico was unable to read any metadata from the PDF file."));
       } else {
-        entry = newColl->entries().front();
-        hasDOI |= !entry->field(QStringLiteral("doi")).isEmpty();
-        // the XMP handler has a habit of inserting empty values surrounded by parentheses
-        static const QRegularExpression rx(QLatin1String("^\\(\\s*\\)$"));
-        foreach(Data::FieldPtr field, newColl->fields()) {
-          QString value = entry->field(field);
-          if(value.contains(rx)) {
-            entry->setField(field, QString());
+        setStatusMessage(QString());
+        Import::TellicoImporter importer(pdf.xml);
+        newColl = importer.collection();
+        if(!newColl || newColl->entryCount() == 0) {
+          myWarning() << "no collection found";
+          setStatusMessage(i18n("Tellico was unable to read any metadata from the PDF file."));
+        } else {
+          entry = newColl->entries().front();
+          hasDOI |= !entry->field(QStringLiteral("doi")).isEmpty();
+          // the XMP handler has a habit of inserting empty values surrounded by parentheses
+          static const QRegularExpression rx(QLatin1String("^\\(\\s*\\)$"));
+          foreach(Data::FieldPtr field, newColl->fields()) {
+            QString value = entry->field(field);
+            if(value.contains(rx)) {
+              entry->setField(field, QString());
+            }
           }
         }
       }
-    }
 
 #ifdef HAVE_POPPLER
-    if(!newColl) {
-      if(isBook) {
-        newColl = new Data::BookCollection(true);
-      } else {
-        newColl = new Data::BibtexCollection(true);
-      }
-    }
-    if(!entry) {
-      entry = new Data::Entry(newColl);
-      newColl->addEntries(entry);
-    }
-
-    // now load from poppler
-    auto doc = Poppler::Document::load(ref->fileName());
-    if(doc && !doc->isLocked()) {
-      // now the question is, do we overwrite XMP data with Poppler data?
-      // for now, let's say yes conditionally
-      QString s = doc->info(QStringLiteral("Title")).simplified();
-      if(!s.isEmpty()) {
-        entry->setField(QStringLiteral("title"), s);
-      }
-      // author could be separated by commas, "and" or whatever
-      // we're not going to overwrite it
-      if(entry->field(QStringLiteral("author")).isEmpty()) {
-        static const QRegularExpression rx(QLatin1String("\\s*(\\s+and\\s+|,|;)\\s*"));
-        QStringList authors = doc->info(QStringLiteral("Author")).simplified().split(rx);
-        entry->setField(QStringLiteral("author"), authors.join(FieldFormat::delimiterString()));
-      }
-      s = doc->info(QStringLiteral("Keywords")).simplified();
-      if(s.isEmpty()) {
-        s = doc->info(QStringLiteral("Subject")).simplified();
+      if(!newColl) {
+        if(isBook) {
+          newColl = new Data::BookCollection(true);
+        } else {
+          newColl = new Data::BibtexCollection(true);
+        }
       }
-      if(!s.isEmpty()) {
-        // keywords are also separated by semi-colons in poppler
-        entry->setField(QStringLiteral("keyword"), s);
+      if(!entry) {
+        entry = new Data::Entry(newColl);
+        newColl->addEntries(entry);
       }
 
-      // now parse the first page text and try to guess
-      auto page = doc->page(0);
-      if(page) {
-        // a null rectangle means get all text on page
-        QString text = page->text(QRectF());
-        // borrowed from Referencer
-        static const QRegularExpression doiRx(QLatin1String("(?:"
-                                                            "(?:[Dd][Oo][Ii]:? *)"
-                                                            "|"
-                                                            "(?:[Dd]igital *[Oo]bject *[Ii]dentifier:? *)"
-                                                            ")"
-                                                            "("
-                                                            "[^\\.\\s]+"
-                                                            "\\."
-                                                            "[^\\/\\s]+"
-                                                            "\\/"
-                                                            "[^\\s]+"
-                                                            ")"));
-        QRegularExpressionMatch m = doiRx.match(text);
-        if(!m.hasMatch()) {
-          static const QRegularExpression doiUrlRx(QLatin1String("https?://(?:dx\\.)?doi\\.org/(10.\\d{4,9}/[-._;()/:a-zA-Z0-9]+)"));
-          m = doiUrlRx.match(text);
+      if(pdf.hasInfo) {
+        // now the question is, do we overwrite XMP data with Poppler data?
+        // for now, let's say yes conditionally
+        if(!pdf.title.isEmpty()) {
+          entry->setField(QStringLiteral("title"), pdf.title);
+        }
+        // author could be separated by commas, "and" or whatever
+        // we're not going to overwrite it
+        if(entry->field(QStringLiteral("author")).isEmpty()) {
+          entry->setField(QStringLiteral("author"), pdf.authors.join(FieldFormat::delimiterString()));
+        }
+        if(!pdf.keywords.isEmpty()) {
+          // keywords are also separated by semi-colons in poppler
+          entry->setField(QStringLiteral("keyword"), pdf.keywords);
         }
-        if(m.hasMatch()) {
-          const QString doi = m.captured(1);
-          myLog() << "In PDF file, found DOI:" << doi;
-          entry->setField(QStringLiteral("doi"), doi);
+        if(!pdf.doi.isEmpty()) {
+          myLog() << "In PDF file, found DOI:" << pdf.doi;
+          entry->setField(QStringLiteral("doi"), pdf.doi);
           hasDOI = true;
         }
-        static const QRegularExpression arxivRx(QLatin1String("arXiv:"
-                                                              "("
-                                                              "[^\\/\\s]+"
-                                                              "[\\/\\.]"
-                                                              "[^\\s]+"
-                                                              ")"));
-        m = arxivRx.match(text);
-        if(m.hasMatch()) {
-          const QString arxiv = m.captured(1);
-          myLog() << "in PDF file, found arxiv:" << arxiv;
+        if(!pdf.arxiv.isEmpty()) {
+          myLog() << "in PDF file, found arxiv:" << pdf.arxiv;
           if(!entry->collection()->hasField(QStringLiteral("arxiv"))) {
             Data::FieldPtr field(new Data::Field(QStringLiteral("arxiv"), i18n("arXiv ID")));
             field->setCategory(i18n("Publishing"));
             entry->collection()->addField(field);
           }
-          entry->setField(QStringLiteral("arxiv"), arxiv);
+          entry->setField(QStringLiteral("arxiv"), pdf.arxiv);
           hasArxiv = true;
         }
+      } else {
+        myDebug() << "unable to read PDF info (poppler)";
       }
-    } else {
-      myDebug() << "unable to read PDF info (poppler)";
-    }
 #elif defined HAVE_KFILEMETADATA
-    if(!newColl || newColl->entryCount() == 0) {
-      myDebug() << "Reading with metadata";
-      EBookImporter imp(urls());
-      auto ebookColl = imp.collection();
-      if(ebookColl && ebookColl->type() == Data::Collection::Book && !isBook) {
-        newColl = Data::BibtexCollection::convertBookCollection(ebookColl);
-      } else {
-        newColl = ebookColl;
+      if(!newColl || newColl->entryCount() == 0) {
+        myDebug() << "Reading with metadata";
+        EBookImporter imp(urls());
+        auto ebookColl = imp.collection();
+        if(ebookColl && ebookColl->type() == Data::Collection::Book && !isBook) {
+          newColl = Data::BibtexCollection::convertBookCollection(ebookColl);
+        } else {
+          newColl = ebookColl;
+        }
+        if(newColl->entryCount() == 0) {
+          entry = new Data::Entry(newColl);
+          newColl->addEntries(entry);
+        } else {
+          entry = newColl->entries().front();
+        }
       }
-      if(newColl->entryCount() == 0) {
+#else
+      // only recourse is to create an empty collection
+      if(!newColl) {
+        if(isBook) {
+          newColl = new Data::BookCollection(true);
+        } else {
+          newColl = new Data::BibtexCollection(true);
+        }
+      }
+      if(!entry) {
         entry = new Data::Entry(newColl);
         newColl->addEntries(entry);
-      } else {
-        entry = newColl->entries().front();
       }
-    }
-#else
-    // only recourse is to create an empty collection
-    if(!newColl) {
-      if(isBook) {
-        newColl = new Data::BookCollection(true);
-      } else {
-        newColl = new Data::BibtexCollection(true);
-      }
-    }
-    if(!entry) {
-      entry = new Data::Entry(newColl);
-      newColl->addEntries(entry);
-    }
 #endif
 
-    if(!isBook) {
-      entry->setField(QStringLiteral("url"), (*it).url());
-      // always an article?
-      entry->setField(QStringLiteral("entry-type"), QStringLiteral("article"));
-    }
-    QPixmap pix = NetAccess::filePreview(QUrl::fromLocalFile(ref->fileName()), PDF_FILE_PREVIEW_SIZE);
-    if(pix.isNull()) {
-      myDebug() << "No file preview from pdf";
-    } else {
-      // is png best option?
-      QString id = ImageFactory::addImage(pix, QStringLiteral("PNG"));
-      if(!id.isEmpty()) {
-        Data::FieldPtr field = newColl->fieldByName(QStringLiteral("cover"));
-        if(!field && !newColl->imageFields().isEmpty()) {
-          field = newColl->imageFields().front();
-        } else if(!field) {
-          field = Data::Field::createDefaultField(Data::Field::FrontCoverField);
-          newColl->addField(field);
+      if(!isBook) {
+        entry->setField(QStringLiteral("url"), pdf.url.url());
+        // always an article?
+        entry->setField(QStringLiteral("entry-type"), QStringLiteral("article"));
+      }
+      const QPixmap pix = previews.value(QUrl::fromLocalFile(pdf.fileName));
+      if(pix.isNull()) {
+        myDebug() << "No file preview from pdf";
+      } else {
+        // is png best option?
+        QString id = ImageFactory::addImage(pix, QStringLiteral("PNG"));
+        if(!id.isEmpty()) {
+          Data::FieldPtr field = newColl->fieldByName(QStringLiteral("cover"));
+          if(!field && !newColl->imageFields().isEmpty()) {
+            field = newColl->imageFields().front();
+          } else if(!field) {
+            field = Data::Field::createDefaultField(Data::Field::FrontCoverField);
+            newColl->addField(field);
+          }
+          entry->setField(field, id);
         }
-        entry->setField(field, id);
+      }
+      if(coll) {
+        // the other entries are all added to the first collection in one batch
+        entries += newColl->entries();
+      } else {
+        coll = newColl;
       }
     }
-    if(coll) {
-      coll->addEntries(newColl->entries());
-    } else {
-      coll = newColl;
-    }
-
-    if(showProgress) {
-      ProgressManager::self()->setProgress(this, j+1);
-      qApp->processEvents();
+    if(coll && !entries.isEmpty()) {
+      coll->addEntries(entries);
+      entries.clear();
     }
   }
-
   if(m_cancelled || !coll) {
     return Data::CollPtr();
   }
@@ -360,4 +442,5 @@ Tellico::Data::CollPtr PDFImporter::collection() {
 
 void PDFImporter::slotCancel() {
   m_cancelled = true;
+  m_readerPool.clear();
 }
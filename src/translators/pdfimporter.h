@@ -27,15 +27,22 @@
 
 #include "importer.h"
 
+#include <QThreadPool>
+
 namespace Tellico {
   namespace Import {
 
+/**
+ * The XMP and PDF metadata of each file are read by a pool of worker threads, which share a single
+ * compiled stylesheet. The entries are created afterwards, in the same order as the files.
+ */
 class PDFImporter : public Importer {
 Q_OBJECT
 
 public:
   PDFImporter(const QUrl& url);
   PDFImporter(const QList<QUrl>& urls);
+  ~PDFImporter();
 
   virtual bool canImport(int type) const override;
 
@@ -46,6 +53,7 @@ public Q_SLOTS:
 
 private:
   bool m_cancelled;
+  QThreadPool m_readerPool;
 };
 
   }
@@ -24,6 +24,7 @@
 
 #include "tellicoimporter.h"
 #include "tellicoxmlreader.h"
+#include "tellicosnapshot.h"
 #include "tellico_xml.h"
 #include "../images/imagefactory.h"
 #include "../core/tellico_strings.h"
@@ -47,12 +48,12 @@ using Tellico::Import::TellicoImporter;
 
 TellicoImporter::TellicoImporter(const QUrl& url_, bool loadAllImages_) : DataImporter(url_),
     m_loadAllImages(loadAllImages_), m_format(Unknown), m_modified(false),
-    m_cancelled(false), m_hasImages(false), m_buffer(nullptr), m_zip(nullptr), m_imgDir(nullptr) {
+    m_cancelled(false), m_hasImages(false), m_useSnapshot(false), m_addedImageFiles(false), m_buffer(nullptr), m_zip(nullptr), m_imgDir(nullptr) {
 }
 
 TellicoImporter::TellicoImporter(const QString& text_) : DataImporter(text_),
     m_loadAllImages(true), m_format(Unknown), m_modified(false),
-    m_cancelled(false), m_hasImages(false), m_buffer(nullptr), m_zip(nullptr), m_imgDir(nullptr) {
+    m_cancelled(false), m_hasImages(false), m_useSnapshot(false), m_addedImageFiles(false), m_buffer(nullptr), m_zip(nullptr), m_imgDir(nullptr) {
 }
 
 TellicoImporter::~TellicoImporter() {
@@ -153,6 +154,7 @@ void TellicoImporter::loadXMLData(const QByteArray& data_, bool loadImages_) {
 
   if(!m_cancelled) {
     m_hasImages = reader.hasImages();
+    m_addedImageFiles = reader.hasAddedImageFiles();
     m_coll = reader.collection();
   }
 }
@@ -195,20 +197,35 @@ void TellicoImporter::loadZipData() {
     return;
   }
 
-  const QByteArray xmlData = static_cast<const KArchiveFile*>(entry)->data();
   // hack to account for processEvents and deletion
   QPointer<TellicoImporter> thisPtr(this);
-  loadXMLData(xmlData, false);
-  if(!thisPtr) {
-    return;
+  // a snapshot saves parsing the XML data again, if the file hasn't changed since it was written
+  if(m_useSnapshot) {
+    m_coll = TellicoSnapshot::read(url());
   }
   if(!m_coll) {
-    m_format = Error;
-    return;
-  }
+    const QByteArray xmlData = static_cast<const KArchiveFile*>(entry)->data();
+    loadXMLData(xmlData, false);
+    if(!thisPtr) {
+      return;
+    }
+    if(!m_coll) {
+      m_format = Error;
+      return;
+    }
 
-  if(m_cancelled) {
-    return;
+    if(m_cancelled) {
+      return;
+    }
+
+    if(m_useSnapshot) {
+      // images added from files only exist in memory, so the snapshot would not have them
+      if(m_addedImageFiles) {
+        TellicoSnapshot::remove(url());
+      } else {
+        TellicoSnapshot::write(url(), m_coll);
+      }
+    }
   }
 
   const KArchiveEntry* imgDirEntry = dir->entry(QStringLiteral("images"));
@@ -79,6 +79,11 @@ public:
   bool loadImage(const QString& id_);
 
   void setBaseUrl(const QUrl& url) { m_baseUrl = url; }
+  /**
+   * Sets whether a binary snapshot of the collection is used instead of parsing the file,
+   * and written after parsing it. Only local zip files are supported.
+   */
+  void setUseSnapshot(bool useSnapshot) { m_useSnapshot = useSnapshot; }
 
   // take ownership of zip object with images
   std::unique_ptr<KZip> takeImages();
@@ -99,6 +104,8 @@ private:
   bool m_modified;
   bool m_cancelled;
   bool m_hasImages;
+  bool m_useSnapshot;
+  bool m_addedImageFiles;
   StringSet m_images;
   QUrl m_baseUrl;
 
@@ -0,0 +1,412 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <config.h>
+
+#include "tellicosnapshot.h"
+#include "tellico_xml.h"
+#include "../collection.h"
+#include "../collectionfactory.h"
+#include "../collections/bibtexcollection.h"
+#include "../entry.h"
+#include "../field.h"
+#include "../filter.h"
+#include "../borrower.h"
+#include "../images/imagefactory.h"
+#include "../images/imageinfo.h"
+#include "../tellico_debug.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QSet>
+
+namespace {
+  static const quint32 TELLICO_SNAPSHOT_MAGIC = 0x54435350; // "TCSP"
+  // increase the version whenever the layout of the snapshot changes
+  static const qint32 TELLICO_SNAPSHOT_VERSION = 2;
+  // only the most recently written snapshots are kept
+  static const int TELLICO_SNAPSHOT_MAX_COUNT = 20;
+
+  // the snapshot is only valid for the same layout and for the same reader, since a different
+  // version of Tellico might read the same file into a different collection
+  void writeHeader(QDataStream& out_, const QFileInfo& sourceInfo_) {
+    out_ << TELLICO_SNAPSHOT_MAGIC << TELLICO_SNAPSHOT_VERSION
+         << QStringLiteral(TELLICO_VERSION) << quint32(Tellico::XML::syntaxVersion);
+    out_ << sourceInfo_.absoluteFilePath() << qint64(sourceInfo_.size()) << sourceInfo_.lastModified().toMSecsSinceEpoch();
+  }
+
+  // returns false if the snapshot was written with a different layout or reader
+  bool readHeader(QDataStream& in_, QString& path_, qint64& size_, qint64& modified_) {
+    quint32 magic;
+    qint32 version;
+    in_ >> magic >> version;
+    if(in_.status() != QDataStream::Ok || magic != TELLICO_SNAPSHOT_MAGIC || version != TELLICO_SNAPSHOT_VERSION) {
+      return false;
+    }
+    QString readerVersion;
+    quint32 syntaxVersion;
+    in_ >> readerVersion >> syntaxVersion;
+    if(readerVersion != QLatin1String(TELLICO_VERSION) || syntaxVersion != Tellico::XML::syntaxVersion) {
+      return false;
+    }
+    in_ >> path_ >> size_ >> modified_;
+    return in_.status() == QDataStream::Ok;
+  }
+}
+
+using Tellico::Import::TellicoSnapshot;
+
+QString TellicoSnapshot::snapshotFile(const QUrl& url_) {
+  const QByteArray hash = QCryptographicHash::hash(url_.toLocalFile().toUtf8(), QCryptographicHash::Sha1).toHex();
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+       + QLatin1String("/snapshots/") + QLatin1String(hash) + QLatin1String(".snapshot");
+}
+
+Tellico::Data::CollPtr TellicoSnapshot::read(const QUrl& url_) {
+  if(url_.isEmpty() || !url_.isLocalFile()) {
+    return Data::CollPtr();
+  }
+  const QFileInfo sourceInfo(url_.toLocalFile());
+  QFile file(snapshotFile(url_));
+  if(!sourceInfo.exists() || !file.exists() || !file.open(QIODevice::ReadOnly)) {
+    return Data::CollPtr();
+  }
+
+  // the whole snapshot is mapped into memory, rather than being read in pieces
+  uchar* mapped = file.map(0, file.size());
+  const QByteArray data = mapped ? QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), file.size())
+                                 : file.readAll();
+  QDataStream in(data);
+  in.setVersion(QDataStream::Qt_6_0);
+
+  QString path;
+  qint64 size, modified;
+  if(!readHeader(in, path, size, modified)) {
+    myDebug() << "not a valid snapshot for" << url_.fileName();
+    return Data::CollPtr();
+  }
+  if(path != sourceInfo.absoluteFilePath() ||
+     size != sourceInfo.size() ||
+     modified != sourceInfo.lastModified().toMSecsSinceEpoch()) {
+    myLog() << "snapshot is out of date for" << url_.fileName();
+    return Data::CollPtr();
+  }
+
+  qint32 type;
+  QString title;
+  in >> type >> title;
+  Data::CollPtr coll = CollectionFactory::collection(type, false);
+  if(!coll) {
+    return Data::CollPtr();
+  }
+  coll->setTitle(title);
+
+  qint32 fieldCount;
+  in >> fieldCount;
+  Data::FieldList fields;
+  for(int i = 0; i < fieldCount && in.status() == QDataStream::Ok; ++i) {
+    QString name, fieldTitle, category, description;
+    qint32 fieldType, flags, formatType;
+    QStringList allowed;
+    StringMap properties;
+    in >> name >> fieldTitle >> category >> description >> fieldType >> flags >> formatType >> allowed >> properties;
+    Data::FieldPtr field(fieldType == Data::Field::Choice ?
+                         new Data::Field(name, fieldTitle, allowed) :
+                         new Data::Field(name, fieldTitle, static_cast<Data::Field::Type>(fieldType)));
+    field->setCategory(category);
+    field->setFlags(flags);
+    field->setFormatType(static_cast<FieldFormat::Type>(formatType));
+    field->setDescription(description);
+    field->setPropertyList(properties);
+    fields += field;
+  }
+  coll->addFields(fields);
+  // the entry values refer to the fields by position, and the collection might use its own field objects
+  Data::FieldList collFields;
+  foreach(Data::FieldPtr field, fields) {
+    collFields += coll->fieldByName(field->name());
+  }
+
+  if(coll->type() == Data::Collection::Bibtex) {
+    QString preamble;
+    StringMap macros;
+    in >> preamble >> macros;
+    Data::BibtexCollection* c = static_cast<Data::BibtexCollection*>(coll.data());
+    c->setPreamble(preamble);
+    for(auto it = macros.constBegin(); it != macros.constEnd(); ++it) {
+      c->addMacro(it.key(), it.value());
+    }
+  }
+
+  QStringList strings;
+  qint32 entryCount;
+  in >> strings >> entryCount;
+  Data::EntryList entries;
+  if(entryCount > 0) {
+    entries.reserve(entryCount);
+  }
+  for(int i = 0; i < entryCount && in.status() == QDataStream::Ok; ++i) {
+    qint32 id, valueCount;
+    in >> id >> valueCount;
+    Data::EntryPtr entry(new Data::Entry(coll, id));
+    for(int j = 0; j < valueCount && in.status() == QDataStream::Ok; ++j) {
+      qint32 fieldIndex, stringIndex;
+      in >> fieldIndex >> stringIndex;
+      if(fieldIndex < 0 || fieldIndex >= collFields.count() ||
+         stringIndex < 0 || stringIndex >= strings.count()) {
+        myDebug() << "corrupt snapshot for" << url_.fileName();
+        return Data::CollPtr();
+      }
+      Data::FieldPtr field = collFields.at(fieldIndex);
+      if(field) {
+        entry->loadField(field, strings.at(stringIndex));
+      }
+    }
+    entries += entry;
+  }
+  coll->addEntries(entries);
+
+  qint32 filterCount;
+  in >> filterCount;
+  for(int i = 0; i < filterCount && in.status() == QDataStream::Ok; ++i) {
+    QString name;
+    qint32 op, ruleCount;
+    in >> name >> op >> ruleCount;
+    FilterPtr filter(new Filter(static_cast<Filter::FilterOp>(op)));
+    filter->setName(name);
+    for(int j = 0; j < ruleCount && in.status() == QDataStream::Ok; ++j) {
+      QString fieldName, pattern;
+      qint32 function;
+      in >> fieldName >> pattern >> function;
+      filter->append(new FilterRule(fieldName, pattern, static_cast<FilterRule::Function>(function)));
+    }
+    if(!filter->isEmpty()) {
+      coll->addFilter(filter);
+    }
+  }
+
+  qint32 borrowerCount;
+  in >> borrowerCount;
+  for(int i = 0; i < borrowerCount && in.status() == QDataStream::Ok; ++i) {
+    QString name, uid;
+    qint32 loanCount;
+    in >> name >> uid >> loanCount;
+    Data::BorrowerPtr borrower(new Data::Borrower(name, uid));
+    for(int j = 0; j < loanCount && in.status() == QDataStream::Ok; ++j) {
+      qint32 entryId;
+      QString loanUid, note;
+      QDate loanDate, dueDate;
+      bool inCalendar;
+      in >> entryId >> loanUid >> loanDate >> dueDate >> note >> inCalendar;
+      Data::EntryPtr entry = coll->entryById(entryId);
+      if(!entry) {
+        myWarning() << "no entry with id = " << entryId;
+        continue;
+      }
+      Data::LoanPtr loan(new Data::Loan(entry, loanDate, dueDate, note));
+      loan->setUID(loanUid);
+      loan->setInCalendar(inCalendar);
+      borrower->addLoan(loan);
+    }
+    if(!borrower->isEmpty()) {
+      coll->addBorrower(borrower);
+    }
+  }
+
+  qint32 imageCount;
+  in >> imageCount;
+  for(int i = 0; i < imageCount && in.status() == QDataStream::Ok; ++i) {
+    QString id;
+    QByteArray format;
+    qint32 width, height;
+    bool linkOnly;
+    in >> id >> format >> width >> height >> linkOnly;
+    ImageFactory::cacheImageInfo(Data::ImageInfo(id, format, width, height, linkOnly));
+  }
+
+  if(in.status() != QDataStream::Ok) {
+    myDebug() << "failed to read snapshot for" << url_.fileName();
+    return Data::CollPtr();
+  }
+  return coll;
+}
+
+bool TellicoSnapshot::write(const QUrl& url_, Tellico::Data::CollPtr coll_) {
+  if(!coll_ || url_.isEmpty() || !url_.isLocalFile()) {
+    return false;
+  }
+  const QFileInfo sourceInfo(url_.toLocalFile());
+  if(!sourceInfo.exists()) {
+    return false;
+  }
+  const QString fileName = snapshotFile(url_);
+  if(!QDir().mkpath(QFileInfo(fileName).absolutePath())) {
+    myDebug() << "unable to create snapshot directory for" << fileName;
+    return false;
+  }
+  QSaveFile file(fileName);
+  if(!file.open(QIODevice::WriteOnly)) {
+    myDebug() << "unable to write" << fileName;
+    return false;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_6_0);
+  writeHeader(out, sourceInfo);
+  out << qint32(coll_->type()) << coll_->title();
+
+  const Data::FieldList fields = coll_->fields();
+  out << qint32(fields.count());
+  foreach(Data::FieldPtr field, fields) {
+    out << field->name() << field->title() << field->category() << field->description()
+        << qint32(field->type()) << qint32(field->flags()) << qint32(field->formatType())
+        << field->allowed() << field->propertyList();
+  }
+
+  if(coll_->type() == Data::Collection::Bibtex) {
+    const Data::BibtexCollection* c = static_cast<const Data::BibtexCollection*>(coll_.data());
+    out << c->preamble() << c->macroList();
+  }
+
+  // every value is written once, and the entries refer to the values by position,
+  // with each entry as the id, the number of values, and then the field and value positions
+  QHash<QString, qint32> stringIndex;
+  QStringList strings;
+  QVector<qint32> entryValues;
+  QSet<QString> imageIds;
+  const Data::EntryList entries = coll_->entries();
+  foreach(Data::EntryPtr entry, entries) {
+    entryValues += entry->id();
+    const int countPos = entryValues.size();
+    entryValues += 0;
+    for(int i = 0; i < fields.count(); ++i) {
+      Data::FieldPtr field = fields.at(i);
+      // derived values are never saved
+      if(field->hasFlag(Data::Field::Derived)) {
+        continue;
+      }
+      const QString value = entry->field(field);
+      if(value.isEmpty()) {
+        continue;
+      }
+      auto it = stringIndex.constFind(value);
+      if(it == stringIndex.constEnd()) {
+        it = stringIndex.insert(value, strings.count());
+        strings += value;
+      }
+      entryValues += i;
+      entryValues += it.value();
+      ++entryValues[countPos];
+      if(field->type() == Data::Field::Image) {
+        imageIds.insert(value);
+      }
+    }
+  }
+  out << strings << qint32(entries.count());
+  for(const qint32 v : std::as_const(entryValues)) {
+    out << v;
+  }
+
+  const FilterList filters = coll_->filters();
+  out << qint32(filters.count());
+  foreach(FilterPtr filter, filters) {
+    out << filter->name() << qint32(filter->op()) << qint32(filter->count());
+    for(const FilterRule* rule : std::as_const(*filter)) {
+      out << rule->fieldName() << rule->pattern() << qint32(rule->function());
+    }
+  }
+
+  const Data::BorrowerList borrowers = coll_->borrowers();
+  out << qint32(borrowers.count());
+  foreach(Data::BorrowerPtr borrower, borrowers) {
+    out << borrower->name() << borrower->uid() << qint32(borrower->count());
+    foreach(Data::LoanPtr loan, borrower->loans()) {
+      out << qint32(loan->entry()->id()) << loan->uid() << loan->loanDate() << loan->dueDate()
+          << loan->note() << loan->inCalendar();
+    }
+  }
+
+  QList<Data::ImageInfo> imageInfos;
+  foreach(const QString& id, imageIds) {
+    if(ImageFactory::hasImageInfo(id)) {
+      imageInfos += ImageFactory::imageInfo(id);
+    }
+  }
+  out << qint32(imageInfos.count());
+  foreach(const Data::ImageInfo& info, imageInfos) {
+    // the image sizes are only written if they are already known
+    out << info.id << info.format << qint32(info.width(false)) << qint32(info.height(false)) << bool(info.linkOnly);
+  }
+
+  if(out.status() != QDataStream::Ok) {
+    myDebug() << "failed to write snapshot for" << url_.fileName();
+    file.cancelWriting();
+    return false;
+  }
+  if(!file.commit()) {
+    return false;
+  }
+  prune();
+  return true;
+}
+
+void TellicoSnapshot::remove(const QUrl& url_) {
+  if(url_.isEmpty() || !url_.isLocalFile()) {
+    return;
+  }
+  QFile::remove(snapshotFile(url_));
+}
+
+void TellicoSnapshot::prune() {
+  QDir dir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/snapshots"));
+  if(!dir.exists()) {
+    return;
+  }
+  // newest first
+  const QFileInfoList infos = dir.entryInfoList(QStringList() << QStringLiteral("*.snapshot"), QDir::Files, QDir::Time);
+  int count = 0;
+  for(const QFileInfo& info : infos) {
+    QFile file(info.absoluteFilePath());
+    bool keep = false;
+    if(count < TELLICO_SNAPSHOT_MAX_COUNT && file.open(QIODevice::ReadOnly)) {
+      QDataStream in(&file);
+      in.setVersion(QDataStream::Qt_6_0);
+      QString path;
+      qint64 size, modified;
+      // snapshots from other versions and for files which no longer exist are never read again
+      keep = readHeader(in, path, size, modified) && QFileInfo::exists(path);
+      file.close();
+    }
+    if(keep) {
+      ++count;
+    } else if(!file.remove()) {
+      myDebug() << "unable to remove" << info.fileName();
+    }
+  }
+}
@@ -0,0 +1,78 @@
+/***************************************************************************
+    Copyright (C) 2026 Robby Stephenson <robby@periapsis.org>
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TELLICO_IMPORT_TELLICOSNAPSHOT_H
+#define TELLICO_IMPORT_TELLICOSNAPSHOT_H
+
+#include "../datavectors.h"
+
+#include <QUrl>
+
+namespace Tellico {
+  namespace Import {
+
+/**
+ * A binary copy of a collection read from a Tellico file, kept in the user's cache directory
+ * so that the next time the same file is opened, the XML does not have to be parsed again.
+ *
+ * The snapshot holds the fields, the entries, the filters, the borrowers, and the image
+ * information. The entry values are written once in a string table so that repeated values
+ * are shared when the snapshot is read. A snapshot is only used when the size and the
+ * modification time of the file match the ones it was written for, and when it was written
+ * by the same version of Tellico.
+ *
+ * @author Robby Stephenson
+ */
+class TellicoSnapshot {
+public:
+  /**
+   * Reads the snapshot for a local file. The image information is added to the image cache.
+   *
+   * @param url The local Tellico file
+   * @return The collection, or a null pointer if there is no snapshot or it is out of date
+   */
+  static Data::CollPtr read(const QUrl& url);
+  /**
+   * Writes the snapshot for a collection which was just read from a local file.
+   *
+   * @param url The local Tellico file
+   * @param coll The collection read from the file
+   * @return true if the snapshot was written
+   */
+  static bool write(const QUrl& url, Data::CollPtr coll);
+  static void remove(const QUrl& url);
+  /**
+   * Returns the path of the snapshot file for a local file.
+   */
+  static QString snapshotFile(const QUrl& url);
+  /**
+   * Removes the snapshots which can not be read any more, as well as all but the most
+   * recently written ones. It gets called every time a snapshot is written.
+   */
+  static void prune();
+};
+
+  } // end namespace
+} // end namespace
+#endif
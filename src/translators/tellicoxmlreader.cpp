@@ -30,9 +30,18 @@
 
 #include <KLocalizedString>
 
+// for xmlStringTextNoenc
+#include <libxml/parserInternals.h>
+
 using Tellico::Import::TellicoXmlReader;
 
-TellicoXmlReader::TellicoXmlReader(const QUrl& baseUrl_) : m_data(new SAX::StateData) {
+namespace {
+  inline QString fromXmlChar(const xmlChar* str_) {
+    return QString::fromUtf8(reinterpret_cast<const char*>(str_));
+  }
+}
+
+TellicoXmlReader::TellicoXmlReader(const QUrl& baseUrl_) : m_data(new SAX::StateData), m_hasUnescapedText(false) {
   m_data->baseUrl = baseUrl_;
   m_handlers.push(new SAX::RootHandler(m_data));
 }
@@ -77,7 +86,76 @@ bool TellicoXmlReader::readNext(const QByteArray& data_) {
   return !m_xml.hasError() || m_xml.error() == QXmlStreamReader::PrematureEndOfDocumentError;
 }
 
+bool TellicoXmlReader::readDocument(xmlDocPtr doc_) {
+  Q_ASSERT(!m_handlers.isEmpty());
+  if(m_handlers.isEmpty() || !doc_) {
+    return false;
+  }
+  for(xmlNodePtr child = doc_->children; child; child = child->next) {
+    // disable-output-escaping in the stylesheet means the text is really markup
+    if(child->type == XML_TEXT_NODE && child->name == xmlStringTextNoenc) {
+      m_hasUnescapedText = true;
+      return false;
+    }
+  }
+  xmlNodePtr root = xmlDocGetRootElement(doc_);
+  if(!root) {
+    m_documentError = i18n("The document is empty.");
+    return false;
+  }
+  return readElement(root);
+}
+
+bool TellicoXmlReader::readElement(xmlNodePtr node_) {
+  const QString nsUri = node_->ns ? fromXmlChar(node_->ns->href) : QString();
+  const QString localName = fromXmlChar(node_->name);
+  QXmlStreamAttributes attributes;
+  for(xmlAttrPtr attr = node_->properties; attr; attr = attr->next) {
+    xmlChar* value = xmlNodeListGetString(node_->doc, attr->children, 1);
+    attributes.append(attr->ns ? fromXmlChar(attr->ns->href) : QString(),
+                      fromXmlChar(attr->name),
+                      fromXmlChar(value));
+    xmlFree(value);
+  }
+  if(!startElement(nsUri, localName, attributes)) {
+    m_documentError = m_data->error;
+    return false;
+  }
+
+  for(xmlNodePtr child = node_->children; child; child = child->next) {
+    switch(child->type) {
+      case XML_ELEMENT_NODE:
+        if(!readElement(child)) {
+          return false;
+        }
+        break;
+      case XML_TEXT_NODE:
+        if(child->name == xmlStringTextNoenc) {
+          m_hasUnescapedText = true;
+          return false;
+        }
+        m_data->text.append(fromXmlChar(child->content));
+        break;
+      case XML_CDATA_SECTION_NODE:
+        m_data->text.append(fromXmlChar(child->content));
+        break;
+      default:
+        // not handling anything else
+        break;
+    }
+  }
+
+  if(!endElement(nsUri, localName)) {
+    m_documentError = m_data->error;
+    return false;
+  }
+  return true;
+}
+
 QString TellicoXmlReader::errorString() const {
+  if(!m_documentError.isEmpty()) {
+    return m_documentError;
+  }
   // for custom errors, include the line and column number
   return m_xml.error() == QXmlStreamReader::CustomError ?
     QString::fromLatin1("Fatal parsing error in line %1, column %2. %3")
@@ -99,6 +177,10 @@ bool TellicoXmlReader::hasImages() const {
   return m_data->hasImages;
 }
 
+bool TellicoXmlReader::hasAddedImageFiles() const {
+  return m_data->addedImageFiles;
+}
+
 void TellicoXmlReader::setLoadImages(bool loadImages_) {
   m_data->loadImages = loadImages_;
 }
@@ -108,23 +190,32 @@ void TellicoXmlReader::setShowImageLoadErrors(bool showImageErrors_) {
 }
 
 void TellicoXmlReader::handleStart() {
-  SAX::StateHandler* handler = m_handlers.top()->nextHandler(m_xml.namespaceUri(), m_xml.name());
-  Q_ASSERT(handler);
-  m_handlers.push(handler);
-  if(!handler->start(m_xml.namespaceUri(), m_xml.name(), m_xml.attributes())) {
+  if(!startElement(m_xml.namespaceUri(), m_xml.name(), m_xml.attributes())) {
     m_xml.raiseError(m_data->error);
   }
 }
 
 void TellicoXmlReader::handleEnd() {
-  m_data->text = m_data->text.trimmed();
-  SAX::StateHandler* handler = m_handlers.pop();
-  if(!handler->end(m_xml.namespaceUri(), m_xml.name())) {
+  if(!endElement(m_xml.namespaceUri(), m_xml.name())) {
     m_xml.raiseError(m_data->error);
   }
+}
+
+bool TellicoXmlReader::startElement(QStringView nsUri_, QStringView localName_, const QXmlStreamAttributes& attributes_) {
+  SAX::StateHandler* handler = m_handlers.top()->nextHandler(nsUri_, localName_);
+  Q_ASSERT(handler);
+  m_handlers.push(handler);
+  return handler->start(nsUri_, localName_, attributes_);
+}
+
+bool TellicoXmlReader::endElement(QStringView nsUri_, QStringView localName_) {
+  m_data->text = m_data->text.trimmed();
+  SAX::StateHandler* handler = m_handlers.pop();
+  const bool success = handler->end(nsUri_, localName_);
   // need to reset character data, too
   m_data->text.clear();
   delete handler;
+  return success;
 }
 
 void TellicoXmlReader::handleCharacters() {
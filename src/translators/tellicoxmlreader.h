@@ -30,6 +30,9 @@
 #include <QXmlStreamReader>
 #include <QStack>
 
+// for xmlDocPtr
+#include <libxml/tree.h>
+
 namespace Tellico {
   namespace Import {
 
@@ -39,11 +42,21 @@ public:
   ~TellicoXmlReader();
 
   bool readNext(const QByteArray& data);
+  /**
+   * Reads a document tree, such as the result of an XSLT transformation, without
+   * having to serialize it to text and parse it again.
+   *
+   * @return false if there was an error or if the tree contains text which was not
+   * escaped and needs to be parsed as text
+   */
+  bool readDocument(xmlDocPtr doc);
+  bool hasUnescapedText() const { return m_hasUnescapedText; }
   QString errorString() const;
   bool isNotWellFormed() const;
 
   Data::CollPtr collection() const;
   bool hasImages() const;
+  bool hasAddedImageFiles() const;
 
   void setLoadImages(bool loadImages);
   void setShowImageLoadErrors(bool showImageErrors);
@@ -52,10 +65,15 @@ private:
   void handleStart();
   void handleEnd();
   void handleCharacters();
+  bool startElement(QStringView nsUri, QStringView localName, const QXmlStreamAttributes& attributes);
+  bool endElement(QStringView nsUri, QStringView localName);
+  bool readElement(xmlNodePtr node);
 
   QXmlStreamReader m_xml;
   QStack<SAX::StateHandler*> m_handlers;
   SAX::StateData* m_data;
+  QString m_documentError;
+  bool m_hasUnescapedText;
 };
 
   }
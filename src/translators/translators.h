@@ -61,7 +61,8 @@ namespace Tellico {
     enum Action {
       Replace,
       Append,
-      Merge
+      Merge,
+      Update
     };
 
     enum Target {
@@ -59,6 +59,29 @@ QString realFieldName(int syntaxVersion, QStringView localName) {
     localName.toString();
 }
 
+// the element name is copied into a reusable string so there's no allocation for each value
+inline
+Tellico::Data::FieldPtr elementField(Tellico::Import::SAX::StateData* d, QStringView localName) {
+  d->elementName.resize(0);
+  d->elementName.append(localName);
+  return d->elementFields.value(d->elementName);
+}
+
+void updateElementFields(Tellico::Import::SAX::StateData* d) {
+  d->elementFields.clear();
+  foreach(Tellico::Data::FieldPtr field, d->coll->fields()) {
+    d->elementFields.insert(field->name(), field);
+  }
+  // the keyword field used to be written as "keywords"
+  if(d->syntaxVersion < 2) {
+    d->elementFields.remove(QStringLiteral("keywords"));
+    Tellico::Data::FieldPtr field = d->coll->fieldByName(QStringLiteral("keyword"));
+    if(field) {
+      d->elementFields.insert(QStringLiteral("keywords"), field);
+    }
+  }
+}
+
 }
 
 using Tellico::Import::SAX::StateHandler;
@@ -228,6 +251,7 @@ bool CollectionHandler::end(QStringView, QStringView) {
                   ++imageWarnings;
                 } else {
                   value = result;
+                  d->addedImageFiles = true;
                 }
               }
             }
@@ -239,13 +263,14 @@ bool CollectionHandler::end(QStringView, QStringView) {
               ++imageWarnings;
             } else {
               value = result;
+              d->addedImageFiles = true;
             }
           }
         } else {
           value = Data::Image::idClean(value);
         }
         // reset the image id to be whatever was loaded
-        entry->setField(field->name(), value, false /* no modified date update */);
+        entry->loadField(field, value);
       }
     }
   }
@@ -301,6 +326,7 @@ bool FieldsHandler::end(QStringView, QStringView) {
     d->coll = Data::BibtexCollection::convertBookCollection(d->coll);
   }
 
+  updateElementFields(d);
   return true;
 }
 
@@ -493,8 +519,9 @@ bool BibtexMacroHandler::end(QStringView, QStringView) {
 }
 
 StateHandler* EntryHandler::nextHandlerImpl(QStringView, QStringView localName_) {
-  if(d->coll->hasField(realFieldName(d->syntaxVersion, localName_))) {
-    return new FieldValueHandler(d);
+  Data::FieldPtr field = elementField(d, localName_);
+  if(field) {
+    return new FieldValueHandler(d, field);
   }
   return new FieldValueContainerHandler(d);
 }
@@ -526,16 +553,20 @@ bool EntryHandler::start(QStringView, QStringView, const QXmlStreamAttributes& a
 bool EntryHandler::end(QStringView, QStringView) {
   Data::EntryPtr entry = d->entries.back();
   Q_ASSERT(entry);
-  if(!d->modifiedDate.isEmpty() && d->coll->hasField(QStringLiteral("mdate"))) {
-    entry->setField(QStringLiteral("mdate"), d->modifiedDate);
+  if(!d->modifiedDate.isEmpty()) {
+    Data::FieldPtr field = d->coll->fieldByName(QStringLiteral("mdate"));
+    if(field) {
+      entry->loadField(field, d->modifiedDate);
+    }
     d->modifiedDate.clear();
   }
   return true;
 }
 
 StateHandler* FieldValueContainerHandler::nextHandlerImpl(QStringView, QStringView localName_) {
-  if(d->coll->hasField(realFieldName(d->syntaxVersion, localName_))) {
-    return new FieldValueHandler(d);
+  Data::FieldPtr field = elementField(d, localName_);
+  if(field) {
+    return new FieldValueHandler(d, field);
   }
   return new FieldValueContainerHandler(d);
 }
@@ -553,8 +584,7 @@ bool FieldValueContainerHandler::end(QStringView, QStringView) {
     // don't allow table value to end with empty row
     while(fieldValue.endsWith(FieldFormat::rowDelimiterString())) {
       fieldValue.chop(FieldFormat::rowDelimiterString().length());
-      // no need to update the modified date when setting the entry's field value
-      entry->setField(f->name(), fieldValue, false /* no modified date update */);
+      entry->loadField(f, fieldValue);
     }
   }
 
@@ -573,7 +603,7 @@ StateHandler* FieldValueHandler::nextHandlerImpl(QStringView, QStringView localN
 }
 
 bool FieldValueHandler::start(QStringView, QStringView localName_, const QXmlStreamAttributes& atts_) {
-  d->currentField = d->coll->fieldByName(realFieldName(d->syntaxVersion, localName_));
+  d->currentField = m_field;
   Q_ASSERT(d->currentField);
   m_i18n = atts_.value(QLatin1String("i18n")) == QLatin1String("true");
   m_validateISBN = (localName_ == QLatin1String("isbn")) &&
@@ -662,8 +692,7 @@ bool FieldValueHandler::end(QStringView, QStringView localName_) {
   if(fieldName == QLatin1String("mdate")) {
     d->modifiedDate = fieldValue;
   } else {
-    // no need to update the modified date when setting the entry's field value
-    entry->setField(fieldName, fieldValue, false /* no modified date update */);
+    entry->loadField(f, fieldValue);
   }
   return true;
 }
@@ -27,6 +27,7 @@
 
 #include <QXmlStreamAttributes>
 #include <QUrl>
+#include <QHash>
 
 #include "../datavectors.h"
 
@@ -36,7 +37,8 @@ namespace Tellico {
 
 class StateData {
 public:
-  StateData() : syntaxVersion(0), collType(0), defaultFields(false), loadImages(false), hasImages(false), showImageLoadErrors(true) {}
+  StateData() : syntaxVersion(0), collType(0), defaultFields(false), loadImages(false), hasImages(false), showImageLoadErrors(true)
+    , addedImageFiles(false) {}
   QString text;
   QString error;
   QString ns; // namespace
@@ -48,6 +50,9 @@ public:
   Data::CollPtr coll;
   Data::FieldList fields;
   Data::FieldPtr currentField;
+  // the collection fields by element name, filled in once the fields are read
+  QHash<QString, Data::FieldPtr> elementFields;
+  QString elementName;
   Data::EntryList entries;
   QString modifiedDate;
   FilterPtr filter;
@@ -56,6 +61,8 @@ public:
   bool loadImages;
   bool hasImages;
   bool showImageLoadErrors;
+  // true if any image values were file names or data urls, rather than image ids
+  bool addedImageFiles;
   QUrl baseUrl;
 };
 
@@ -216,8 +223,8 @@ private:
 
 class FieldValueHandler : public StateHandler {
 public:
-  FieldValueHandler(StateData* data) : StateHandler(data)
-    , m_i18n(false), m_validateISBN(false) {}
+  FieldValueHandler(StateData* data, Data::FieldPtr field) : StateHandler(data)
+    , m_field(field), m_i18n(false), m_validateISBN(false) {}
   virtual ~FieldValueHandler() {}
 
   virtual bool start(QStringView, QStringView, const QXmlStreamAttributes&) override;
@@ -225,6 +232,7 @@ public:
 
 private:
   virtual StateHandler* nextHandlerImpl(QStringView, QStringView) override;
+  Data::FieldPtr m_field;
   bool m_i18n;
   bool m_validateISBN;
 };
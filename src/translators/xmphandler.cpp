@@ -29,11 +29,19 @@
 
 #include <QFile>
 #include <QTextStream>
+#include <QMutex>
 
 #ifdef HAVE_EXEMPI
 #include <exempi/xmp.h>
 #endif
 
+#ifdef HAVE_EXEMPI
+namespace {
+  // the toolkit is initialized by the first thread to extract anything
+  QMutex s_initMutex;
+}
+#endif
+
 using Tellico::XMPHandler;
 
 bool XMPHandler::s_needInit = true;
@@ -66,9 +74,12 @@ XMPHandler::~XMPHandler() {
 QString XMPHandler::extractXMP(const QString& file) {
   QString result;
 #ifdef HAVE_EXEMPI
-  if(s_needInit) {
-    xmp_init();
-    s_needInit = false;
+  {
+    QMutexLocker lock(&s_initMutex);
+    if(s_needInit) {
+      xmp_init();
+      s_needInit = false;
+    }
   }
   XmpFilePtr xmpfile = xmp_files_open_new(QFile::encodeName(file).constData(), XMP_OPEN_READ);
   if(!xmpfile) {
@@ -29,6 +29,10 @@ class QString;
 
 namespace Tellico {
 
+/**
+ * A single handler can extract XMP from several files at the same time, in different threads.
+ * The handler has to be created and destroyed in the main thread, though.
+ */
 class XMPHandler {
 public:
   XMPHandler();
@@ -27,9 +27,14 @@
 #include "../utils/string_utils.h"
 
 #include <QUrl>
-
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QDomDocument>
 #include <QVector>
+#include <QMutex>
+#include <QPair>
+#include <QCryptographicHash>
 
 extern "C" {
 #include <libxslt/xslt.h>
@@ -47,6 +52,8 @@ static const int xml_options = XML_PARSE_NONET | XML_PARSE_NOCDATA | XML_PARSE_N
 static const int xml_options = XML_PARSE_NONET | XML_PARSE_NOCDATA;
 #endif
 static const int xslt_options = xml_options;
+// the number of compiled stylesheets kept after the last handler using them is deleted
+static const int xslt_cache_size = 20;
 
 /* some functions to pass to the XSLT libs */
 static int writeToQString(void* context, const char* buffer, int len) {
@@ -61,8 +68,105 @@ static int closeQString(void* context) {
   return 0;
 }
 
+static qint64 fileTime(const QString& fileName) {
+  return QFileInfo(fileName).lastModified().toMSecsSinceEpoch();
+}
+
+// the imported and included files, along with their modification times
+static void addDependencies(xsltStylesheetPtr style, QList<QPair<QString, qint64> >& deps) {
+  // the included documents are all kept in the document list
+  for(xsltDocumentPtr inc = style->docList; inc; inc = inc->next) {
+    if(inc->doc && inc->doc->URL) {
+      const QUrl url(QString::fromUtf8(reinterpret_cast<const char*>(inc->doc->URL)));
+      const QString fileName = url.isLocalFile() ? url.toLocalFile() : url.toString();
+      deps += qMakePair(fileName, fileTime(fileName));
+    }
+  }
+  for(xsltStylesheetPtr imp = style->imports; imp; imp = imp->next) {
+    if(imp->doc && imp->doc->URL) {
+      const QUrl url(QString::fromUtf8(reinterpret_cast<const char*>(imp->doc->URL)));
+      const QString fileName = url.isLocalFile() ? url.toLocalFile() : url.toString();
+      deps += qMakePair(fileName, fileTime(fileName));
+    }
+    addDependencies(imp, deps);
+  }
+}
+
 using Tellico::XSLTHandler;
 
+/**
+ * The compiled stylesheets, with the least recently used ones first. As long as the cache
+ * is not empty, it keeps the XSLT library initialized.
+ *
+ * The key includes the modification time of the top-level file, and the times of any imported
+ * or included files are checked each time a stylesheet is found in the cache.
+ */
+class XSLTHandler::StylesheetCache {
+public:
+  ~StylesheetCache() { clear(); }
+
+  static StylesheetCache& self() {
+    static StylesheetCache cache;
+    return cache;
+  }
+
+  StylesheetPtr find(const QByteArray& key) {
+    QMutexLocker lock(&m_mutex);
+    auto it = m_stylesheets.find(key);
+    if(it == m_stylesheets.end()) {
+      return StylesheetPtr();
+    }
+    m_keys.removeOne(key);
+    for(const auto& dep : std::as_const(it.value().dependencies)) {
+      if(fileTime(dep.first) != dep.second) {
+        m_stylesheets.erase(it);
+        return StylesheetPtr();
+      }
+    }
+    m_keys.append(key);
+    return it.value().stylesheet;
+  }
+
+  void insert(const QByteArray& key, StylesheetPtr stylesheet) {
+    CacheEntry entry;
+    entry.stylesheet = stylesheet;
+    addDependencies(stylesheet.data(), entry.dependencies);
+
+    QMutexLocker lock(&m_mutex);
+    if(m_stylesheets.isEmpty()) {
+      XSLTHandler::initLibrary();
+    }
+    if(m_stylesheets.contains(key)) {
+      m_keys.removeOne(key);
+    }
+    m_stylesheets.insert(key, entry);
+    m_keys.append(key);
+    while(m_keys.count() > xslt_cache_size) {
+      m_stylesheets.remove(m_keys.takeFirst());
+    }
+  }
+
+  void clear() {
+    QMutexLocker lock(&m_mutex);
+    if(m_stylesheets.isEmpty()) {
+      return;
+    }
+    m_stylesheets.clear();
+    m_keys.clear();
+    XSLTHandler::cleanup();
+  }
+
+private:
+  struct CacheEntry {
+    StylesheetPtr stylesheet;
+    QList<QPair<QString, qint64> > dependencies;
+  };
+
+  QMutex m_mutex;
+  QHash<QByteArray, CacheEntry> m_stylesheets;
+  QList<QByteArray> m_keys;
+};
+
 XSLTHandler::XMLOutputBuffer::XMLOutputBuffer() {
   m_buf = xmlOutputBufferCreateIO((xmlOutputWriteCallback)writeToQString,
                                   (xmlOutputCloseCallback)closeQString,
@@ -83,12 +187,10 @@ XSLTHandler::XMLOutputBuffer::~XMLOutputBuffer() {
 
 int XSLTHandler::s_initCount = 0;
 
-XSLTHandler::XSLTHandler(const QByteArray& xsltFile_) :
-    m_stylesheet(nullptr) {
+XSLTHandler::XSLTHandler(const QByteArray& xsltFile_) {
   init();
   if(!xsltFile_.isEmpty()) {
-    xmlDocPtr xsltDoc = xmlReadFile(xsltFile_.constData(), nullptr, xslt_options);
-    m_stylesheet = xsltParseStylesheetDoc(xsltDoc);
+    m_stylesheet = readStylesheet(xsltFile_);
     if(!m_stylesheet) {
       myDebug() << "null stylesheet pointer for " << xsltFile_;
     }
@@ -97,12 +199,10 @@ XSLTHandler::XSLTHandler(const QByteArray& xsltFile_) :
   }
 }
 
-XSLTHandler::XSLTHandler(const QUrl& xsltURL_) :
-    m_stylesheet(nullptr) {
+XSLTHandler::XSLTHandler(const QUrl& xsltURL_) {
   init();
   if(xsltURL_.isValid() && xsltURL_.isLocalFile()) {
-    xmlDocPtr xsltDoc = xmlReadFile(xsltURL_.toLocalFile().toUtf8().constData(), nullptr, xslt_options);
-    m_stylesheet = xsltParseStylesheetDoc(xsltDoc);
+    m_stylesheet = readStylesheet(xsltURL_.toLocalFile().toUtf8());
     if(!m_stylesheet) {
       myDebug() << "null stylesheet pointer for " << xsltURL_.path();
     }
@@ -111,8 +211,7 @@ XSLTHandler::XSLTHandler(const QUrl& xsltURL_) :
   }
 }
 
-XSLTHandler::XSLTHandler(const QDomDocument& xsltDoc_, const QByteArray& xsltFile_, bool translate_) :
-    m_stylesheet(nullptr) {
+XSLTHandler::XSLTHandler(const QDomDocument& xsltDoc_, const QByteArray& xsltFile_, bool translate_) {
   init();
   if(!xsltDoc_.isNull() && !xsltFile_.isEmpty()) {
     setXSLTDoc(xsltDoc_, xsltFile_, translate_);
@@ -120,10 +219,33 @@ XSLTHandler::XSLTHandler(const QDomDocument& xsltDoc_, const QByteArray& xsltFil
 }
 
 XSLTHandler::~XSLTHandler() {
-  if(m_stylesheet) {
-    xsltFreeStylesheet(m_stylesheet);
+  // the stylesheet is only freed if the cache no longer holds it
+  m_stylesheet.reset();
+  cleanup();
+}
+
+void XSLTHandler::init() {
+  initLibrary();
+  m_params.clear();
+}
+
+// every handler and the non-empty cache hold a reference, all counted under the same lock
+QMutex& XSLTHandler::initMutex() {
+  static QMutex mutex;
+  return mutex;
+}
+
+void XSLTHandler::initLibrary() {
+  QMutexLocker lock(&initMutex());
+  if(s_initCount == 0) {
+    // register all exslt extensions
+    exsltRegisterAll();
   }
+  ++s_initCount;
+}
 
+void XSLTHandler::cleanup() {
+  QMutexLocker lock(&initMutex());
   --s_initCount;
   if(s_initCount == 0) {
     xsltUnregisterExtModule(EXSLT_STRINGS_NAMESPACE);
@@ -133,18 +255,26 @@ XSLTHandler::~XSLTHandler() {
   }
 }
 
-void XSLTHandler::init() {
-  if(s_initCount == 0) {
-    // register all exslt extensions
-    exsltRegisterAll();
+XSLTHandler::StylesheetPtr XSLTHandler::readStylesheet(const QByteArray& xsltFile_) {
+  const QFileInfo info(QFile::decodeName(xsltFile_));
+  const QByteArray key = "file:" + QFile::encodeName(info.absoluteFilePath()) + '\n'
+                       + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+  StylesheetPtr stylesheet = StylesheetCache::self().find(key);
+  if(stylesheet) {
+    return stylesheet;
   }
-  ++s_initCount;
 
-  m_params.clear();
+  xmlDocPtr xsltDoc = xmlReadFile(xsltFile_.constData(), nullptr, xslt_options);
+  xsltStylesheetPtr ptr = xsltParseStylesheetDoc(xsltDoc);
+  if(ptr) {
+    stylesheet = StylesheetPtr(ptr, xsltFreeStylesheet);
+    StylesheetCache::self().insert(key, stylesheet);
+  }
+  return stylesheet;
 }
 
 bool XSLTHandler::isValid() const {
-  return (m_stylesheet != nullptr);
+  return !m_stylesheet.isNull();
 }
 
 void XSLTHandler::setXSLTDoc(const QDomDocument& dom_, const QByteArray& xsltFile_, bool translate_) {
@@ -173,18 +303,25 @@ void XSLTHandler::setXSLTDoc(const QDomDocument& dom_, const QByteArray& xsltFil
     s = dom_.toString();
   }
 
-  xmlDocPtr xsltDoc;
-  if(utf8) {
-    xsltDoc = xmlReadDoc(reinterpret_cast<xmlChar*>(s.toUtf8().data()), xsltFile_.data(), nullptr, xslt_options);
-  } else {
-    xsltDoc = xmlReadDoc(reinterpret_cast<xmlChar*>(s.toLocal8Bit().data()), xsltFile_.data(), nullptr, xslt_options);
-  }
+  QByteArray text = utf8 ? s.toUtf8() : s.toLocal8Bit();
 
+  // the text already includes any translation, but the imported stylesheets are found relative to the file
+  const QFileInfo info(QFile::decodeName(xsltFile_));
+  const QByteArray key = "dom:" + QFile::encodeName(info.absoluteFilePath()) + '\n'
+                       + QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + '\n'
+                       + (translate_ ? "i18n:" : "")
+                       + QCryptographicHash::hash(text, QCryptographicHash::Sha1).toHex();
+  m_stylesheet = StylesheetCache::self().find(key);
   if(m_stylesheet) {
-    xsltFreeStylesheet(m_stylesheet);
+    return;
   }
-  m_stylesheet = xsltParseStylesheetDoc(xsltDoc);
-  if(!m_stylesheet) {
+
+  xmlDocPtr xsltDoc = xmlReadDoc(reinterpret_cast<xmlChar*>(text.data()), xsltFile_.data(), nullptr, xslt_options);
+  xsltStylesheetPtr ptr = xsltParseStylesheetDoc(xsltDoc);
+  if(ptr) {
+    m_stylesheet = StylesheetPtr(ptr, xsltFreeStylesheet);
+    StylesheetCache::self().insert(key, m_stylesheet);
+  } else {
     myDebug() << "null stylesheet pointer for " << xsltFile_;
   }
 //  xmlFreeDoc(xsltDoc); // this causes a crash for some reason
@@ -232,10 +369,37 @@ QString XSLTHandler::applyStylesheet(const QString& text_) {
   return process(docIn);
 }
 
+xmlDocPtr XSLTHandler::transform(const QString& text_) {
+  if(!m_stylesheet) {
+    myDebug() << "null stylesheet pointer!";
+    return nullptr;
+  }
+  if(text_.isEmpty()) {
+    myDebug() << "XSLTHandler::transform() - empty input";
+    return nullptr;
+  }
+
+  xmlDocPtr docIn;
+  docIn = xmlReadDoc(reinterpret_cast<xmlChar*>(text_.toUtf8().data()), nullptr, nullptr, xml_options);
+
+  return transformDoc(docIn);
+}
+
 QString XSLTHandler::process(xmlDocPtr docIn) {
+  xmlDocPtr docOut = transformDoc(docIn);
+  if(!docOut) {
+    return QString();
+  }
+
+  const QString result = toString(docOut);
+  xmlFreeDoc(docOut);
+  return result;
+}
+
+xmlDocPtr XSLTHandler::transformDoc(xmlDocPtr docIn) {
   if(!docIn) {
     myDebug() << "XSLTHandler::applyStylesheet() - error parsing input string!";
-    return QString();
+    return nullptr;
   }
 
   QVector<const char*> params(2*m_params.count() + 1);
@@ -250,30 +414,29 @@ QString XSLTHandler::process(xmlDocPtr docIn) {
   }
   // returns NULL on error
   xmlDocPtr docOut;
-  docOut = xsltApplyStylesheet(m_stylesheet, docIn, params.data());
+  docOut = xsltApplyStylesheet(m_stylesheet.data(), docIn, params.data());
   for(int i = 0; i < 2*m_params.count(); ++i) {
     delete[] params[i];
   }
 
+  // the input tree isn't needed anymore, so free it before the output is used
   xmlFreeDoc(docIn);
   docIn = nullptr;
 
   if(!docOut) {
     myDebug() << "error applying stylesheet!";
-    return QString();
   }
+  return docOut;
+}
 
+QString XSLTHandler::toString(xmlDocPtr docOut) {
   XMLOutputBuffer output;
-  if(output.isValid()) {
-    int num_bytes = xsltSaveResultTo(output.buffer(), docOut, m_stylesheet);
+  if(docOut && output.isValid()) {
+    int num_bytes = xsltSaveResultTo(output.buffer(), docOut, m_stylesheet.data());
     if(num_bytes == -1) {
       myDebug() << "error saving output buffer!";
     }
   }
-
-  xmlFreeDoc(docOut);
-  docOut = nullptr;
-
   return output.result();
 }
 
@@ -289,3 +452,8 @@ QDomDocument& XSLTHandler::setLocaleEncoding(QDomDocument& dom_) {
   }
   return dom_;
 }
+
+//static
+void XSLTHandler::clearCache() {
+  StylesheetCache::self().clear();
+}
@@ -28,6 +28,7 @@
 #include <QByteArray>
 #include <QHash>
 #include <QString>
+#include <QSharedPointer>
 
 // for xmlDocPtr
 #include <libxml/tree.h>
@@ -39,6 +40,7 @@ extern "C" {
 
 class QUrl;
 class QDomDocument;
+class QMutex;
 
 namespace Tellico {
 
@@ -46,6 +48,10 @@ namespace Tellico {
  * The XSLTHandler contains all the code which uses XSLT processing to generate HTML or to
  * translate to other formats.
  *
+ * Compiled stylesheets are kept in a cache shared by the whole process, so creating a handler
+ * for a stylesheet which was already used is cheap. The handler only holds its own parameters.
+ * A stylesheet read from a file is compiled again when the modification time of the file changes.
+ *
  * @author Robby Stephenson
  */
 class XSLTHandler {
@@ -106,14 +112,39 @@ public:
    * @return The transformed text
    */
   QString applyStylesheet(const QString& text);
+  /**
+   * Processes text through the XSLT transformation, without serializing the result.
+   * The caller takes ownership of the result tree and must free it with xmlFreeDoc().
+   *
+   * @param text The text to be transformed
+   * @return The result tree, or null if there was an error
+   */
+  xmlDocPtr transform(const QString& text);
+  /**
+   * Serializes a result tree according to the output settings of the stylesheet.
+   */
+  QString toString(xmlDocPtr docOut);
 
   static QDomDocument& setLocaleEncoding(QDomDocument& dom);
+  /**
+   * Removes every compiled stylesheet from the cache. The stylesheets still in use by
+   * a handler are freed when the handler is deleted.
+   */
+  static void clearCache();
 
 private:
+  class StylesheetCache;
+  typedef QSharedPointer<xsltStylesheet> StylesheetPtr;
+
   void init();
+  static QMutex& initMutex();
+  static void initLibrary();
+  static void cleanup();
+  static StylesheetPtr readStylesheet(const QByteArray& xsltFile);
   QString process(xmlDocPtr docIn);
+  xmlDocPtr transformDoc(xmlDocPtr docIn);
 
-  xsltStylesheetPtr m_stylesheet;
+  StylesheetPtr m_stylesheet;
 
   QHash<QByteArray, QByteArray> m_params;
 
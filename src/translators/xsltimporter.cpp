@@ -25,6 +25,7 @@
 #include "xsltimporter.h"
 #include "xslthandler.h"
 #include "tellicoimporter.h"
+#include "tellicoxmlreader.h"
 #include "../core/filehandler.h"
 #include "../collection.h"
 #include "../tellico_debug.h"
@@ -95,14 +96,32 @@ Tellico::Data::CollPtr XSLTImporter::collection() {
   }
   beginXSLTHandler(&handler);
 //  myDebug() << text();
-  const QString str = handler.applyStylesheet(text());
-//  myDebug() << str;
-
-  Import::TellicoImporter imp(str);
-  imp.setBaseUrl(url()); // ignore case of multiple urls for now
-  imp.setOptions(options());
-  m_coll = imp.collection();
-  setStatusMessage(imp.statusMessage());
+  // the result tree is read directly rather than being written out as text and parsed again
+  xmlDocPtr doc = handler.transform(text());
+  if(!doc) {
+    setStatusMessage(i18n("Tellico encountered an error in XSLT processing."));
+    return Data::CollPtr();
+  }
+
+  TellicoXmlReader reader(url()); // ignore case of multiple urls for now
+  reader.setLoadImages(true);
+  reader.setShowImageLoadErrors(options() & ImportShowImageErrors);
+  if(reader.readDocument(doc)) {
+    m_coll = reader.collection();
+  } else if(reader.hasUnescapedText()) {
+    // the stylesheet wrote some of the output as unescaped markup, so it has to be parsed as text
+    const QString str = handler.toString(doc);
+//    myDebug() << str;
+    Import::TellicoImporter imp(str);
+    imp.setBaseUrl(url());
+    imp.setOptions(options());
+    m_coll = imp.collection();
+    setStatusMessage(imp.statusMessage());
+  } else {
+    myDebug() << reader.errorString();
+    setStatusMessage(reader.errorString());
+  }
+  xmlFreeDoc(doc);
   return m_coll;
 }
 
@@ -31,6 +31,7 @@
 #include "../tellico_debug.h"
 
 #include <QUrl>
+#include <QMutex>
 
 #include <QDomDocument>
 
@@ -40,6 +41,8 @@
 using Tellico::BibtexHandler;
 
 BibtexHandler::StringListHash BibtexHandler::s_utf8LatexMap;
+QString BibtexHandler::s_latexStartChars;
+QAtomicInt BibtexHandler::s_mapsLoaded;
 BibtexHandler::QuoteStyle BibtexHandler::s_quoteStyle = BibtexHandler::BRACES;
 const QRegularExpression BibtexHandler::s_badKeyChars(QLatin1String("[^0-9a-zA-Z-]"));
 
@@ -123,6 +126,15 @@ QString BibtexHandler::bibtexKey(const QString& author_, const QString& title_,
 }
 
 void BibtexHandler::loadTranslationMaps() {
+  // the importer converts text from several threads, so the maps are only ever loaded once
+  if(s_mapsLoaded.loadAcquire()) {
+    return;
+  }
+  static QMutex mutex;
+  QMutexLocker locker(&mutex);
+  if(s_mapsLoaded.loadRelaxed()) {
+    return;
+  }
   QString mapfile = DataFileRegistry::self()->locate(QStringLiteral("bibtex-translation.xml"));
   if(mapfile.isEmpty()) {
     static bool showMsg = true;
@@ -132,6 +144,9 @@ void BibtexHandler::loadTranslationMaps() {
     }
     return;
   }
+  // the map is filled before the flag is set, so other threads never read a partial map
+  StringListHash utf8LatexMap;
+  QString latexStartChars;
 
   QUrl u = QUrl::fromLocalFile(mapfile);
   // no namespace processing
@@ -145,22 +160,38 @@ void BibtexHandler::loadTranslationMaps() {
     // to represent a character in LaTex.
     QString s = keyList.item(i).toElement().attribute(QStringLiteral("char"));
     for(int j = 0; j < strList.count(); ++j) {
-      s_utf8LatexMap[s].append(strList.item(j).toElement().text());
+      const QString latex = strList.item(j).toElement().text();
+      utf8LatexMap[s].append(latex);
+      if(!latex.isEmpty() && !latexStartChars.contains(latex.at(0))) {
+        latexStartChars += latex.at(0);
+      }
 //      myDebug() << s << " = " << strList.item(j).toElement().text();
     }
   }
+  s_utf8LatexMap = utf8LatexMap;
+  s_latexStartChars = latexStartChars;
+  s_mapsLoaded.storeRelease(1);
 }
 
 QString BibtexHandler::importText(char* text_) {
   QString str = QString::fromUtf8(text_);
 
-  if(s_utf8LatexMap.isEmpty()) {
-    loadTranslationMaps();
-  }
+  loadTranslationMaps();
 
-  for(StringListHash::ConstIterator it = s_utf8LatexMap.constBegin(); it != s_utf8LatexMap.constEnd(); ++it) {
-    foreach(const QString& word, it.value()) {
-      str.replace(word, it.key());
+  // most values have no LaTeX at all, so only search for every string
+  // in the map when the text has a character that one of them starts with
+  bool hasLatex = false;
+  for(const QChar c : std::as_const(str)) {
+    if(s_latexStartChars.contains(c)) {
+      hasLatex = true;
+      break;
+    }
+  }
+  if(hasLatex) {
+    for(StringListHash::ConstIterator it = s_utf8LatexMap.constBegin(); it != s_utf8LatexMap.constEnd(); ++it) {
+      foreach(const QString& word, it.value()) {
+        str.replace(word, it.key());
+      }
     }
   }
 
@@ -170,15 +201,15 @@ QString BibtexHandler::importText(char* text_) {
   // NOT contained in braces
 
   static const QRegularExpression rx(QStringLiteral("\\{([A-Z]+?)\\}"));
-  str.replace(rx, QStringLiteral("\\1"));
+  if(str.contains(QLatin1Char('{'))) {
+    str.replace(rx, QStringLiteral("\\1"));
+  }
 
   return str;
 }
 
 QString BibtexHandler::exportText(const QString& text_, const QStringList& macros_) {
-  if(s_utf8LatexMap.isEmpty()) {
-    loadTranslationMaps();
-  }
+  loadTranslationMaps();
 
   QChar lquote, rquote;
   switch(s_quoteStyle) {
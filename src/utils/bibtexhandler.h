@@ -30,6 +30,7 @@
 #include <QStringList>
 #include <QHash>
 #include <QRegularExpression>
+#include <QAtomicInt>
 
 namespace Tellico {
 
@@ -41,6 +42,10 @@ public:
   enum QuoteStyle { BRACES=0, QUOTES=1 };
   static QStringList bibtexKeys(const Data::EntryList& entries);
   static QString bibtexKey(Data::EntryPtr entry);
+  /**
+   * Converts LaTeX text to UTF-8. Once the translation maps are loaded, the text
+   * can be converted from any thread.
+   */
   static QString importText(char* text);
   static QString exportText(const QString& text, const QStringList& macros);
   /**
@@ -50,6 +55,11 @@ public:
    * @return A reference to the text
    */
   static QString& cleanText(QString& text);
+  /**
+   * Loads the maps between UTF-8 and LaTeX, if they are not loaded already.
+   * It is safe to call from more than one thread.
+   */
+  static void loadTranslationMaps();
 
   static QuoteStyle s_quoteStyle;
 
@@ -57,10 +67,12 @@ private:
   typedef QHash<QString, QStringList> StringListHash;
 
   static QString bibtexKey(const QString& author, const QString& title, const QString& year);
-  static void loadTranslationMaps();
   static QString addBraces(const QString& string);
 
   static StringListHash s_utf8LatexMap;
+  // the first character of every LaTeX string in the map
+  static QString s_latexStartChars;
+  static QAtomicInt s_mapsLoaded;
   static const QRegularExpression s_badKeyChars;
 };
 